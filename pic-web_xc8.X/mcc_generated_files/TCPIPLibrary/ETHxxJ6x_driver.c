@@ -1,1271 +1,2344 @@
-/**
-  PIC18FxxJ60 Ethernet driver
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    j60_driver.c
-
-  Summary:
-    This is the Ethernet driver implementation for PIC18FxxJ60 family devices.
-
-  Description:
-    This file provides the Ethernet driver API implementation for 
-    the PIC18Fx7J60 family devices.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-#include <xc.h>
-#include <stdint.h>
-#include <stdio.h>
-#include <stdbool.h>
-#include "ethernet_driver.h"
-#include "mac_address.h"
-#include "../mcc.h"
-
-// Note this driver is half duplex because the HW cannot automatically negotiate full-duplex
-// If full duplex is desired, both ends of the link must be manually configured.
-// the "out of box" experience dictates half duplex mode.
-
-volatile ethernetDriver_t ethData;
-
-    // Packet write in progress, not ready for transmit
-#define ETH_WRITE_IN_PROGRESS       (0x0001 << 0)
-    // Packet complete, in queue for transmit
-#define ETH_TX_QUEUED               (0x0001 << 1)
-    // Flag for pool management - free or allocated
-#define ETH_ALLOCATED               (0x0001 << 2)
-
-// adjust these parameters for the MAC...
-#define RAMSIZE (8192)
-#define MAX_TX_PACKET_SIZE  (1518)
-#define MIN_TX_PACKET_SIZE  (64)
-#define MAX_TX_PACKETS (20)
-
-#define TX_STATUS_VECTOR_SIZE   (7)
-
-#define MIN_TX_PACKET           (MIN_TX_PACKET_SIZE + TX_STATUS_VECTOR_SIZE)
-#define TX_BUFFER_SIZE          ((MAX_TX_PACKET_SIZE + TX_STATUS_VECTOR_SIZE) << 1)
-
-// typical memory map for the MAC buffers
-#define TXSTART (RAMSIZE - TX_BUFFER_SIZE)
-#define TXEND	(RAMSIZE-1)
-#define RXSTART (0)
-#define RXEND	(TXSTART - 1)
-
-#define TX_BUFFER_MID           ((TXSTART) + ((TX_BUFFER_SIZE) >> 1) )
-
-#define SetBit( bitField, bitMask )     do{ bitField = bitField | bitMask; } while(0)
-#define ClearBit( bitField, bitMask )   do{ bitField = bitField & (~bitMask); } while(0)
-#define CheckBit( bitField, bitMask )   (bool)(bitField & bitMask)
-
-//#define ETH_packetReady() eth_data.pktReady
-//#define ETH_linkCheck() eth_data.up
-//#define ETH_linkChanged() eth_data.linkChange
-
-// Define a temporary register for passing data to inline assembly
-// This is to work around the 110110 LSB errata and to control RDPTR WRPTR update counts
-
-uint8_t ethListSize;
-
-static txPacket_t txData[MAX_TX_PACKETS];
-
-static txPacket_t  *pHead;
-static txPacket_t  *pTail;
-
-uint16_t errataTemp __at(0xE7E);   // jira:M8TS-608
-
-error_msg ETH_SendQueued(void);
-error_msg ETH_Shift_Tx_Packets(void);
-
-void ETH_PacketListReset(void);
-txPacket_t* ETH_NewPacket(void);
-void ETH_RemovePacket(txPacket_t* packetHandle);
-
-inline uint8_t ETH_EdataRead()
-{
-    asm("movff EDATA,_errataTemp");
-    return (uint8_t) errataTemp;
-}
-
-inline void ETH_EdataWrite(uint8_t d)
-{
-    asm("movff WREG,EDATA");
-}
-
-static uint16_t nextPacketPointer;
-static receiveStatusVector_t rxPacketStatusVector;
-
-// PHY Read and Write Helper functions
-typedef enum{ PHCON1 = 0, PHSTAT1=0x01, PHCON2=0x10, PHSTAT2=0x11, PHIE=0x12, PHIR=0x13, PHLCON=0x14} phyRegister_t;
-typedef enum{ READ_FAIL = -3, WRITE_FAIL = -2, BUSY_TIMEOUT = -1, NOERROR = 0} phyError_t;
-
-phyError_t PHY_Write(phyRegister_t reg, uint16_t data);
-int32_t PHY_Read(phyRegister_t reg);
-
-/**
- * Initialize Ethernet Controller
- */
-void ETH_Init(void)
-{
-    const mac48Address_t *mac;
-    uint16_t phycon1_value;
-    
-    // initialize the driver variables
-    ethData.error = false; // no error
-    ethData.up = false; // no link
-    ethData.linkChange = false;
-
-    ETH_PacketListReset();
-
-    ethData.saveRDPT = 0;
-    // Initialize RX tracking variables and other control state flags
-    nextPacketPointer = RXSTART;
-    
-    ECON1 = 0x00;//disable RXEN
-    while(ESTATbits.RXBUSY);
-    while(ECON1bits.TXRTS);
-    while (EIRbits.PKTIF) // Packet receive buffer has at least 1 unprocessed packet
-    {
-        ethData.pktReady = false;
-        ETH_Flush();
-    }
-    
-    ECON2 = 0x00; //disable the module    
-    
-    NOP();
-    NOP();
-    NOP();
-
-    // Enable Ethernet
-    ECON2 = 0xA0; // AUTOINC, ETHEN
-    
-    // wait for phy ready (can take 1ms)
-    while(!ESTATbits.PHYRDY);
-
-#ifdef J60_USE_HALF_DUPLEX
-    // Intialize the MAC for Half Duplex
-    MACON1  = 0x01;       NOP(); // Half duplex value (no flow control)
-    MACON3  = 0b10110010; NOP();
-    MACON4  = 0b01000000; NOP(); // Half Duplex - Wait forever for access to the wire
-    MABBIPG = 0x12;       NOP(); // correct gap for half duplex
-    MAIPG   = 0x0C12;     NOP(); // correct gap for half duplex
-    EFLOCON = 0x00;              // half duplex flow control off.
-    phycon1_value = 0x0000;   // PHY is half duplex
-#else
-    // initialize the MAC for Full Duplex
-    MACON1  = 0b00001101; NOP(); // Full duplex value (with flow control)
-    MACON3  = 0b10110011; NOP(); // Byte stuffing for short packets, Normal frames and headers.  Full duplex //jira: M8TS-690
-    MACON4  = 0b00000000; NOP(); // Full Duplex - Ignored
-    MABBIPG = 0x15;       NOP(); // correct gap for full duplex
-    MAIPG   = 0x0012;     NOP(); // correct gap for full duplex
-    phycon1_value = 0x0100;      // setup for full duplex in the phy
-
-#endif
-
-
-    // Set up TX/RX buffer addresses
-    ETXST = TXSTART; 
-    ETXND = TXEND; 
-    ERXST = RXSTART;
-    ERXND = RXEND;
-
-    // Setup EDATA Pointers
-    ERDPT = RXSTART;
-    EWRPT = TXSTART;
-
-    // Setup RXRDRDPT to a dummy value for the first packet
-    ERXRDPT = RXEND;
-    
-    MAMXFL  = MAX_TX_PACKET_SIZE;
-
-    // Setup MAC address to MADDR registers
-    mac = MAC_getAddress();
-
-    MAADR1  = mac->mac_array[0];NOP();
-    MAADR2  = mac->mac_array[1];NOP();
-    MAADR3  = mac->mac_array[2];NOP();
-    MAADR4  = mac->mac_array[3];NOP();
-    MAADR5  = mac->mac_array[4];NOP();
-    MAADR6  = mac->mac_array[5];NOP();
-
-    // Configure the receive filter
-//    ERXFCON = 0b10101001; //UCEN,OR,CRCEN,MPEN,BCEN (unicast,crc,magic packet,broadcast)
-    ERXFCON = 0b10101011; //UCEN,OR,CRCEN,MPEN,BCEN (unicast,crc,magic packet,multicast,broadcast)
-
-    // RXEN enabled
-    ECON1=0x04;  
-
-    // Configure Phy registers
-    PHY_Write(PHCON1, phycon1_value);   // PHY is full duplex
-    PHY_Write(PHCON2, 0x0110); // Do not transmit loopback
-    PHY_Write(PHLCON, 0b01110101001010); // LED control - LEDA = TX/RX, LEDB = Link, Stretched LED
-
-    // Check for a preexisting link
-    ETH_CheckLinkUp();//TODO: We check link here and then do NOTHING?
-
-    // configure ETHERNET IRQ's
-    EIE = 0b01011001;
-    PHY_Write(PHIE,0x0012);
-}
-
-bool ETH_CheckLinkUp()
-{
-    uint32_t value;
-    // check for a preexisting link
-    value = (uint32_t)PHY_Read(PHSTAT2);  //jira: CAE_MCU8-5647
-    if(value & 0x0400)
-    {
-        ethData.up = true;
-        return true;
-    }
-    else
-    {
-        ethData.up = false;
-        return false;
-    }
-}
-
-/**
- * Ethernet Event Handler
- */
-void ETH_EventHandler(void)
-{
-    // check for the IRQ Flag
-    PIR2bits.ETHIF = 0;
-
-   if (EIRbits.LINKIF) // something about the link changed.... update the link parameters
-    {
-        PHY_Read(PHIR); // clear the link irq
-
-        ethData.linkChange = true;
-        // recheck for the link state.
-        ETH_CheckLinkUp();//TODO: We check link here and then do NOTHING?
-    }
-
-    if(EIRbits.RXERIF) // buffer overflow
-    {
-        EIRbits.RXERIF = 0;
-    }
-
-    if (EIRbits.TXERIF)
-    {
-        EIRbits.TXERIF = 0;
-    }
-
-    if(EIRbits.TXIF) // finished sending a packet
-    {
-        EIRbits.TXIF = 0;
-        ETH_RemovePacket(pTail);
-        if( ethListSize > 0 )
-        {
-            if( EWRPT > TX_BUFFER_MID )
-            {
-                // Shift all the queued packets to the start of the TX Buffer
-                ETH_Shift_Tx_Packets();
-            }
-
-            // Send the next queued packet
-            ETH_SendQueued();
-        }
-    }
-
-    if (EIRbits.PKTIF) // Packet receive buffer has at least 1 unprocessed packet
-    { 
-        if(ethData.pktReady == false)
-        {
-            ethData.pktReady = true;
-            EIEbits.PKTIE = 0; // turn off the packet interrupt until this one is handled.
-        }
-    }
-}
-
-void ETH_NextPacketUpdate()
-{
-
-    ERDPT = nextPacketPointer;
-
-    // Extract the packet status data
-    // NOP's needed to meet Tcy timing spec for > 20 Mhz operation
-    ((char *) &nextPacketPointer)[0]    = ETH_EdataRead();
-    ((char *) &nextPacketPointer)[1]    = ETH_EdataRead();
-    ((char *) &rxPacketStatusVector)[0] = ETH_EdataRead();
-    ((char *) &rxPacketStatusVector)[1] = ETH_EdataRead();
-    ((char *) &rxPacketStatusVector)[2] = ETH_EdataRead();
-    ((char *) &rxPacketStatusVector)[3] = ETH_EdataRead();
-
-    // the checksum is 4 bytes.. so my payload is the byte count less 4.
-    rxPacketStatusVector.byteCount -= 4; // I don't care about the frame checksum at the end.    
-}
-
-void ETH_ResetReceiver(void)
-{
-    ECON1 = (unsigned char)RXRST;  //jira: CAE_MCU8-5647
-}
-
-void ETH_SendSystemReset(void)
-{
-     RESET(); 
-}
-
-/**
- * Waits for the PHY to be free
- * @return NOERROR if PHY is free else returns BUSY_TIMEOUT
- */
-inline phyError_t PHY_WaitForBusy(void)
-{
-    phyError_t ret = NOERROR;
-    uint8_t timeout;
-
-    for(timeout = 0; timeout < 10;timeout++) NOP();
-    timeout = 90;
-    while(MISTATbits.BUSY && --timeout) NOP(); // wait for the PHY to be free.
-
-    if(timeout == 0) ret = BUSY_TIMEOUT;
-    return ret;
-}
-
-/**
- * Write PHY registers
- * @param reg
- * @param data
- * @return NOERROR if PHY is free else BUSY_TIMEOUT if PHY is busy
- */
-phyError_t PHY_Write(phyRegister_t reg, uint16_t data)
-{
-    uint8_t GIESave;
-    // Write the register address
-    MIREGADR = reg;
-
-    // Write the data through the MIIM interface
-    // Order is important: write low byte first, high byte last
-    //
-    // Due to a silicon problem, you cannot access any register with LSb address
-    // bits of 0x16 between your write to MIWRL and MIWRH or else the value in
-    // MIWRL will be corrupted.  This inline assembly prevents this by copying
-    // the value to PRODH:PRODL first, which is at fixed locations of
-    // 0xFF4:0xFF3.  These addresses have LSb address bits of 0x14 and 0x13.
-    // Interrupts must be disabled to prevent arbitrary ISR code from accessing
-    // memory with LSb bits of 0x16 and corrupting the MIWRL value.
-    errataTemp = data;
-    GIESave = INTCON;
-    INTCON = 0;
-    MIWR = errataTemp;
-    INTCON = GIESave;				// Restore GIEH and GIEL value
-
-    // Wait until the PHY register has been written
-    // This operation requires 10.24us
-    return PHY_WaitForBusy();
-}
-
-/**
- * Read PHY registers
- * @param reg
- * @return
- */
-
-int32_t PHY_Read(phyRegister_t reg)
-{
-    int32_t ret = NOERROR;
-    if(PHY_WaitForBusy() == NOERROR)
-    {
-        MIREGADR = reg;
-        MICMD = 0;
-        MICMDbits.MIIRD = 1;
-        NOP(); NOP(); // specified 2 Tcy before Busy bit is set.
-        if(PHY_WaitForBusy() == BUSY_TIMEOUT)
-        {
-            ret = READ_FAIL;
-        }
-        else
-        {
-            MICMDbits.MIIRD = 0;
-            ret = MIRD;
-        }
-    }
-    else
-    {
-        ret = BUSY_TIMEOUT;
-    }
-    return ret;
-}
-
-/**
- * Read 1 byte of data from the RX buffer
- * @return
- */
-uint8_t ETH_Read8(void)
-{
-    uint8_t ret = 0;
-    if(rxPacketStatusVector.byteCount >= sizeof(ret))
-    {
-        ret = ETH_EdataRead();
-        rxPacketStatusVector.byteCount -= sizeof(ret);
-        ethData.error = 0;
-    }
-    else
-    {
-        ethData.error = 1;
-    }
-    return ret;
-}
-/**
- * Read 2 bytes of data from RX buffer
- * @return
- */
-uint16_t ETH_Read16(void)
-{
-    uint16_t ret = 0;
-    if(rxPacketStatusVector.byteCount >= sizeof(ret))
-    {
-        ((uint8_t *)&ret)[1] = ETH_EdataRead();
-        ((uint8_t *)&ret)[0] = ETH_EdataRead();
-        rxPacketStatusVector.byteCount -= sizeof(ret);
-        ethData.error = 0;
-    }
-    else
-    {
-        ethData.error = 1;
-    }
-    return ret;
-}
-
-/**
- * Read 3 bytes of data from RX buffer
- * @return
- */
-uint32_t ETH_Read24(void)
-{
-    uint32_t ret = 0;  // Resized from uint16_t MCCV3XX-6709
-    if(rxPacketStatusVector.byteCount >= sizeof(ret))
-    {
-        ((uint8_t *)&ret)[2] = ETH_EdataRead();
-        ((uint8_t *)&ret)[1] = ETH_EdataRead();
-        ((uint8_t *)&ret)[0] = ETH_EdataRead();
-        rxPacketStatusVector.byteCount -= sizeof(ret);
-        ethData.error = 0;
-    }
-    else
-    {
-        ethData.error = 1;
-    }
-    return ret;
-}
-
-/**
- * Read 4 bytes of data from the RX buffer
- * @return
- */
-uint32_t ETH_Read32(void)
-{
-    uint32_t ret = 0;
-    if(rxPacketStatusVector.byteCount >= sizeof(ret))
-    {
-        ((uint8_t *)&ret)[3] = ETH_EdataRead();
-        ((uint8_t *)&ret)[2] = ETH_EdataRead();
-        ((uint8_t *)&ret)[1] = ETH_EdataRead();
-        ((uint8_t *)&ret)[0] = ETH_EdataRead();
-        rxPacketStatusVector.byteCount -= sizeof(ret);
-        ethData.error = 0;
-    }
-    else
-    {
-        ethData.error = 1;
-    }
-    return ret;
-}
-
-/**
- * Read a block of data from RX buffer
- * @param buffer
- * @param length
- * @return
- */
-uint16_t ETH_ReadBlock(void *buffer, uint16_t length)
-{
-    uint16_t len = 0;
-    char *p = buffer;
-    while(rxPacketStatusVector.byteCount && length)
-    {
-        *p++ = ETH_EdataRead();
-        len ++;
-        length --;
-        rxPacketStatusVector.byteCount --;
-        ethData.error = 0;
-    }
-    return len;
-}
-
-/**
- * Writes 1 byte of data to the TX buffer
- * @param data
- */
-
-void ETH_Write8(uint8_t data)
-{
-    ETH_EdataWrite(data);
-}
-
-/**
- * Writes the 2 bytes of data to the TX buffer
- * @param data
- */
-void ETH_Write16(uint16_t data)
-{
-    ETH_EdataWrite(data >> 8);
-    ETH_EdataWrite(data);
-}
-
-/**
- * Writes the 3 bytes of data to the TX buffer
- * @param data
- */
-void ETH_Write24(uint32_t data)
-{
-    ETH_EdataWrite(data >> 16);
-    ETH_EdataWrite(data >>  8);
-    ETH_EdataWrite(data);
-}
-
-/**
- * Writes the 4 bytes of data to the TX buffer
- * @param data
- */
-void ETH_Write32(uint32_t data)
-{
-    ETH_EdataWrite(data >> 24);
-    ETH_EdataWrite(data >> 16);
-    ETH_EdataWrite(data >>  8);
-    ETH_EdataWrite(data);
-}
-
-uint16_t ETH_WriteString(const char *string)
-{
-    uint16_t length = 0;
-    while(*string && (EWRPT < TXEND))
-    {
-        ETH_EdataWrite(*string++);
-        length ++;
-    }
-    return length;
-}
-
-
-/**
- * Writes a block of data to the TX buffer
- * @param buffer
- * @param length
- * @return
- */
-uint16_t ETH_WriteBlock(const char *buffer, uint16_t length)   // jira:M8TS-608
-{
-    const char *p = buffer;
-    while(length-- && (EWRPT < TXEND))
-    {
-        ETH_EdataWrite(*p++);
-    }
-    return length;
-}
-
-/**
- * Returns the available space size in the Ethernet TX Buffer
- * @param 
- * @return available space left in the TX buffer
- */
-uint16_t ETH_GetFreeTxBufferSize(void)
-{
-    return (uint16_t)(TXEND - EWRPT);
-}
-
-/**
- * If the ethernet transmitter is idle, then start a packet.  Return is SUCCESS if the packet was started.
- * @param dest_mac
- * @param type
- * @return If the ethernet transmitter is idle, then start a packet.  Return is SUCCESS if the packet was started.
- */
-error_msg ETH_WriteStart(const mac48Address_t *dest_mac, uint16_t type)
-{
-    txPacket_t* ethPacket = NULL;
-
-    if(!ethData.up)
-    {
-        return LINK_NOT_FOUND;
-    }
-
-    // If the previous packet was not sent/queued, prevent a second packet creation
-    if( pHead != NULL )
-    {
-        if( pHead->flags & ETH_WRITE_IN_PROGRESS )
-        {
-            return BUFFER_BUSY;
-        }
-    }
-
-    if( EWRPT > TX_BUFFER_MID )
-    {
-        // Need to shift all the queued packets to the start of the TX Buffer
-
-        // Check for TX in progress
-        if(ECON1bits.TXRTS)
-        {
-            return TX_LOGIC_NOT_IDLE;
-        }
-
-        // Try to move the queued packets
-        ETH_Shift_Tx_Packets();
-        
-        // Verify if shift
-        if( EWRPT > TX_BUFFER_MID )
-        {
-            return BUFFER_BUSY;
-        }
-    }
-
-    // Create new packet and queue it in the TX Buffer
-    
-    // Initialize a new packet handler. It is automatically placed in the queue
-    ethPacket = (txPacket_t*)ETH_NewPacket();
-
-    if( ethPacket == NULL )
-    {
-        // No more available packets
-        return BUFFER_BUSY;
-    }
-
-    SetBit(ethPacket->flags, ETH_WRITE_IN_PROGRESS);    // writeInProgress = true;
-
-    EWRPT = ethPacket->packetStart; 
-
-    ETH_ResetByteCount();
-
-    ETH_EdataWrite(0x06); // first byte is the transmit command override
-    ETH_EdataWrite(dest_mac->mac_array[0]);
-    ETH_EdataWrite(dest_mac->mac_array[1]);
-    ETH_EdataWrite(dest_mac->mac_array[2]);
-    ETH_EdataWrite(dest_mac->mac_array[3]);
-    ETH_EdataWrite(dest_mac->mac_array[4]);
-    ETH_EdataWrite(dest_mac->mac_array[5]);
-    // write MY mac address into the ethernet packet
-    ETH_EdataWrite(MAADR1);
-    ETH_EdataWrite(MAADR2);
-    ETH_EdataWrite(MAADR3);
-    ETH_EdataWrite(MAADR4);
-    ETH_EdataWrite(MAADR5);
-    ETH_EdataWrite(MAADR6);
-    ETH_EdataWrite(((char *)&type)[1]);
-    ETH_EdataWrite(((char *)&type)[0]);
-
-    return SUCCESS;
-}
-
-void ETH_TxReset(void) //TODO Test and Fix
-{
-    ETH_ResetByteCount();
-    ETXST = TXSTART; 
-    EWRPT = TXSTART; 
-
-    ETH_PacketListReset();
-}
-
-/**
- * Start the Transmission or queue the packet that has been created
- * @return
- */
-error_msg ETH_Send(void)
-{
-    uint16_t packetEnd = EWRPT - 1;
-
-    if( !ethData.up )
-    {
-        return LINK_NOT_FOUND;
-    }
-
-    if( ethListSize == 0 )
-    {
-        return BUFFER_BUSY; // This is a false message.
-    }
-
-    ClearBit( pHead->flags, ETH_WRITE_IN_PROGRESS);     // writeInProgress = false
-    pHead->packetEnd = packetEnd;
-    SetBit( pHead->flags, ETH_TX_QUEUED);               // txQueued = true
-    // The packet is prepared to be sent / queued at this time
-
-    if( (ECON1bits.TXRTS) || (ethListSize > 1) )
-    {
-        return TX_QUEUED;
-    }
-
-    return ETH_SendQueued();
-}
-
-
-/**
- * Enqueue the latest written packet and start the transmission of a queued packet
- * @return
- */
-error_msg ETH_SendQueued(void)
-{
-    if( pHead->flags & ETH_TX_QUEUED )
-    {
-            // "Close" the latest written packet and enqueue it
-        ClearBit( pHead->flags, ETH_TX_QUEUED);         // txQueued = false
-
-            // Start transmitting from the tails - the packet first written
-        ETXST = pTail->packetStart;
-        ETXND = pTail->packetEnd;
-
-        NOP(); NOP();
-        ECON1bits.TXRTS = 1; // start sending
-
-        return SUCCESS;
-    }
-    else
-    {
-        return BUFFER_BUSY;
-    }
-}
-
-
-/**
- * Insert data in between of the TX Buffer
- * @param data
- * @param len
- * @param offset
- */
-void ETH_Insert(char *data, uint16_t len, uint16_t offset)  // jira:M8TS-608
-{
-    uint16_t current_tx_ptr = EWRPT;
-    EWRPT = pHead->packetStart + offset + 1; // we need +1 here because of SFD.
-    while(len--)
-    {
-        ETH_EdataWrite(*data++);
-    }
-    EWRPT = current_tx_ptr;
-}
-
-/**
- * Clears number of bytes (length) from the RX buffer
- * @param length
- */
-void ETH_Dump(uint16_t length)
-{
-    length = (rxPacketStatusVector.byteCount <= length) ? rxPacketStatusVector.byteCount : length;
-    if (length)
-    {
-        //Write new RX tail
-        ERDPT += length;
-        rxPacketStatusVector.byteCount -= length;
-    }
-}
-
-/**
- *  Clears all bytes from the RX buffer
- */
-void ETH_Flush(void)
-{
-    ethData.pktReady = false;
-    // Need to decrement the packet counter
-    ECON2 = ECON2 | 0x40u; // PKTDEC  //jira: CAE_MCU8-5647
-
-    // Set the RX Packet Limit to the beginning of the next unprocessed packet
-    // ERXRDPT = nextPacketPointer;
-    // RX Read pointer must be an odd address.
-    // The nextPacketPointer is ALWAYS even from the HW.
-    if (((nextPacketPointer - 1) < ERXST) ||
-        ((nextPacketPointer - 1) > ERXND))
-        ERXRDPT = ERXND;
-    else
-        ERXRDPT = nextPacketPointer - 1;
-
-    EIEbits.PKTIE = 1; // turn on the packet interrupt to get the next one.
-}
-
-//#define ETH_SIMPLE_COPY
-
-#ifdef ETH_SIMPLE_COPY
-// This is a dummy buffer copy but it will save us in case DMA doesn't work
-error_msg ETH_Copy(uint16_t len)
-{
-    uint16_t tmp_len;
-
-    ERDPT  = ethData.saveRDPT; // setup the source pointer from the current read pointer
-    tmp_len  = len;
-
-    while(tmp_len--)
-    {
-        asm("movff EDATA,_errataTemp");
-        asm("movff _errataTemp,EDATA");
-    }
-    return 1;
-}
-
-error_msg ETH_Shift_Tx_Packets(void)
-{
-    uint16_t tmp_len;
-    uint16_t len = ETH_GetByteCount();
-
-    EDMAST  = pTail->packetStart; // setup the source pointer from the current read pointer
-    EDMAND  = pHead->packetEnd;
-
-    tmp_len  = len;
-
-    while(tmp_len--)
-    {
-        asm("movff EDATA,_errataTemp");
-        asm("movff _errataTemp,EDATA");
-    }
-    return 1;
-}
-
-#else
-/**
- * Copy the data from RX Buffer to the TX Buffer using DMA setup
- * @param len
- * @return
- */
-error_msg ETH_Copy(uint16_t len)
-{
-    uint16_t timer;
-    uint16_t tmp_len;
-
-    timer = 2 * len;
-    while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
-    if(ECON1bits.DMAST==0)
-    {
-        EDMADST = EWRPT; // setup the destination start pointer
-        EDMAST  = ERDPT; // setup the source pointer from the current read pointer
-
-        tmp_len  = ERDPT + len; // J60 DMA uses an end pointer to mark the finish
-
-        if (tmp_len > (RXEND) )
-        {
-            tmp_len = tmp_len - (RXEND);
-            EDMAND = RXSTART + tmp_len;
-            // update the write pointer to the last location in TX buffer
-        }else
-        {
-            EDMAND = tmp_len;
-        }
-
-        ECON1bits.CSUMEN = 0; // copy mode
-        ECON1bits.DMAST  = 1; // start dma
-        /* sometimes it takes longer to complete if there is heavy network traffic */
-        timer = 40 * len;
-        while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
-        if(ECON1bits.DMAST == 0)
-        {
-            EWRPT += len;
-            return SUCCESS;
-        }
-    }
-    // if we are here. the DMA timed out.
-    RESET(); // reboot for now
-    return DMA_TIMEOUT;
-}
-
-/**
- * Copy all the queued packets to the TX Buffer start address using DMA setup
- * @param 
- * @return
- */
-error_msg ETH_Shift_Tx_Packets(void)
-{
-    uint16_t timer;
-    uint16_t len = pHead->packetEnd - pTail->packetStart;
-
-    timer = 2 * len;
-    while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
-    if(ECON1bits.DMAST==0)
-    {
-        EDMADST = TXSTART; // setup the destination start pointer
-
-        EDMAST  = pTail->packetStart; // setup the source pointer from the current read pointer
-        EDMAND  = pHead->packetEnd;
-
-        ECON1bits.CSUMEN = 0; // copy mode
-        ECON1bits.DMAST  = 1; // start dma
-        /* sometimes it takes longer to complete if there is heavy network traffic */
-        timer = 40 * len;
-        while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
-        if(ECON1bits.DMAST == 0)
-        {
-            // Update the start and end addresses of each packet
-            txPacket_t  *pElem = pHead;
-            uint16_t shiftOffset = pTail->packetStart;
-
-            while( pElem != NULL )
-            {
-                pElem->packetStart = pElem->packetStart - shiftOffset;
-                pElem->packetEnd = pElem->packetEnd - shiftOffset;
-                pElem = pElem->nextPacket;
-            }
-
-            // Update the EWRPT
-            EWRPT = TXSTART + len;
-            return SUCCESS;
-        }
-    }
-
-    // if we are here. the DMA timed out.
-    RESET(); // reboot for now
-    return DMA_TIMEOUT;
-}
-#endif
-
-static uint16_t ETH_ComputeChecksum(uint16_t len, uint16_t seed)
-{
-    uint32_t cksm;
-    uint16_t v;
-
-    cksm = seed;
-    
-    while(len > 1)
-    {
-        v = 0;
-        ((char *)&v)[1] = ETH_EdataRead();
-        ((char *)&v)[0] = ETH_EdataRead();
-        cksm += v;
-        len -= 2;
-    }
-
-    if(len)
-    {
-        v = 0;
-        ((char *)&v)[1] = ETH_EdataRead();
-        ((char *)&v)[0] = 0;
-        cksm += v;
-    }
-    
-    // wrap the checksum
-    while(cksm >> 16)
-    {
-        cksm = (cksm & 0x0FFFF) + (cksm>>16);
-    }
-
-    // invert the number.
-    cksm = ~cksm;
-
-    // Return the resulting checksum
-    return (uint16_t)cksm;
-}
-
-/**
- * Calculate the TX Checksum - Software Checksum
- * @param position
- * @param len
- * @param seed
- * @return
- */
-uint16_t ETH_TxComputeChecksum(uint16_t position, uint16_t len, uint16_t seed)
-{
-    uint16_t rxptr;
-    uint16_t cksm;
-
-    // Save the read pointer starting address
-    rxptr = ERDPT;
-
-    // position the read pointer for the checksum
-    ERDPT = pHead->packetStart + position + 1; // we need +1 here because of SFD.
-
-    cksm = ETH_ComputeChecksum( len, seed);
-    
-    // Restore old read pointer location
-    ERDPT = rxptr;
-
-    cksm = ((cksm & 0xFF00) >> 8) | ((cksm & 0x00FF) << 8);
-    // Return the resulting checksum
-    return cksm;
-}
-
-/**
- * Calculate RX checksum - Software checksum
- * @param len
- * @param seed
- * @return
- */
-uint16_t ETH_RxComputeChecksum(uint16_t len, uint16_t seed)
-{
-    uint16_t rxptr;
-    uint32_t cksm;
-
-    // Save the read pointer starting address
-    rxptr = ERDPT;
-
-    cksm = ETH_ComputeChecksum( len, seed);
-    
-    // Restore old read pointer location
-    ERDPT = rxptr;
-    
-    // Return the resulting checksum
-    cksm = ((cksm & 0xFF00) >> 8) | ((cksm & 0x00FF) << 8);
-    return (uint16_t)cksm;
-}
-
-/**
- * Get the MAC address
- * @param mac
- */
-void ETH_GetMAC(uint8_t *mac)
-{
-
-    *mac++ = MAADR1; 
-    *mac++ = MAADR2; 
-    *mac++ = MAADR3; 
-    *mac++ = MAADR4; 
-    *mac++ = MAADR5; 
-    *mac = MAADR6;  
-
-}
-
-/**
- * Set the MAC address
- * @param mac
- */
-
-void ETH_SetMAC(uint8_t *mac)
-{
-    MAADR1 = *mac++;
-    MAADR2 = *mac++;
-    MAADR3 = *mac++;
-    MAADR4 = *mac++;
-    MAADR5 = *mac++;
-    MAADR6 = *mac;
-}
-
-
-void ETH_SaveRDPT(void)
-{
-    ethData.saveRDPT = ERDPT;
-}
-
-uint16_t ETH_GetReadPtr(void)
-{
-    return(ERDPT);
-}
-
-void ETH_SetReadPtr(uint16_t rdptr)
-{
-    ERDPT = rdptr;
-}
-
-void ETH_MoveBackReadPtr(uint16_t offset)
-{
-    uint16_t rdptr;
-    
-    rdptr = ERDPT;
-    ERDPT = rdptr - offset;
-    ETH_SetRxByteCount(offset);
-  
-        
-}
-
-void ETH_ResetReadPtr()
-{
-    ERDPT = RXSTART;
-}
-
-uint16_t ETH_GetWritePtr()
-{
-    return (EWRPT);
-}
-
-uint16_t ETH_GetRxByteCount()
-{
-    return (rxPacketStatusVector.byteCount);
-}
-
-void ETH_SetRxByteCount(uint16_t count)
-{
-    rxPacketStatusVector.byteCount += count;
-}
-
-void ETH_ResetByteCount(void)
-{
-    ethData.saveWRPT = EWRPT;
-}
-
-uint16_t ETH_GetByteCount(void)
-{
-    return (EWRPT - ethData.saveWRPT);
-}
-
-void ETH_SaveWRPT(void)
-{
-    ethData.saveWRPT = EWRPT;
-}
-
-uint16_t ETH_ReadSavedWRPT(void)
-{
-    return ethData.saveWRPT;
-}
-
-uint16_t ETH_GetStatusVectorByteCount(void)
-{
-    return(rxPacketStatusVector.byteCount);
-}
-
-void ETH_SetStatusVectorByteCount(uint16_t bc)
-{
-    rxPacketStatusVector.byteCount=bc;
-}
-
-/**
- * Reset the Ethernet Packet List
- * @param 
- * @return
- */
-void ETH_PacketListReset(void)
-{
-    uint16_t index = 0;
-    uint8_t* ptr = (uint8_t*)txData;
-    ethListSize = 0;
-
-    pHead = NULL;
-    pTail = NULL;
-
-    while( index < (MAX_TX_PACKETS * sizeof(txPacket_t)) )
-    {
-        ptr[index] = 0;
-        index++;
-    }
-}
-
-/**
- * "Allocate" a new packet element and link it into the chained list
- * @param 
- * @return  packet address
- */
-txPacket_t* ETH_NewPacket(void)
-{
-    uint8_t index = 0;
-
-    if( ethListSize == MAX_TX_PACKETS )
-    {
-        return NULL;
-    }
-
-    while( index < MAX_TX_PACKETS )
-    {
-        if( CheckBit(txData[index].flags, ETH_ALLOCATED) == false )
-        {
-            txData[index].flags = 0;                        // reset all flags
-            SetBit(txData[index].flags, ETH_ALLOCATED);     // allocated = true - mark the handle as allocated
-
-            txData[index].packetEnd = TXEND;
-
-            txData[index].prevPacket = NULL;
-            txData[index].nextPacket = pHead;
-
-            if( pHead != NULL )
-            {
-                pHead->prevPacket = &txData[index];
-                txData[index].packetStart = pHead->packetEnd + TX_STATUS_VECTOR_SIZE;
-                    
-                // Try to keep a 2byte alignment
-                if( txData[index].packetStart & 0x0001 )
-                {
-                    // Make sure the end of the packet is odd, so the beginning of the next one is even
-                    ++ txData[index].packetStart;
-                }
-            }
-            else
-            {
-                txData[index].packetStart = TXSTART;
-                pTail = (txPacket_t*)&txData[index];
-            }
-
-            pHead = (txPacket_t*)&txData[index];
-
-            ethListSize ++;
-            return &txData[index];
-        }
-        index ++;
-    }
-
-    return NULL;
-}
-
-/**
- * Unlink a packet element from the chained list and "deallocate" it
- * @param   packetHandle
- * @return 
- */
-void ETH_RemovePacket(txPacket_t* pPacket)
-{
-#ifdef VALIDATE_ALLOCATED_PTR
-    uint8_t index = 0;
-#endif /* VALIDATE_ALLOCATED_PTR */
-
-    if( (pPacket == NULL) || (ethListSize == 0) )
-    {
-        return;
-    }
-
-#ifdef VALIDATE_ALLOCATED_PTR
-    while( index < MAX_TX_PACKETS )
-    {
-        if( (pPacket == &txData[index]) && (txData[index].allocated == true) )
-        {
-            break;
-        }
-        index ++;
-    }
-    if( index == MAX_TX_PACKETS )
-    {
-        return;
-    }
-#endif  /* VALIDATE_ALLOCATED_PTR */
-
-    // Unlink from the chained list
-    if( pPacket->nextPacket == NULL )
-    {
-        pTail = pPacket->prevPacket;
-        if( pTail != NULL )
-        {
-            pTail->nextPacket = NULL;
-        }
-    }
-
-    if( pPacket->prevPacket == NULL )
-    {
-        pHead = pPacket->nextPacket;
-        if( pHead != NULL )
-        {
-            pHead->prevPacket = NULL;
-        }
-    }
-
-    // Deallocate
-    pPacket->flags = 0;
-    pPacket->prevPacket = NULL;
-    pPacket->nextPacket = NULL;
-
-    ethListSize --;
-
-    return;
-}
-
-
+/**
+  PIC18FxxJ60 Ethernet driver
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    j60_driver.c
+
+  Summary:
+    This is the Ethernet driver implementation for PIC18FxxJ60 family devices.
+
+  Description:
+    This file provides the Ethernet driver API implementation for 
+    the PIC18Fx7J60 family devices.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "ethernet_driver.h"
+#include "mac_address.h"
+#include "sram_heap.h"
+#include "net_profile.h"
+#include "../mcc.h"
+
+// Note this driver is half duplex because the HW cannot automatically negotiate full-duplex
+// If full duplex is desired, both ends of the link must be manually configured.
+// the "out of box" experience dictates half duplex mode.
+
+volatile ethernetDriver_t ethData;
+
+    // Packet write in progress, not ready for transmit
+#define ETH_WRITE_IN_PROGRESS       (0x0001 << 0)
+    // Packet complete, in queue for transmit
+#define ETH_TX_QUEUED               (0x0001 << 1)
+    // Flag for pool management - free or allocated
+#define ETH_ALLOCATED               (0x0001 << 2)
+    // A DMA copy into the packet has not finished yet
+#define ETH_DMA_PENDING             (0x0001 << 3)
+    // The DMA copy failed, the packet is discarded instead of sent
+#define ETH_TX_DROPPED              (0x0001 << 4)
+    // Control packet (ETH_TX_CONTROL), sent before any queued bulk packet
+#define ETH_TX_PRIORITY             (0x0001 << 5)
+
+// adjust these parameters for the MAC...
+#define RAMSIZE (8192)
+#define MAX_TX_PACKET_SIZE  (1518)
+#define MIN_TX_PACKET_SIZE  (64)
+#define MAX_TX_PACKETS (20)
+
+#define TX_STATUS_VECTOR_SIZE   (7)
+
+// copy RX data to TX with the CPU instead of the DMA engine
+//#define ETH_SIMPLE_COPY
+
+#define MIN_TX_PACKET           (MIN_TX_PACKET_SIZE + TX_STATUS_VECTOR_SIZE)
+
+// room a frame may need in the TX buffer: control byte, frame without the
+// FCS the MAC appends, status vector
+#define TX_SLOT(length)         (1 + (MAX_TX_PACKET_SIZE - 4 - ETH_MTU) + (length) + TX_STATUS_VECTOR_SIZE)
+#define TX_PACKET_SLOT          TX_SLOT(ETH_MTU)
+
+// the TX buffer is a ring for two full size frames and behind it a control
+// area of small slots, so an ACK or ARP reply can be written while full
+// size frames fill the ring
+#define TX_RING_SIZE            ((MAX_TX_PACKET_SIZE + TX_STATUS_VECTOR_SIZE) << 1)
+#define TX_CONTROL_SLOT         ((TX_SLOT(ETH_TX_CONTROL_LENGTH) + 1u) & ~1u)
+#define TX_CONTROL_SLOTS        (2)
+#define TX_BUFFER_SIZE          (TX_RING_SIZE + TX_CONTROL_SLOTS * TX_CONTROL_SLOT)
+
+// typical memory map for the MAC buffers, the SRAM heap sits between the
+// RX buffer and the TX buffer
+#define TXSTART (RAMSIZE - TX_BUFFER_SIZE)
+#define TXRINGEND               (TXSTART + TX_RING_SIZE - 1)
+#define TXCONTROLSTART          (TXRINGEND + 1)
+#define TXEND	(RAMSIZE-1)
+#define RXSTART (0)
+#define RXEND	(TXSTART - SRAM_HEAP_SIZE - 1)
+#define RX_BUFFER_SIZE          (RXEND - RXSTART + 1)
+
+// full duplex flow control: once more than ETH_PAUSE_HIGH_WATER bytes of the
+// RX buffer are in use the MAC sends PAUSE frames until the stack has read it
+// down to ETH_PAUSE_LOW_WATER.  The high water mark leaves room for the frame
+// already on the wire and one more the link partner starts before the PAUSE
+// reaches it.
+//#define ETH_NO_FLOW_CONTROL
+#if defined(J60_USE_HALF_DUPLEX) && !defined(ETH_NO_FLOW_CONTROL)
+#define ETH_NO_FLOW_CONTROL     // PAUSE frames only exist on full duplex links
+#endif
+#define RX_PACKET_SLOT          (6 + MAX_TX_PACKET_SIZE)    // status vector and frame with FCS
+#define ETH_PAUSE_HIGH_WATER    (RX_BUFFER_SIZE - 2 * RX_PACKET_SLOT)
+#define ETH_PAUSE_LOW_WATER     (ETH_PAUSE_HIGH_WATER / 2)
+#define ETH_PAUSE_QUANTA        (0x1000)    // pause time in 512 bit times, repeated by the MAC while needed
+
+#if !defined(ETH_NO_FLOW_CONTROL) && (RX_BUFFER_SIZE <= 2 * RX_PACKET_SLOT)
+#error "RX buffer too small for flow control, shrink the SRAM heap or define ETH_NO_FLOW_CONTROL"
+#endif
+
+#define SetBit( bitField, bitMask )     do{ bitField = bitField | bitMask; } while(0)
+#define ClearBit( bitField, bitMask )   do{ bitField = bitField & (~bitMask); } while(0)
+#define CheckBit( bitField, bitMask )   (bool)(bitField & bitMask)
+
+//#define ETH_packetReady() eth_data.pktReady
+//#define ETH_linkCheck() eth_data.up
+//#define ETH_linkChanged() eth_data.linkChange
+
+// Define a temporary register for passing data to inline assembly
+// This is to work around the 110110 LSB errata and to control RDPTR WRPTR update counts
+
+uint8_t ethListSize;
+
+static txPacket_t txData[MAX_TX_PACKETS];
+
+static txPacket_t  *pHead;
+static txPacket_t  *pTail;
+static txPacket_t  *pTxPacket;      // being sent, removed when TXIF is handled
+static uint16_t txWriteEnd;         // last address the packet being written may use
+
+uint16_t errataTemp __at(0xE7E);   // jira:M8TS-608
+
+ethTxStats_t ethTxStats;
+
+#ifndef ETH_SIMPLE_COPY
+// DMA copies run in the background: ETH_Copy queues them, ETH_EventHandler
+// notices when they finish and sends the packet they were copying into
+#define ETH_DMA_JOBS            (2)
+#define ETH_DMA_TIMEOUT_TICKS   (1250u) // TMR1 ticks (8 Tcy) a copy may take, ~1 ms
+
+typedef struct
+{
+    uint16_t source;
+    uint16_t end;
+    uint16_t destination;
+    uint16_t length;
+    txPacket_t *packet;
+} dmaJob_t;
+
+static dmaJob_t dmaJobs[ETH_DMA_JOBS];
+static uint8_t dmaJobCount;         // dmaJobs[0] is running while non zero
+static tmr1Stamp_t dmaStarted;
+static bool rxReleasePending;       // ERXRDPT waits until the copies are done
+static uint16_t rxRelease;
+
+static void ETH_DmaDone(bool completed);
+static void ETH_DmaWait(void);
+#endif
+
+error_msg ETH_SendQueued(void);
+static ethTxClassStats_t *ETH_TxClassStats(txPacket_t *packet);
+static void ETH_RxScan(void);
+#ifndef ETH_NO_FLOW_CONTROL
+static volatile bool rxPaused;      // PAUSE frames are being sent, set by ETH_ISR and cleared by ETH_EventHandler
+static void ETH_FlowPause(void);
+static void ETH_FlowResume(void);
+
+// RX buffer bytes in use, ERXRDPT trails the next packet to read by one byte
+#define ETH_RX_USED(wrptr, rdptr)   (((wrptr) > (rdptr)) ? ((wrptr) - (rdptr) - 1u) : (RX_BUFFER_SIZE - ((rdptr) - (wrptr)) - 1u))
+#endif
+static bool ETH_TxPlace(uint16_t length, uint16_t *packetStart);
+
+void ETH_PacketListReset(void);
+txPacket_t* ETH_NewPacket(uint16_t length);
+void ETH_RemovePacket(txPacket_t* packetHandle);
+
+#if defined(__XC8)
+// ETH_ISR reads EDATA through its own temporary register, so it never
+// changes errataTemp under the main line.  Like errataTemp it works around
+// the 110110 LSB errata (see above); the ethIsrErrata psect is placed at
+// 0xE7D, next to errataTemp, by -Wl,-PethIsrErrata=0E7Dh in the linker
+// options of nbproject/configurations.xml.
+uint8_t errataIsrTemp __section("ethIsrErrata");
+
+inline uint8_t ETH_EdataRead()
+{
+    asm("movff EDATA,_errataTemp");
+    return (uint8_t) errataTemp;
+}
+
+inline uint8_t ETH_IsrEdataRead()
+{
+    asm("movff EDATA,_errataIsrTemp");
+    return errataIsrTemp;
+}
+
+inline void ETH_EdataWrite(uint8_t d)
+{
+    asm("movff WREG,EDATA");
+}
+#else
+// host build (sim/): EDATA is provided by the J60 model
+inline uint8_t ETH_EdataRead()
+{
+    errataTemp = J60_EdataRead();
+    return (uint8_t) errataTemp;
+}
+
+inline void ETH_EdataWrite(uint8_t d)
+{
+    J60_EdataWrite(d);
+}
+
+inline uint8_t ETH_IsrEdataRead()
+{
+    return J60_EdataRead();
+}
+#endif
+
+// Block copies to and from EDATA.  The caller has already clipped length to
+// the packet / buffer, so the loops only move data, eight bytes per pass.
+// Every access still goes through ETH_EdataRead / ETH_EdataWrite so the
+// errata workaround is kept.
+static void ETH_EdataReadBurst(uint8_t *p, uint16_t length)
+{
+    uint16_t passes = length >> 3;
+    uint8_t rest = length & 7;
+
+    while(passes--)
+    {
+        p[0] = ETH_EdataRead();
+        p[1] = ETH_EdataRead();
+        p[2] = ETH_EdataRead();
+        p[3] = ETH_EdataRead();
+        p[4] = ETH_EdataRead();
+        p[5] = ETH_EdataRead();
+        p[6] = ETH_EdataRead();
+        p[7] = ETH_EdataRead();
+        p += 8;
+    }
+    while(rest--)
+    {
+        *p++ = ETH_EdataRead();
+    }
+}
+
+static void ETH_EdataWriteBurst(const uint8_t *p, uint16_t length)
+{
+    uint16_t passes = length >> 3;
+    uint8_t rest = length & 7;
+
+    while(passes--)
+    {
+        ETH_EdataWrite(p[0]);
+        ETH_EdataWrite(p[1]);
+        ETH_EdataWrite(p[2]);
+        ETH_EdataWrite(p[3]);
+        ETH_EdataWrite(p[4]);
+        ETH_EdataWrite(p[5]);
+        ETH_EdataWrite(p[6]);
+        ETH_EdataWrite(p[7]);
+        p += 8;
+    }
+    while(rest--)
+    {
+        ETH_EdataWrite(*p++);
+    }
+}
+
+static uint16_t nextPacketPointer;
+static receiveStatusVector_t rxPacketStatusVector;
+
+// Packets the MAC has received, recorded by ETH_ISR as they arrive and taken
+// in order by ETH_NextPacketUpdate / ETH_Flush. The indexes run freely, the
+// number of packets waiting is rxRingHead - rxRingTail.
+#define ETH_RX_RING_SIZE        (8)     // power of 2
+
+static rxDescriptor_t rxRing[ETH_RX_RING_SIZE];
+static volatile uint8_t rxRingHead;     // written by ETH_ISR
+static volatile uint8_t rxRingTail;     // written by ETH_Flush
+static uint16_t rxScanPointer;          // first packet not in the ring yet
+
+ethRxStats_t ethRxStats;
+
+// running checksum of the bytes written with ETH_WriteX since ETH_TxChecksumStart()
+static uint32_t txChecksum;
+static bool txChecksumOdd;  // the next byte is the low byte of a 16 bit word
+
+// running checksum of the bytes read with ETH_ReadBlockChecksum since ETH_RxChecksumStart()
+static uint32_t rxChecksum;
+static bool rxChecksumOdd;
+
+static void ETH_TxChecksumAdd8(uint8_t data)
+{
+    if(txChecksumOdd)
+    {
+        txChecksum += data;
+    }
+    else
+    {
+        txChecksum += (uint16_t)data << 8;
+    }
+    txChecksumOdd = !txChecksumOdd;
+}
+
+static void ETH_TxChecksumAdd16(uint16_t data)
+{
+    if(txChecksumOdd)
+    {
+        // the word straddles two words of the checksum
+        data = (data >> 8) | (data << 8);
+    }
+    txChecksum += data;
+}
+
+// PHY Read and Write Helper functions
+typedef enum{ PHCON1 = 0, PHSTAT1=0x01, PHCON2=0x10, PHSTAT2=0x11, PHIE=0x12, PHIR=0x13, PHLCON=0x14} phyRegister_t;
+typedef enum{ READ_FAIL = -3, WRITE_FAIL = -2, BUSY_TIMEOUT = -1, NOERROR = 0} phyError_t;
+
+phyError_t PHY_Write(phyRegister_t reg, uint16_t data);
+int32_t PHY_Read(phyRegister_t reg);
+
+/**
+ * Initialize Ethernet Controller
+ */
+void ETH_Init(void)
+{
+    const mac48Address_t *mac;
+    uint16_t phycon1_value;
+    
+    // initialize the driver variables
+    ethData.error = false; // no error
+    ethData.up = false; // no link
+    ethData.linkChange = false;
+
+    ETH_PacketListReset();
+
+    ethData.saveRDPT = 0;
+    // Initialize RX tracking variables and other control state flags
+    nextPacketPointer = RXSTART;
+    rxScanPointer = RXSTART;
+    rxRingHead = 0;
+    rxRingTail = 0;
+    
+    ECON1 = 0x00;//disable RXEN
+    while(ESTATbits.RXBUSY);
+    while(ECON1bits.TXRTS);
+    while (EIRbits.PKTIF) // Packet receive buffer has at least 1 unprocessed packet
+    {
+        ETH_Flush();
+    }
+    
+    ECON2 = 0x00; //disable the module    
+    
+    NOP();
+    NOP();
+    NOP();
+
+    // Enable Ethernet
+    ECON2 = 0xA0; // AUTOINC, ETHEN
+    
+    // wait for phy ready (can take 1ms)
+    while(!ESTATbits.PHYRDY);
+
+#ifdef J60_USE_HALF_DUPLEX
+    // Intialize the MAC for Half Duplex
+    MACON1  = 0x01;       NOP(); // Half duplex value (no flow control)
+    MACON3  = 0b10110010; NOP();
+    MACON4  = 0b01000000; NOP(); // Half Duplex - Wait forever for access to the wire
+    MABBIPG = 0x12;       NOP(); // correct gap for half duplex
+    MAIPG   = 0x0C12;     NOP(); // correct gap for half duplex
+    EFLOCON = 0x00;              // half duplex flow control off.
+    phycon1_value = 0x0000;   // PHY is half duplex
+#else
+    // initialize the MAC for Full Duplex
+    MACON1  = 0b00001101; NOP(); // Full duplex value (with flow control)
+    MACON3  = 0b10110011; NOP(); // Byte stuffing for short packets, Normal frames and headers.  Full duplex //jira: M8TS-690
+    MACON4  = 0b00000000; NOP(); // Full Duplex - Ignored
+    MABBIPG = 0x15;       NOP(); // correct gap for full duplex
+    MAIPG   = 0x0012;     NOP(); // correct gap for full duplex
+    phycon1_value = 0x0100;      // setup for full duplex in the phy
+#ifdef ETH_NO_FLOW_CONTROL
+    EFLOCON = 0x00;
+#else
+    EPAUS   = ETH_PAUSE_QUANTA;
+    rxPaused = false;
+#endif
+
+#endif
+
+
+    // Set up TX/RX buffer addresses
+    ETXST = TXSTART; 
+    ETXND = TXEND; 
+    ERXST = RXSTART;
+    ERXND = RXEND;
+
+    // Setup EDATA Pointers
+    ERDPT = RXSTART;
+    EWRPT = TXSTART;
+    txWriteEnd = TXEND;
+
+    // Setup RXRDRDPT to a dummy value for the first packet
+    ERXRDPT = RXEND;
+    
+    MAMXFL  = MAX_TX_PACKET_SIZE;
+
+    // Setup MAC address to MADDR registers
+    mac = MAC_getAddress();
+
+    MAADR1  = mac->mac_array[0];NOP();
+    MAADR2  = mac->mac_array[1];NOP();
+    MAADR3  = mac->mac_array[2];NOP();
+    MAADR4  = mac->mac_array[3];NOP();
+    MAADR5  = mac->mac_array[4];NOP();
+    MAADR6  = mac->mac_array[5];NOP();
+
+    // Configure the receive filter
+//    ERXFCON = 0b10101001; //UCEN,OR,CRCEN,MPEN,BCEN (unicast,crc,magic packet,broadcast)
+    ERXFCON = 0b10101011; //UCEN,OR,CRCEN,MPEN,BCEN (unicast,crc,magic packet,multicast,broadcast)
+
+    // RXEN enabled
+    ECON1=0x04;  
+
+    // Configure Phy registers
+    PHY_Write(PHCON1, phycon1_value);   // PHY is full duplex
+    PHY_Write(PHCON2, 0x0110); // Do not transmit loopback
+    PHY_Write(PHLCON, 0b01110101001010); // LED control - LEDA = TX/RX, LEDB = Link, Stretched LED
+
+    // Check for a preexisting link
+    ETH_CheckLinkUp();//TODO: We check link here and then do NOTHING?
+
+    // configure ETHERNET IRQ's
+    // Only a received packet interrupts, ETH_EventHandler polls the other flags
+    EIE = 0b01000000;
+    PHY_Write(PHIE,0x0012);
+    PIE2bits.ETHIE = 1;
+}
+
+/**
+ * Choose the broadcast frames the receive filter lets through.  Unicast frames
+ * for this MAC are always taken, multicast frames never (the stack has no
+ * multicast users).  The ARP filters use the pattern match filter on the
+ * destination address, the type and with ETH_RX_ARP_FOR the ARP target
+ * address.
+ * @param filter
+ * @param ipAddress   ARP target address for ETH_RX_ARP_FOR
+ */
+void ETH_SetRxFilter(ethRxFilter_t filter, uint32_t ipAddress)
+{
+    uint32_t sum;
+
+    if(filter == ETH_RX_BROADCAST)
+    {
+        ERXFCON = 0b10101001; //UCEN,OR,CRCEN,MPEN,BCEN (unicast,crc,magic packet,broadcast)
+        return;
+    }
+
+    ERXFCON = 0b10101000; //UCEN,OR,CRCEN,MPEN while the pattern changes
+    EPMO = 0;
+    EPMM0 = 0x3F;         // bytes 0-5, destination address
+    EPMM1 = 0x30;         // bytes 12-13, type
+    EPMM2 = 0x00;
+    EPMM3 = 0x00;
+    sum = 3 * 0xFFFFul + ETHERTYPE_ARP;
+    if(filter == ETH_RX_ARP_FOR)
+    {
+        EPMM4 = 0xC0;     // bytes 38-41, ARP target protocol address
+        EPMM5 = 0x03;
+        sum += (ipAddress >> 16) + (ipAddress & 0xFFFF);
+    }
+    else
+    {
+        EPMM4 = 0x00;
+        EPMM5 = 0x00;
+    }
+    EPMM6 = 0x00;
+    EPMM7 = 0x00;
+    while(sum >> 16)
+    {
+        sum = (sum & 0x0FFFF) + (sum >> 16);
+    }
+    EPMCS = (uint16_t)~sum;
+    ERXFCON = 0b10111000; //UCEN,OR,CRCEN,PMEN,MPEN (unicast,crc,pattern match,magic packet)
+}
+
+bool ETH_CheckLinkUp()
+{
+    uint32_t value;
+    // check for a preexisting link
+    value = (uint32_t)PHY_Read(PHSTAT2);  //jira: CAE_MCU8-5647
+    if(value & 0x0400)
+    {
+        ethData.up = true;
+        return true;
+    }
+    else
+    {
+        ethData.up = false;
+        return false;
+    }
+}
+
+/**
+ * Ethernet Event Handler
+ */
+void ETH_EventHandler(void)
+{
+    uint8_t waiting;
+
+    // check for the IRQ Flag
+    PIR2bits.ETHIF = 0;
+
+   if (EIRbits.LINKIF) // something about the link changed.... update the link parameters
+    {
+        PHY_Read(PHIR); // clear the link irq
+
+        ethData.linkChange = true;
+        // recheck for the link state.
+        ETH_CheckLinkUp();//TODO: We check link here and then do NOTHING?
+    }
+
+    if(EIRbits.RXERIF) // buffer overflow
+    {
+        EIRbits.RXERIF = 0;
+        ethRxStats.overflows++;
+    }
+
+    if (EIRbits.TXERIF)
+    {
+        EIRbits.TXERIF = 0;
+    }
+
+    if(EIRbits.TXIF) // finished sending a packet
+    {
+        EIRbits.TXIF = 0;
+        ETH_RemovePacket(pTxPacket);
+        pTxPacket = NULL;
+        if( ethListSize > 0 )
+        {
+            // Send the next queued packet
+            ETH_SendQueued();
+        }
+    }
+
+#ifndef ETH_SIMPLE_COPY
+    if(dmaJobCount) // a copy is running
+    {
+        if(EIRbits.DMAIF)
+        {
+            EIRbits.DMAIF = 0;
+            ETH_DmaDone(true);
+        }
+        else if(TMR1_ElapsedSince(&dmaStarted) >= ETH_DMA_TIMEOUT_TICKS)
+        {
+            ETH_DmaDone(false);
+        }
+    }
+#endif
+
+    // the packets that came in while the packet interrupt was off are
+    // picked up by ETH_ISR once it is on again, the ring has to have room
+    waiting = rxRingHead - rxRingTail;
+    if (EIRbits.PKTIF && !EIEbits.PKTIE && (EPKTCNT > waiting) && (waiting < ETH_RX_RING_SIZE))
+    {
+        EIEbits.PKTIE = 1;
+    }
+#ifndef ETH_NO_FLOW_CONTROL
+    if(rxPaused)
+    {
+        // the stack reads the packets, ETH_ISR only starts the PAUSE frames
+        ETH_FlowResume();
+    }
+#endif
+}
+
+#ifndef ETH_NO_FLOW_CONTROL
+/**
+ * Start the PAUSE frames when the RX buffer space in use passes the high water
+ * Called from ETH_ISR only.
+ */
+static void ETH_FlowPause(void)
+{
+    uint16_t wrptr;
+    uint16_t rdptr;
+
+    wrptr = ERXWRPT;
+    rdptr = ERXRDPT;
+    if(!rxPaused && (ETH_RX_USED(wrptr, rdptr) > ETH_PAUSE_HIGH_WATER))
+    {
+        EFLOCONbits.FCEN = 0b10;    // send PAUSE frames periodically
+        rxPaused = true;
+        ethRxStats.pauses++;
+    }
+}
+
+/**
+ * Stop the PAUSE frames once the stack has read the RX buffer down to the low water
+ * Called from the main line only, while rxPaused is set ETH_ISR leaves
+ * EFLOCON alone.
+ */
+static void ETH_FlowResume(void)
+{
+    uint16_t wrptr;
+    uint16_t rdptr;
+
+    wrptr = ERXWRPT;
+    rdptr = ERXRDPT;
+    if(ETH_RX_USED(wrptr, rdptr) <= ETH_PAUSE_LOW_WATER)
+    {
+        EFLOCONbits.FCEN = 0b11;    // one PAUSE with a zero time, then off
+        rxPaused = false;
+    }
+}
+#endif
+
+/**
+ * Record the packets the MAC has received since the last scan in the RX ring
+ * Called from ETH_ISR only, the main line re-arms the packet interrupt
+ * instead of scanning, so only one copy of the scan exists.
+ */
+static void ETH_RxScan(void)
+{
+    rxDescriptor_t *desc;
+    uint16_t rdptr;
+    uint8_t waiting;
+
+    waiting = rxRingHead - rxRingTail;
+    if( (EPKTCNT > waiting) && (waiting < ETH_RX_RING_SIZE) )
+    {
+        // the main line may be in the middle of reading a packet
+        rdptr = ERDPT;
+        do
+        {
+            desc = &rxRing[rxRingHead & (ETH_RX_RING_SIZE - 1)];
+            desc->start = rxScanPointer;
+            ERDPT = rxScanPointer;
+            ((char *) &desc->next)[0]   = ETH_IsrEdataRead();
+            ((char *) &desc->next)[1]   = ETH_IsrEdataRead();
+            desc->status.v[0]           = ETH_IsrEdataRead();
+            desc->status.v[1]           = ETH_IsrEdataRead();
+            desc->status.v[2]           = ETH_IsrEdataRead();
+            desc->status.v[3]           = ETH_IsrEdataRead();
+            rxScanPointer = desc->next;
+            rxRingHead ++;
+            waiting ++;
+        } while( (EPKTCNT > waiting) && (waiting < ETH_RX_RING_SIZE) );
+        ERDPT = rdptr;
+
+        if(waiting > ethRxStats.waitingPeak)
+        {
+            ethRxStats.waitingPeak = waiting;
+        }
+    }
+    if(waiting == ETH_RX_RING_SIZE)
+    {
+        ethRxStats.ringFull ++;
+    }
+
+#ifndef ETH_NO_FLOW_CONTROL
+    ETH_FlowPause();
+#endif
+
+    // PKTIF stays set as long as any packet waits, so the interrupt stays off
+    // until ETH_Flush has taken one out of the ring
+    EIEbits.PKTIE = 0;
+}
+
+/**
+ * Ethernet interrupt: record new packets in the RX ring
+ */
+void ETH_ISR(void)
+{
+    ETH_RxScan();
+}
+
+/**
+ * Number of received packets waiting in the RX ring
+ * @return
+ */
+uint8_t ETH_RxPacketsWaiting(void)
+{
+    return rxRingHead - rxRingTail;
+}
+
+uint16_t ETH_NextPacketLength(void)
+{
+    if(rxRingHead == rxRingTail)
+    {
+        return 0;
+    }
+    // without the frame checksum, as ETH_NextPacketUpdate leaves it
+    return rxRing[rxRingTail & (ETH_RX_RING_SIZE - 1)].status.byteCount - 4;
+}
+
+void ETH_NextPacketUpdate()
+{
+    const rxDescriptor_t *desc = &rxRing[rxRingTail & (ETH_RX_RING_SIZE - 1)];
+    uint16_t rdptr;
+
+    // The packet status data was read by ETH_RxScan, start after it
+    nextPacketPointer = desc->next;
+    rxPacketStatusVector = desc->status;
+    rdptr = desc->start + 6;
+    if(rdptr > RXEND)
+    {
+        rdptr -= (RXEND - RXSTART + 1);
+    }
+    ERDPT = rdptr;
+
+    // the checksum is 4 bytes.. so my payload is the byte count less 4.
+    rxPacketStatusVector.byteCount -= 4; // I don't care about the frame checksum at the end.    
+}
+
+void ETH_ResetReceiver(void)
+{
+    ECON1 = (unsigned char)RXRST;  //jira: CAE_MCU8-5647
+}
+
+void ETH_SendSystemReset(void)
+{
+     RESET(); 
+}
+
+/**
+ * Waits for the PHY to be free
+ * @return NOERROR if PHY is free else returns BUSY_TIMEOUT
+ */
+inline phyError_t PHY_WaitForBusy(void)
+{
+    phyError_t ret = NOERROR;
+    uint8_t timeout;
+
+    for(timeout = 0; timeout < 10;timeout++) NOP();
+    timeout = 90;
+    while(MISTATbits.BUSY && --timeout) NOP(); // wait for the PHY to be free.
+
+    if(timeout == 0) ret = BUSY_TIMEOUT;
+    return ret;
+}
+
+/**
+ * Write PHY registers
+ * @param reg
+ * @param data
+ * @return NOERROR if PHY is free else BUSY_TIMEOUT if PHY is busy
+ */
+phyError_t PHY_Write(phyRegister_t reg, uint16_t data)
+{
+    uint8_t GIESave;
+    // Write the register address
+    MIREGADR = reg;
+
+    // Write the data through the MIIM interface
+    // Order is important: write low byte first, high byte last
+    //
+    // Due to a silicon problem, you cannot access any register with LSb address
+    // bits of 0x16 between your write to MIWRL and MIWRH or else the value in
+    // MIWRL will be corrupted.  This inline assembly prevents this by copying
+    // the value to PRODH:PRODL first, which is at fixed locations of
+    // 0xFF4:0xFF3.  These addresses have LSb address bits of 0x14 and 0x13.
+    // Interrupts must be disabled to prevent arbitrary ISR code from accessing
+    // memory with LSb bits of 0x16 and corrupting the MIWRL value.
+    errataTemp = data;
+    GIESave = INTCON;
+    INTCON = 0;
+    MIWR = errataTemp;
+    INTCON = GIESave;				// Restore GIEH and GIEL value
+
+    // Wait until the PHY register has been written
+    // This operation requires 10.24us
+    return PHY_WaitForBusy();
+}
+
+/**
+ * Read PHY registers
+ * @param reg
+ * @return
+ */
+
+int32_t PHY_Read(phyRegister_t reg)
+{
+    int32_t ret = NOERROR;
+    if(PHY_WaitForBusy() == NOERROR)
+    {
+        MIREGADR = reg;
+        MICMD = 0;
+        MICMDbits.MIIRD = 1;
+        NOP(); NOP(); // specified 2 Tcy before Busy bit is set.
+        if(PHY_WaitForBusy() == BUSY_TIMEOUT)
+        {
+            ret = READ_FAIL;
+        }
+        else
+        {
+            MICMDbits.MIIRD = 0;
+            ret = MIRD;
+        }
+    }
+    else
+    {
+        ret = BUSY_TIMEOUT;
+    }
+    return ret;
+}
+
+/**
+ * Read 1 byte of data from the RX buffer
+ * @return
+ */
+uint8_t ETH_Read8(void)
+{
+    uint8_t ret = 0;
+    if(rxPacketStatusVector.byteCount >= sizeof(ret))
+    {
+        ret = ETH_EdataRead();
+        rxPacketStatusVector.byteCount -= sizeof(ret);
+        ethData.error = 0;
+    }
+    else
+    {
+        ethData.error = 1;
+    }
+    return ret;
+}
+/**
+ * Read 2 bytes of data from RX buffer
+ * @return
+ */
+uint16_t ETH_Read16(void)
+{
+    uint16_t ret = 0;
+    if(rxPacketStatusVector.byteCount >= sizeof(ret))
+    {
+        ((uint8_t *)&ret)[1] = ETH_EdataRead();
+        ((uint8_t *)&ret)[0] = ETH_EdataRead();
+        rxPacketStatusVector.byteCount -= sizeof(ret);
+        ethData.error = 0;
+    }
+    else
+    {
+        ethData.error = 1;
+    }
+    return ret;
+}
+
+/**
+ * Read 3 bytes of data from RX buffer
+ * @return
+ */
+uint32_t ETH_Read24(void)
+{
+    uint32_t ret = 0;  // Resized from uint16_t MCCV3XX-6709
+    if(rxPacketStatusVector.byteCount >= sizeof(ret))
+    {
+        ((uint8_t *)&ret)[2] = ETH_EdataRead();
+        ((uint8_t *)&ret)[1] = ETH_EdataRead();
+        ((uint8_t *)&ret)[0] = ETH_EdataRead();
+        rxPacketStatusVector.byteCount -= sizeof(ret);
+        ethData.error = 0;
+    }
+    else
+    {
+        ethData.error = 1;
+    }
+    return ret;
+}
+
+/**
+ * Read 4 bytes of data from the RX buffer
+ * @return
+ */
+uint32_t ETH_Read32(void)
+{
+    uint32_t ret = 0;
+    if(rxPacketStatusVector.byteCount >= sizeof(ret))
+    {
+        ((uint8_t *)&ret)[3] = ETH_EdataRead();
+        ((uint8_t *)&ret)[2] = ETH_EdataRead();
+        ((uint8_t *)&ret)[1] = ETH_EdataRead();
+        ((uint8_t *)&ret)[0] = ETH_EdataRead();
+        rxPacketStatusVector.byteCount -= sizeof(ret);
+        ethData.error = 0;
+    }
+    else
+    {
+        ethData.error = 1;
+    }
+    return ret;
+}
+
+/**
+ * Read a block of data from RX buffer
+ * @param buffer
+ * @param length
+ * @return
+ */
+uint16_t ETH_ReadBlock(void *buffer, uint16_t length)
+{
+    if(length > rxPacketStatusVector.byteCount)
+    {
+        length = rxPacketStatusVector.byteCount;
+    }
+    if(length)
+    {
+        rxPacketStatusVector.byteCount -= length;
+        ethData.error = 0;
+        ETH_EdataReadBurst(buffer, length);
+    }
+    return length;
+}
+
+/**
+ * Start a running checksum of received data
+ * @param seed
+ *      Pseudo header sum
+ */
+void ETH_RxChecksumStart(uint16_t seed)
+{
+    rxChecksum = seed;
+    rxChecksumOdd = false;
+}
+
+/**
+ * Read a block of data from RX buffer and add it to the running checksum
+ * @param buffer
+ * @param length
+ * @return
+ */
+uint16_t ETH_ReadBlockChecksum(void *buffer, uint16_t length)
+{
+    uint8_t *p = buffer;
+    uint16_t words;
+    uint8_t hi, lo;
+
+    if(length > rxPacketStatusVector.byteCount)
+    {
+        length = rxPacketStatusVector.byteCount;
+    }
+    if(length == 0)
+    {
+        return 0;
+    }
+    rxPacketStatusVector.byteCount -= length;
+    ethData.error = 0;
+
+    words = length;
+    if(rxChecksumOdd)
+    {
+        // finish the word left open by the previous block
+        lo = ETH_EdataRead();
+        *p++ = lo;
+        rxChecksum += lo;
+        words --;
+    }
+    rxChecksumOdd = (words & 1) != 0;
+    words >>= 1;
+    while(words--)
+    {
+        hi = ETH_EdataRead();
+        lo = ETH_EdataRead();
+        p[0] = hi;
+        p[1] = lo;
+        p += 2;
+        rxChecksum += ((uint16_t)hi << 8) | lo;
+    }
+    if(rxChecksumOdd)
+    {
+        hi = ETH_EdataRead();
+        *p = hi;
+        rxChecksum += (uint16_t)hi << 8;
+    }
+    return length;
+}
+
+/**
+ * Add the next len bytes to the running checksum without reading them
+ * The read pointer does not move, the bytes can still be read or dumped.
+ * @param len
+ */
+void ETH_RxChecksumAhead(uint16_t len)
+{
+    uint16_t cksm;
+
+    if(len)
+    {
+        // ETH_RxComputeChecksum returns the inverted sum byte swapped
+        cksm = ~ETH_RxComputeChecksum(len, 0);
+        if(!rxChecksumOdd)
+        {
+            cksm = (cksm >> 8) | (cksm << 8);
+        }
+        rxChecksum += cksm;
+        if(len & 1)
+        {
+            rxChecksumOdd = !rxChecksumOdd;
+        }
+    }
+}
+
+/**
+ * Finish the running checksum of received data
+ * @return
+ *      0 if the data (and seed) check out
+ */
+uint16_t ETH_RxChecksumGet(void)
+{
+    uint32_t cksm = rxChecksum;
+
+    // wrap the checksum
+    while(cksm >> 16)
+    {
+        cksm = (cksm & 0x0FFFF) + (cksm>>16);
+    }
+    return (uint16_t)~cksm;
+}
+
+/**
+ * Writes 1 byte of data to the TX buffer
+ * @param data
+ */
+
+void ETH_Write8(uint8_t data)
+{
+    ETH_EdataWrite(data);
+    ETH_TxChecksumAdd8(data);
+}
+
+/**
+ * Writes the 2 bytes of data to the TX buffer
+ * @param data
+ */
+void ETH_Write16(uint16_t data)
+{
+    ETH_EdataWrite(data >> 8);
+    ETH_EdataWrite(data);
+    ETH_TxChecksumAdd16(data);
+}
+
+/**
+ * Writes the 3 bytes of data to the TX buffer
+ * @param data
+ */
+void ETH_Write24(uint32_t data)
+{
+    ETH_EdataWrite(data >> 16);
+    ETH_EdataWrite(data >>  8);
+    ETH_EdataWrite(data);
+    ETH_TxChecksumAdd8(data >> 16);
+    ETH_TxChecksumAdd16(data);
+}
+
+/**
+ * Writes the 4 bytes of data to the TX buffer
+ * @param data
+ */
+void ETH_Write32(uint32_t data)
+{
+    ETH_EdataWrite(data >> 24);
+    ETH_EdataWrite(data >> 16);
+    ETH_EdataWrite(data >>  8);
+    ETH_EdataWrite(data);
+    ETH_TxChecksumAdd16(data >> 16);
+    ETH_TxChecksumAdd16(data);
+}
+
+uint16_t ETH_WriteString(const char *string)
+{
+    uint16_t length = 0;
+    while(*string && (EWRPT <= txWriteEnd))
+    {
+        ETH_EdataWrite(*string);
+        ETH_TxChecksumAdd8(*string++);
+        length ++;
+    }
+    return length;
+}
+
+
+/**
+ * Writes a block of data to the TX buffer
+ * @param buffer
+ * @param length
+ * @return
+ */
+uint16_t ETH_WriteBlock(const char *buffer, uint16_t length)   // jira:M8TS-608
+{
+    const uint8_t *p = (const uint8_t *)buffer;
+    uint16_t room = EWRPT;
+    uint16_t words;
+
+    // the room check is done once for the block instead of once per byte
+    room = (room <= txWriteEnd) ? (txWriteEnd + 1 - room) : 0;
+    if(length > room)
+    {
+        length = room;
+    }
+    if(length == 0)
+    {
+        return 0;
+    }
+    ETH_EdataWriteBurst(p, length);
+
+    // sum the block out of RAM, a word at a time
+    words = length;
+    if(txChecksumOdd)
+    {
+        ETH_TxChecksumAdd8(*p++);
+        words --;
+    }
+    for(; words > 1; words -= 2)
+    {
+        txChecksum += ((uint16_t)p[0] << 8) | p[1];
+        p += 2;
+    }
+    if(words)
+    {
+        ETH_TxChecksumAdd8(*p);
+    }
+    return length;
+}
+
+/**
+ * Start a running checksum at the current write pointer
+ * Everything written with ETH_WriteX from here on is summed as it goes into
+ * the TX buffer. ETH_Insert and ETH_Copy are not part of the sum.
+ */
+void ETH_TxChecksumStart(void)
+{
+    txChecksum = 0;
+    txChecksumOdd = false;
+}
+
+/**
+ * Finish the running checksum
+ * @param seed
+ *      Sum of the words that are not in the buffer (pseudo header, fields inserted later)
+ * @return
+ *      checksum in network order, ready for ETH_Insert
+ */
+uint16_t ETH_TxChecksumGet(uint16_t seed)
+{
+    uint32_t cksm;
+
+    cksm = txChecksum + seed;
+
+    // wrap the checksum
+    while(cksm >> 16)
+    {
+        cksm = (cksm & 0x0FFFF) + (cksm>>16);
+    }
+
+    // invert the number.
+    cksm = ~cksm;
+
+    cksm = ((cksm & 0xFF00) >> 8) | ((cksm & 0x00FF) << 8);
+    return (uint16_t)cksm;
+}
+
+/**
+ * Returns the available space size in the Ethernet TX Buffer
+ * @param 
+ * @return available space left in the TX buffer
+ */
+uint16_t ETH_GetFreeTxBufferSize(void)
+{
+    uint16_t wrptr = EWRPT;
+
+    // the packet being written stops where ETH_WriteStart placed its end
+    if( (pHead == NULL) || !(pHead->flags & ETH_WRITE_IN_PROGRESS) || (wrptr > txWriteEnd) )
+    {
+        return 0;
+    }
+    return (uint16_t)(txWriteEnd + 1 - wrptr);
+}
+
+bool ETH_TxReady(uint16_t length)
+{
+    uint16_t packetStart;
+
+    if( (pHead != NULL) && (pHead->flags & ETH_WRITE_IN_PROGRESS) )
+    {
+        return false;
+    }
+    return (ethListSize < MAX_TX_PACKETS) && ETH_TxPlace(length, &packetStart);
+}
+
+/**
+ * If the ethernet transmitter is idle, then start a packet.  Return is SUCCESS if the packet was started.
+ * Only length bytes after the Ethernet header are room for the packet, a
+ * short one fits where a full size frame would not.
+ * @param dest_mac
+ * @param type
+ * @param length
+ * @return If the ethernet transmitter is idle, then start a packet.  Return is SUCCESS if the packet was started.
+ */
+error_msg ETH_WriteStart(const mac48Address_t *dest_mac, uint16_t type, uint16_t length)
+{
+    txPacket_t* ethPacket = NULL;
+
+    if(!ethData.up)
+    {
+        return LINK_NOT_FOUND;
+    }
+
+    // If the previous packet was not sent/queued, prevent a second packet creation
+    if( pHead != NULL )
+    {
+        if( pHead->flags & ETH_WRITE_IN_PROGRESS )
+        {
+            return BUFFER_BUSY;
+        }
+    }
+
+    // Create new packet and queue it in the TX Buffer
+    
+    // Initialize a new packet handler. It is automatically placed in the queue
+    if( length > ETH_MTU )
+    {
+        length = ETH_MTU;
+    }
+    ethPacket = (txPacket_t*)ETH_NewPacket(length);
+
+    if( ethPacket == NULL )
+    {
+        // No more available packets or no room in the TX Buffer
+        return BUFFER_BUSY;
+    }
+
+    SetBit(ethPacket->flags, ETH_WRITE_IN_PROGRESS);    // writeInProgress = true;
+    txWriteEnd = ethPacket->packetEnd;
+
+    EWRPT = ethPacket->packetStart; 
+
+    ETH_ResetByteCount();
+
+    ETH_EdataWrite(0x06); // first byte is the transmit command override
+    ETH_EdataWrite(dest_mac->mac_array[0]);
+    ETH_EdataWrite(dest_mac->mac_array[1]);
+    ETH_EdataWrite(dest_mac->mac_array[2]);
+    ETH_EdataWrite(dest_mac->mac_array[3]);
+    ETH_EdataWrite(dest_mac->mac_array[4]);
+    ETH_EdataWrite(dest_mac->mac_array[5]);
+    // write MY mac address into the ethernet packet
+    ETH_EdataWrite(MAADR1);
+    ETH_EdataWrite(MAADR2);
+    ETH_EdataWrite(MAADR3);
+    ETH_EdataWrite(MAADR4);
+    ETH_EdataWrite(MAADR5);
+    ETH_EdataWrite(MAADR6);
+    ETH_EdataWrite(((char *)&type)[1]);
+    ETH_EdataWrite(((char *)&type)[0]);
+
+    return SUCCESS;
+}
+
+void ETH_TxReset(void) //TODO Test and Fix
+{
+    ETH_ResetByteCount();
+    ETXST = TXSTART; 
+    EWRPT = TXSTART; 
+    txWriteEnd = TXEND;
+
+    ETH_PacketListReset();
+}
+
+/**
+ * Start the Transmission or queue the packet that has been created
+ * @return
+ */
+error_msg ETH_Send(void)
+{
+    uint16_t packetEnd = EWRPT - 1;
+    txPacket_t *packet;
+    ethTxClassStats_t *classStats;
+    error_msg ret;
+
+    if( !ethData.up )
+    {
+        return LINK_NOT_FOUND;
+    }
+
+    if( ethListSize == 0 )
+    {
+        return BUFFER_BUSY; // This is a false message.
+    }
+
+    packet = pHead;
+    ClearBit( packet->flags, ETH_WRITE_IN_PROGRESS);    // writeInProgress = false
+    packet->packetEnd = packetEnd;
+    SetBit( packet->flags, ETH_TX_QUEUED);              // txQueued = true
+    TMR1_ReadStamp(&packet->queuedAt);
+    // The packet is prepared to be sent / queued at this time
+
+    classStats = ETH_TxClassStats(packet);
+    classStats->queued ++;
+    if( classStats->queued > classStats->queuedPeak )
+    {
+        classStats->queuedPeak = classStats->queued;
+    }
+
+    if( pTxPacket != NULL )
+    {
+        return TX_QUEUED;
+    }
+
+    // an older packet may be waiting for its copy, or go first
+    ret = ETH_SendQueued();
+    if( (ret == SUCCESS) && (pTxPacket != packet) )
+    {
+        ret = TX_QUEUED;
+    }
+    return ret;
+}
+
+/**
+ * Set the transmit class of the packet being written
+ * ETH_WriteStart starts every packet as ETH_TX_BULK.
+ * @param txClass
+ */
+void ETH_SetTxClass(ethTxClass_t txClass)
+{
+    if( (pHead == NULL) || !(pHead->flags & ETH_WRITE_IN_PROGRESS) )
+    {
+        return;
+    }
+    if( txClass == ETH_TX_CONTROL )
+    {
+        SetBit( pHead->flags, ETH_TX_PRIORITY);
+    }
+    else
+    {
+        ClearBit( pHead->flags, ETH_TX_PRIORITY);
+    }
+}
+
+static ethTxClassStats_t *ETH_TxClassStats(txPacket_t *packet)
+{
+    return &ethTxStats.classes[(packet->flags & ETH_TX_PRIORITY) ? ETH_TX_CONTROL : ETH_TX_BULK];
+}
+
+
+/**
+ * Enqueue the latest written packet and start the transmission of a queued packet
+ * @return
+ */
+error_msg ETH_SendQueued(void)
+{
+    txPacket_t *packet;
+    txPacket_t *newer;
+    txPacket_t *next = NULL;
+    ethTxClassStats_t *classStats;
+    uint16_t latency;
+
+    if( pTxPacket != NULL )
+    {
+        // TXIF has not retired the packet on the wire yet
+        return TX_QUEUED;
+    }
+
+    // The oldest queued control packet goes first, else the oldest queued
+    // packet. Packets whose copy failed are closed but never sent.
+    packet = pTail;
+    while( packet != NULL )
+    {
+        newer = packet->prevPacket;
+        if( packet->flags & ETH_TX_QUEUED )
+        {
+            if( packet->flags & ETH_TX_DROPPED )
+            {
+                ETH_TxClassStats(packet)->queued --;
+                ETH_RemovePacket(packet);
+            }
+            else if( packet->flags & ETH_TX_PRIORITY )
+            {
+                if( next != NULL )
+                {
+                    ethTxStats.overtaken ++;
+                }
+                next = packet;
+                break;
+            }
+            else if( next == NULL )
+            {
+                next = packet;
+            }
+        }
+        packet = newer;
+    }
+    if( next == NULL )
+    {
+        return BUFFER_BUSY;
+    }
+
+    if( next->flags & ETH_DMA_PENDING )
+    {
+        // sent from ETH_EventHandler when the copy is done
+        return TX_QUEUED;
+    }
+
+    ClearBit( next->flags, ETH_TX_QUEUED);              // txQueued = false
+    classStats = ETH_TxClassStats(next);
+    classStats->queued --;
+    classStats->sent ++;
+    latency = TMR1_ElapsedSince(&next->queuedAt);
+    classStats->latencyTicks += latency;
+    if( latency > classStats->latencyPeak )
+    {
+        classStats->latencyPeak = latency;
+    }
+    pTxPacket = next;
+
+    ETXST = next->packetStart;
+    ETXND = next->packetEnd;
+
+    NOP(); NOP();
+    ECON1bits.TXRTS = 1; // start sending
+
+    return SUCCESS;
+}
+
+
+/**
+ * Insert data in between of the TX Buffer
+ * @param data
+ * @param len
+ * @param offset
+ */
+void ETH_Insert(char *data, uint16_t len, uint16_t offset)  // jira:M8TS-608
+{
+    uint16_t current_tx_ptr = EWRPT;
+    EWRPT = pHead->packetStart + offset + 1; // we need +1 here because of SFD.
+    while(len--)
+    {
+        ETH_EdataWrite(*data++);
+    }
+    EWRPT = current_tx_ptr;
+}
+
+/**
+ * Clears number of bytes (length) from the RX buffer
+ * @param length
+ */
+void ETH_Dump(uint16_t length)
+{
+    uint16_t rdptr;
+
+    length = (rxPacketStatusVector.byteCount <= length) ? rxPacketStatusVector.byteCount : length;
+    if (length)
+    {
+        // wrap at the end of the RX buffer like EDATA reads do
+        rdptr = ERDPT + length;
+        if (rdptr > RXEND)
+        {
+            rdptr -= (RXEND - RXSTART + 1);
+        }
+        ERDPT = rdptr;
+        rxPacketStatusVector.byteCount -= length;
+    }
+}
+
+/**
+ *  Clears all bytes from the RX buffer
+ */
+void ETH_Flush(void)
+{
+    uint16_t rxptr;
+
+    // Need to decrement the packet counter
+    // before the packet leaves the ring, so ETH_ISR never counts it twice
+    ECON2 = ECON2 | 0x40u; // PKTDEC  //jira: CAE_MCU8-5647
+    if(rxRingHead != rxRingTail)
+    {
+        rxRingTail ++;
+    }
+
+    // Set the RX Packet Limit to the beginning of the next unprocessed packet
+    // ERXRDPT = nextPacketPointer;
+    // RX Read pointer must be an odd address.
+    // The nextPacketPointer is ALWAYS even from the HW.
+    if (((nextPacketPointer - 1) < ERXST) ||
+        ((nextPacketPointer - 1) > ERXND))
+        rxptr = ERXND;
+    else
+        rxptr = nextPacketPointer - 1;
+
+#ifndef ETH_SIMPLE_COPY
+    if(dmaJobCount)
+    {
+        // a copy may still be reading this packet, free it when the copies are done
+        rxRelease = rxptr;
+        rxReleasePending = true;
+    }
+    else
+#endif
+    {
+        ERXRDPT = rxptr;
+    }
+
+    EIEbits.PKTIE = 1; // turn on the packet interrupt to get the next one.
+}
+
+#ifdef ETH_SIMPLE_COPY
+// This is a dummy buffer copy but it will save us in case DMA doesn't work
+error_msg ETH_Copy(uint16_t len)
+{
+    uint16_t tmp_len;
+
+    ERDPT  = ethData.saveRDPT; // setup the source pointer from the current read pointer
+    tmp_len  = len;
+
+    while(tmp_len--)
+    {
+        asm("movff EDATA,_errataTemp");
+        asm("movff _errataTemp,EDATA");
+    }
+    return 1;
+}
+
+error_msg ETH_CopyFrom(uint16_t source, uint16_t len)
+{
+    uint16_t rdptr = ERDPT;
+
+    ERDPT = source;
+    while(len--)
+    {
+        asm("movff EDATA,_errataTemp");
+        asm("movff _errataTemp,EDATA");
+    }
+    ERDPT = rdptr;
+    return SUCCESS;
+}
+
+error_msg ETH_SramCopy(uint16_t destination, uint16_t source, uint16_t len)
+{
+    uint16_t rdptr = ERDPT;
+    uint16_t wrptr = EWRPT;
+
+    ERDPT = source;
+    EWRPT = destination;
+    while(len--)
+    {
+        asm("movff EDATA,_errataTemp");
+        asm("movff _errataTemp,EDATA");
+    }
+    ERDPT = rdptr;
+    EWRPT = wrptr;
+    return SUCCESS;
+}
+
+#else
+static void ETH_DmaStart(void)
+{
+    EDMAST  = dmaJobs[0].source;
+    EDMAND  = dmaJobs[0].end;
+    EDMADST = dmaJobs[0].destination;
+
+    EIRbits.DMAIF = 0;
+    ECON1bits.CSUMEN = 0; // copy mode
+    ECON1bits.DMAST  = 1; // start dma
+    TMR1_ReadStamp(&dmaStarted);
+}
+
+/**
+ * Retire the running copy and start the next one
+ * A copy that did not complete drops the packet it was copying into.
+ * @param completed
+ */
+static void ETH_DmaDone(bool completed)
+{
+    txPacket_t *packet = dmaJobs[0].packet;
+    uint8_t index;
+    bool pending = false;
+
+    if(!completed)
+    {
+        ECON1bits.DMAST = 0; // give up on the DMA
+        SetBit(packet->flags, ETH_TX_DROPPED);
+        ethTxStats.dmaDrops ++;
+    }
+
+    dmaJobCount --;
+    for(index = 0; index < dmaJobCount; index++)
+    {
+        dmaJobs[index] = dmaJobs[index + 1];
+        pending |= (dmaJobs[index].packet == packet);
+    }
+    if(!pending)
+    {
+        ClearBit(packet->flags, ETH_DMA_PENDING);
+    }
+
+    if(dmaJobCount)
+    {
+        ETH_DmaStart();
+    }
+    else if(rxReleasePending)
+    {
+        ERXRDPT = rxRelease;
+        rxReleasePending = false;
+    }
+
+    // the packet may have been waiting for its copy to be sent
+    if( (ethListSize > 0) && (ECON1bits.TXRTS == 0) )
+    {
+        ETH_SendQueued();
+    }
+}
+
+/**
+ * Finish all the queued copies before going on
+ */
+static void ETH_DmaWait(void)
+{
+    uint16_t timer;
+
+    while(dmaJobCount)
+    {
+        /* sometimes it takes longer to complete if there is heavy network traffic */
+        timer = 40 * dmaJobs[0].length;
+        while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
+        EIRbits.DMAIF = 0;
+        ETH_DmaDone(ECON1bits.DMAST == 0);
+    }
+}
+
+/**
+ * Copy the data from RX Buffer to the TX Buffer using DMA setup
+ * The copy is queued and runs in the background. The packet is sent when it
+ * is done, or dropped if the DMA times out. The write pointer moves past the
+ * copied block right away.
+ * @param len
+ * @return
+ */
+error_msg ETH_Copy(uint16_t len)
+{
+    return ETH_CopyFrom(ERDPT, len);
+}
+
+/**
+ * Copy a block of the Ethernet SRAM to the TX Buffer, as ETH_Copy does
+ * @param source
+ *      Start of the block, in the RX buffer or the SRAM heap
+ * @param len
+ * @return
+ */
+error_msg ETH_CopyFrom(uint16_t source, uint16_t len)
+{
+    dmaJob_t *job;
+    uint16_t end;
+
+    if( (len == 0) || (pHead == NULL) )
+    {
+        return SUCCESS;
+    }
+
+    if(dmaJobCount == ETH_DMA_JOBS)
+    {
+        ETH_DmaWait();
+    }
+
+    end = source + len - 1; // J60 DMA uses an end pointer to mark the finish
+
+    // a block that runs past RXEND continues at RXSTART
+    if ((source <= RXEND) && (end > RXEND))
+    {
+        end = end - (RXEND - RXSTART + 1);
+    }
+
+    job = &dmaJobs[dmaJobCount];
+    job->source = source;
+    job->end = end;
+    job->destination = EWRPT;
+    job->length = len;
+    job->packet = pHead;
+    SetBit(pHead->flags, ETH_DMA_PENDING);
+
+    if(dmaJobCount++ == 0)
+    {
+        ETH_DmaStart();
+    }
+
+    EWRPT += len;
+    return SUCCESS;
+}
+
+/**
+ * Copy a block within the Ethernet SRAM and wait for it
+ * Queued copies to the TX Buffer finish first.
+ * @param destination
+ *      Start of the destination, outside the RX buffer
+ * @param source
+ *      Start of the block, in the RX buffer or the SRAM heap
+ * @param len
+ * @return
+ *      DMA_TIMEOUT if the copy did not complete
+ */
+error_msg ETH_SramCopy(uint16_t destination, uint16_t source, uint16_t len)
+{
+    uint16_t timer;
+    uint16_t end;
+
+    if(len == 0)
+    {
+        return SUCCESS;
+    }
+
+    ETH_DmaWait();
+
+    end = source + len - 1; // J60 DMA uses an end pointer to mark the finish
+
+    // a block that runs past RXEND continues at RXSTART
+    if ((source <= RXEND) && (end > RXEND))
+    {
+        end = end - (RXEND - RXSTART + 1);
+    }
+
+    EDMAST  = source;
+    EDMAND  = end;
+    EDMADST = destination;
+
+    EIRbits.DMAIF = 0;
+    ECON1bits.CSUMEN = 0; // copy mode
+    ECON1bits.DMAST  = 1; // start dma
+    /* sometimes it takes longer to complete if there is heavy network traffic */
+    timer = 40 * len;
+    while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
+    EIRbits.DMAIF = 0;
+    if(ECON1bits.DMAST != 0)
+    {
+        ECON1bits.DMAST = 0; // give up on the DMA
+        return DMA_TIMEOUT;
+    }
+    return SUCCESS;
+}
+#endif
+
+uint16_t ETH_GetHeapStart(void)
+{
+    return RXEND + 1;
+}
+
+/**
+ * Read a block of the Ethernet SRAM outside the RX buffer
+ * The read pointer and the received packet are left alone.
+ * @param address
+ * @param data
+ * @param len
+ */
+void ETH_SramRead(uint16_t address, void *data, uint16_t len)
+{
+    uint16_t rdptr = ERDPT;
+
+    ERDPT = address;
+    ETH_EdataReadBurst(data, len);
+    ERDPT = rdptr;
+}
+
+/**
+ * Write a block of the Ethernet SRAM outside the RX and TX buffers
+ * Queued copies finish first, they may still read the old data.
+ * @param address
+ * @param data
+ * @param len
+ */
+void ETH_SramWrite(uint16_t address, const void *data, uint16_t len)
+{
+    uint16_t wrptr;
+
+#ifndef ETH_SIMPLE_COPY
+    ETH_DmaWait();
+#endif
+    wrptr = EWRPT;
+    EWRPT = address;
+    ETH_EdataWriteBurst(data, len);
+    EWRPT = wrptr;
+}
+
+//#define ETH_SOFTWARE_CHECKSUM
+
+#ifndef ETH_SOFTWARE_CHECKSUM
+/**
+ * Sum a block of the Ethernet buffer with the DMA checksum engine
+ * @param len
+ *      Number of bytes to sum, starting at the read pointer
+ * @param cksm
+ *      Receives the inverted sum (EDMACS)
+ * @return
+ *      true if the DMA completed, false if it was busy or timed out
+ */
+static bool ETH_DmaChecksum(uint16_t len, uint16_t *cksm)
+{
+    uint16_t timer;
+    uint16_t end;
+
+#ifndef ETH_SIMPLE_COPY
+    if(dmaJobCount)
+    {
+        // the engine is copying, don't wait for it
+        return false;
+    }
+#endif
+
+    timer = 2 * len;
+    while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
+    if(ECON1bits.DMAST==0)
+    {
+        EDMAST = ERDPT;
+        end = ERDPT + len - 1; // J60 DMA uses an end pointer to mark the finish
+
+        // a block that runs past RXEND continues at RXSTART
+        if ((ERDPT <= RXEND) && (end > RXEND))
+        {
+            end = end - (RXEND - RXSTART + 1);
+        }
+        EDMAND = end;
+
+        ECON1bits.CSUMEN = 1; // checksum mode
+        ECON1bits.DMAST  = 1; // start dma
+        /* sometimes it takes longer to complete if there is heavy network traffic */
+        timer = 40 * len;
+        while(ECON1bits.DMAST!=0 && --timer) NOP(); // sit here until DMA is free
+        if(ECON1bits.DMAST == 0)
+        {
+            *cksm = EDMACS;
+            return true;
+        }
+        ECON1bits.DMAST = 0; // give up on the DMA, the caller sums in software
+    }
+    return false;
+}
+#endif
+
+static uint16_t ETH_ComputeChecksum(uint16_t len, uint16_t seed)
+{
+    uint32_t cksm;
+    uint16_t v;
+    NET_PROFILE_START(start);
+
+    cksm = seed;
+
+#ifndef ETH_SOFTWARE_CHECKSUM
+    if(len && ETH_DmaChecksum(len, &v))
+    {
+        // EDMACS is already inverted, add the plain sum to the seed
+        cksm += (uint16_t)~v;
+        len = 0;
+    }
+#endif
+
+    while(len > 1)
+    {
+        v = 0;
+        ((char *)&v)[1] = ETH_EdataRead();
+        ((char *)&v)[0] = ETH_EdataRead();
+        cksm += v;
+        len -= 2;
+    }
+
+    if(len)
+    {
+        v = 0;
+        ((char *)&v)[1] = ETH_EdataRead();
+        ((char *)&v)[0] = 0;
+        cksm += v;
+    }
+    
+    // wrap the checksum
+    while(cksm >> 16)
+    {
+        cksm = (cksm & 0x0FFFF) + (cksm>>16);
+    }
+
+    // invert the number.
+    cksm = ~cksm;
+
+    NET_PROFILE_STOP(NET_PROFILE_CHECKSUM, start);
+    // Return the resulting checksum
+    return (uint16_t)cksm;
+}
+
+/**
+ * Sum a block of the Ethernet SRAM outside the RX buffer
+ * The read pointer and the received packet are left alone.
+ * @param address
+ * @param len
+ * @return
+ *      The folded sum, not inverted, to be used as a checksum seed
+ */
+uint16_t ETH_SramChecksum(uint16_t address, uint16_t len)
+{
+    uint16_t rdptr;
+    uint16_t cksm;
+
+#ifndef ETH_SIMPLE_COPY
+    // the engine sums it rather than the CPU once the copies are done
+    ETH_DmaWait();
+#endif
+
+    rdptr = ERDPT;
+    ERDPT = address;
+    cksm = ~ETH_ComputeChecksum(len, 0);
+    ERDPT = rdptr;
+    return cksm;
+}
+
+/**
+ * Calculate the TX Checksum - DMA checksum, software when ETH_SOFTWARE_CHECKSUM is defined
+ * @param position
+ * @param len
+ * @param seed
+ * @return
+ */
+uint16_t ETH_TxComputeChecksum(uint16_t position, uint16_t len, uint16_t seed)
+{
+    uint16_t rxptr;
+    uint16_t cksm;
+
+#ifndef ETH_SIMPLE_COPY
+    // the sum may cover data that is still being copied in
+    ETH_DmaWait();
+#endif
+
+    // Save the read pointer starting address
+    rxptr = ERDPT;
+
+    // position the read pointer for the checksum
+    ERDPT = pHead->packetStart + position + 1; // we need +1 here because of SFD.
+
+    cksm = ETH_ComputeChecksum( len, seed);
+    
+    // Restore old read pointer location
+    ERDPT = rxptr;
+
+    cksm = ((cksm & 0xFF00) >> 8) | ((cksm & 0x00FF) << 8);
+    // Return the resulting checksum
+    return cksm;
+}
+
+/**
+ * Calculate RX checksum - DMA checksum, software when ETH_SOFTWARE_CHECKSUM is defined
+ * @param len
+ * @param seed
+ * @return
+ */
+uint16_t ETH_RxComputeChecksum(uint16_t len, uint16_t seed)
+{
+    uint16_t rxptr;
+    uint32_t cksm;
+
+    // Save the read pointer starting address
+    rxptr = ERDPT;
+
+    cksm = ETH_ComputeChecksum( len, seed);
+    
+    // Restore old read pointer location
+    ERDPT = rxptr;
+    
+    // Return the resulting checksum
+    cksm = ((cksm & 0xFF00) >> 8) | ((cksm & 0x00FF) << 8);
+    return (uint16_t)cksm;
+}
+
+/**
+ * Get the MAC address
+ * @param mac
+ */
+void ETH_GetMAC(uint8_t *mac)
+{
+
+    *mac++ = MAADR1; 
+    *mac++ = MAADR2; 
+    *mac++ = MAADR3; 
+    *mac++ = MAADR4; 
+    *mac++ = MAADR5; 
+    *mac = MAADR6;  
+
+}
+
+/**
+ * Set the MAC address
+ * @param mac
+ */
+
+void ETH_SetMAC(uint8_t *mac)
+{
+    MAADR1 = *mac++;
+    MAADR2 = *mac++;
+    MAADR3 = *mac++;
+    MAADR4 = *mac++;
+    MAADR5 = *mac++;
+    MAADR6 = *mac;
+}
+
+
+void ETH_SaveRDPT(void)
+{
+    ethData.saveRDPT = ERDPT;
+}
+
+uint16_t ETH_GetReadPtr(void)
+{
+    return(ERDPT);
+}
+
+void ETH_SetReadPtr(uint16_t rdptr)
+{
+    ERDPT = rdptr;
+}
+
+void ETH_MoveBackReadPtr(uint16_t offset)
+{
+    uint16_t rdptr;
+    
+    rdptr = ERDPT;
+    ERDPT = rdptr - offset;
+    ETH_SetRxByteCount(offset);
+  
+        
+}
+
+void ETH_ResetReadPtr()
+{
+    ERDPT = RXSTART;
+}
+
+uint16_t ETH_GetWritePtr()
+{
+    return (EWRPT);
+}
+
+uint16_t ETH_GetRxByteCount()
+{
+    return (rxPacketStatusVector.byteCount);
+}
+
+void ETH_SetRxByteCount(uint16_t count)
+{
+    rxPacketStatusVector.byteCount += count;
+}
+
+void ETH_ResetByteCount(void)
+{
+    ethData.saveWRPT = EWRPT;
+}
+
+uint16_t ETH_GetByteCount(void)
+{
+    return (EWRPT - ethData.saveWRPT);
+}
+
+void ETH_SaveWRPT(void)
+{
+    ethData.saveWRPT = EWRPT;
+}
+
+uint16_t ETH_ReadSavedWRPT(void)
+{
+    return ethData.saveWRPT;
+}
+
+uint16_t ETH_GetStatusVectorByteCount(void)
+{
+    return(rxPacketStatusVector.byteCount);
+}
+
+void ETH_SetStatusVectorByteCount(uint16_t bc)
+{
+    rxPacketStatusVector.byteCount=bc;
+}
+
+/**
+ * Reset the Ethernet Packet List
+ * @param 
+ * @return
+ */
+void ETH_PacketListReset(void)
+{
+    uint16_t index = 0;
+    uint8_t* ptr = (uint8_t*)txData;
+    ethListSize = 0;
+
+    pHead = NULL;
+    pTail = NULL;
+    pTxPacket = NULL;
+    ethTxStats.classes[ETH_TX_BULK].queued = 0;
+    ethTxStats.classes[ETH_TX_CONTROL].queued = 0;
+
+#ifndef ETH_SIMPLE_COPY
+    // the copies have nowhere to go anymore
+    if(dmaJobCount)
+    {
+        ECON1bits.DMAST = 0;
+        dmaJobCount = 0;
+    }
+    if(rxReleasePending)
+    {
+        ERXRDPT = rxRelease;
+        rxReleasePending = false;
+    }
+#endif
+
+    while( index < (MAX_TX_PACKETS * sizeof(txPacket_t)) )
+    {
+        ptr[index] = 0;
+        index++;
+    }
+}
+
+/**
+ * Find the newest or the oldest packet in the ring part of the TX Buffer
+ * @param   newest
+ * @return  NULL when only the control area holds packets
+ */
+static txPacket_t *ETH_TxRingPacket(bool newest)
+{
+    txPacket_t *packet = newest ? pHead : pTail;
+
+    while( (packet != NULL) && (packet->packetStart >= TXCONTROLSTART) )
+    {
+        packet = newest ? packet->nextPacket : packet->prevPacket;
+    }
+    return packet;
+}
+
+/**
+ * Find the start address for a new packet in the TX Buffer
+ * The ring is used as such: a packet goes after the newest packet in it,
+ * or back at TXSTART when it would not fit before TXRINGEND. Queued packets
+ * are never moved, a wrap with packets still queued is counted as a shift
+ * the old compacting allocator would have made. A packet of up to
+ * ETH_TX_CONTROL_LENGTH bytes that finds the ring full takes a free slot
+ * of the control area.
+ * @param   length  bytes after the Ethernet header
+ * @param   packetStart
+ * @return  false when there is no room for the packet
+ */
+static bool ETH_TxPlace(uint16_t length, uint16_t *packetStart)
+{
+    uint16_t slot = TX_SLOT(length);
+    uint16_t next;
+    uint16_t oldest;
+    txPacket_t *newest = ETH_TxRingPacket(true);
+    uint8_t index;
+
+    if( newest == NULL )
+    {
+        *packetStart = TXSTART;
+        return true;
+    }
+
+    // first even address after the newest packet and its status vector
+    next = (newest->packetEnd + TX_STATUS_VECTOR_SIZE + 2) & 0xFFFE;
+    oldest = ETH_TxRingPacket(false)->packetStart;
+
+    if( next > oldest )
+    {
+        // the queue does not wrap: free space up to TXRINGEND, then in front of the oldest packet
+        if( (next <= TXRINGEND) && ((TXRINGEND + 1) - next >= slot) )
+        {
+            *packetStart = next;
+            return true;
+        }
+        if( oldest - TXSTART >= slot )
+        {
+            *packetStart = TXSTART;
+            return true;
+        }
+    }
+    else if( oldest - next >= slot )
+    {
+        // the queue wraps: only the gap in front of the oldest packet is free
+        *packetStart = next;
+        return true;
+    }
+
+    if( slot > TX_CONTROL_SLOT )
+    {
+        return false;
+    }
+    for( next = TXCONTROLSTART; next < TXEND; next += TX_CONTROL_SLOT )
+    {
+        for( index = 0; index < MAX_TX_PACKETS; index++ )
+        {
+            if( CheckBit(txData[index].flags, ETH_ALLOCATED) && (txData[index].packetStart == next) )
+            {
+                break;
+            }
+        }
+        if( index == MAX_TX_PACKETS )
+        {
+            *packetStart = next;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * "Allocate" a new packet element and link it into the chained list
+ * @param   length  bytes after the Ethernet header
+ * @return  packet address
+ */
+txPacket_t* ETH_NewPacket(uint16_t length)
+{
+    uint8_t index = 0;
+    uint16_t packetStart;
+    txPacket_t *newest;
+
+    if( ethListSize == MAX_TX_PACKETS )
+    {
+        return NULL;
+    }
+
+    if( !ETH_TxPlace(length, &packetStart) )
+    {
+        return NULL;
+    }
+
+    newest = ETH_TxRingPacket(true);
+    if( packetStart >= TXCONTROLSTART )
+    {
+        ethTxStats.controlArea ++;
+    }
+    else if( (newest != NULL) && (packetStart == TXSTART) )
+    {
+        // wrapped with packets still queued
+        ethTxStats.shiftsAvoided ++;
+        ethTxStats.shiftBytesAvoided += (newest->packetEnd + 1) - ETH_TxRingPacket(false)->packetStart;
+    }
+
+    while( index < MAX_TX_PACKETS )
+    {
+        if( CheckBit(txData[index].flags, ETH_ALLOCATED) == false )
+        {
+            txData[index].flags = 0;                        // reset all flags
+            SetBit(txData[index].flags, ETH_ALLOCATED);     // allocated = true - mark the handle as allocated
+
+            // the room ETH_WriteStart leaves for the packet
+            txData[index].packetEnd = packetStart + TX_SLOT(length) - TX_STATUS_VECTOR_SIZE - 1;
+
+            txData[index].prevPacket = NULL;
+            txData[index].nextPacket = pHead;
+
+            txData[index].packetStart = packetStart;
+            if( pHead != NULL )
+            {
+                pHead->prevPacket = &txData[index];
+            }
+            else
+            {
+                pTail = (txPacket_t*)&txData[index];
+            }
+
+            pHead = (txPacket_t*)&txData[index];
+
+            ethListSize ++;
+            return &txData[index];
+        }
+        index ++;
+    }
+
+    return NULL;
+}
+
+/**
+ * Unlink a packet element from the chained list and "deallocate" it
+ * @param   packetHandle
+ * @return 
+ */
+void ETH_RemovePacket(txPacket_t* pPacket)
+{
+#ifdef VALIDATE_ALLOCATED_PTR
+    uint8_t index = 0;
+#endif /* VALIDATE_ALLOCATED_PTR */
+
+    if( (pPacket == NULL) || (ethListSize == 0) )
+    {
+        return;
+    }
+
+#ifdef VALIDATE_ALLOCATED_PTR
+    while( index < MAX_TX_PACKETS )
+    {
+        if( (pPacket == &txData[index]) && (txData[index].allocated == true) )
+        {
+            break;
+        }
+        index ++;
+    }
+    if( index == MAX_TX_PACKETS )
+    {
+        return;
+    }
+#endif  /* VALIDATE_ALLOCATED_PTR */
+
+    // Unlink from the chained list, control packets leave it out of order
+    if( pPacket->nextPacket == NULL )
+    {
+        pTail = pPacket->prevPacket;
+        if( pTail != NULL )
+        {
+            pTail->nextPacket = NULL;
+        }
+    }
+    else if( pPacket->prevPacket != NULL )
+    {
+        ((txPacket_t *)pPacket->prevPacket)->nextPacket = pPacket->nextPacket;
+        ((txPacket_t *)pPacket->nextPacket)->prevPacket = pPacket->prevPacket;
+    }
+
+    if( pPacket->prevPacket == NULL )
+    {
+        pHead = pPacket->nextPacket;
+        if( pHead != NULL )
+        {
+            pHead->prevPacket = NULL;
+        }
+    }
+
+    // Deallocate
+    pPacket->flags = 0;
+    pPacket->prevPacket = NULL;
+    pPacket->nextPacket = NULL;
+
+    ethListSize --;
+
+    return;
+}
+
+
@@ -1,162 +1,240 @@
-/**
-  Ethernet Driver Header File
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    ethernet_driver.h
-
-  Summary:
-    Public Interface definition for Ethernet driver.    
-
-  Description:
-  This files include definitions of public interface for an ethernet driver.
-  See individual ethernet drivers for specific implementations of this interface.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-#ifndef ETHERNET_DRIVER_H
-#define	ETHERNET_DRIVER_H
-
-#include "tcpip_types.h"
-#include <stdbool.h>
-#include <stdint.h>
-#include "mac_address.h"
-
-
-typedef union
-{
-    uint8_t v[4];
-    struct
-    {
-        uint16_t byteCount;
-        unsigned long_drop_event:1;
-        unsigned :1;
-        unsigned excessCarrierEvent:1;
-        unsigned :1;
-        unsigned crcError:1;
-        unsigned lengthCheckError:1;
-        unsigned lengthLongError:1;
-        unsigned rxOK:1;
-        unsigned rxMulticast:1;
-        unsigned rxBroadcast:1;
-        unsigned dribbleNibble:1;
-        unsigned controlFrame:1;
-        unsigned pauseControlFrame:1;
-        unsigned unknownContrlFrame:1;
-        unsigned vlanTagPresent:1;
-        unsigned zero:1;
-    };
-}receiveStatusVector_t;
-
-
-typedef struct 
-{
-	unsigned error:1;
-	unsigned pktReady:1;
-	unsigned up:1;
-	unsigned idle:1;
-	unsigned linkChange:1;
-        unsigned bufferBusy:1;
-        unsigned :3;
-        uint16_t saveRDPT;
-        uint16_t saveWRPT;
-} ethernetDriver_t;
-
-typedef struct 
-{
-    uint16_t flags;
-    uint16_t packetStart;
-    uint16_t packetEnd;
-
-    void    *prevPacket;
-    void    *nextPacket;
-} txPacket_t;
-
-extern volatile ethernetDriver_t ethData;
-
-#define ETH_packetReady() ethData.pktReady
-#define ETH_linkCheck()   ethData.up
-#define ETH_linkChanged() ethData.linkChange
-
-
-void ETH_Init(void);            // setup the ethernet and get it running
-void ETH_EventHandler(void);    // Manage the MAC events.  Poll this or put it in the ISR
-void ETH_NextPacketUpdate(void);    // Update the pointers for the next available RX packets
-void ETH_ResetReceiver(void);   // Reset the receiver
-void ETH_SendSystemReset(void); // Reset the transmitter
-
-// Read functions for data
-uint16_t ETH_ReadBlock(void*, uint16_t); // read a block of data from the MAC
-uint8_t ETH_Read8(void);                 // read 1 byte from the MAC
-uint16_t ETH_Read16(void);               // read 2 bytes and return them in host order
-uint32_t ETH_Read24(void);              // read 3 bytes and return them in host order
-uint32_t ETH_Read32(void);               // read 4 bytes and return them in host order
-void ETH_Dump(uint16_t);                 // drop N bytes from a packet (data is lost)
-void ETH_Flush(void);                    // drop the rest of this packet and release the buffer
-
-uint16_t ETH_GetFreeTxBufferSize(void);                         // returns the available space size in the TX buffer
-
-error_msg ETH_WriteStart(const mac48Address_t *dest_mac, uint16_t type);
-uint16_t ETH_WriteString(const char *string);                            // write a string of data into the MAC
-uint16_t ETH_WriteBlock(const char *, uint16_t);                         // write a block of data into the MAC    jira:M8TS-608
-void ETH_Write8(uint8_t);                                          // write a byte into the MAC
-void ETH_Write16(uint16_t);                                        // write 2 bytes into the MAC in Network order
-void ETH_Write24(uint32_t data);                                   // write 3 bytes into the MAC in Network order
-void ETH_Write32(uint32_t);                                        // write 4 bytes into the MAC in Network order
-void ETH_Insert(char *,uint16_t, uint16_t);                        // insert N bytes into a specific offset in the TX packet
-error_msg ETH_Copy(uint16_t);                                      // copy N bytes from saved read location into the current tx location
-error_msg ETH_Send(void);                                          // Send the TX packet
-
-uint16_t ETH_TxComputeChecksum(uint16_t position, uint16_t len, uint16_t seed); // compute the checksum of len bytes starting with position.
-uint16_t ETH_RxComputeChecksum(uint16_t len, uint16_t seed);
-
-void ETH_GetMAC(uint8_t *);            // get the MAC address
-void ETH_SetMAC(uint8_t *);            // set the MAC address
-uint16_t ETH_GetWritePtr();
-void ETH_SaveRDPT(void);               // save the receive pointer for copy
-void ETH_ResetReadPtr();               //Reset the receive pointer to the Init
-uint16_t ETH_GetReadPtr(void);         //returns the value of the read pointer
-void ETH_SetReadPtr(uint16_t);         //sets the read pointer to a specific address
-uint16_t ETH_GetStatusVectorByteCount(void);
-void ETH_SetStatusVectorByteCount(uint16_t);
-
-void ETH_ResetByteCount(void);
-uint16_t ETH_GetByteCount(void);
-
-uint16_t ETH_ReadSavedWRPT(void);
-void ETH_SaveWRPT(void);
-void ETH_SetRxByteCount(uint16_t count);
-uint16_t ETH_GetRxByteCount(void);
-
-bool ETH_CheckLinkUp(void);
-
-void ETH_TxReset(void);
-void ETH_MoveBackReadPtr(uint16_t offset);
-
-
-#endif	/* ETHERNET_DRIVER_H */
-
+/**
+  Ethernet Driver Header File
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    ethernet_driver.h
+
+  Summary:
+    Public Interface definition for Ethernet driver.    
+
+  Description:
+  This files include definitions of public interface for an ethernet driver.
+  See individual ethernet drivers for specific implementations of this interface.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+#ifndef ETHERNET_DRIVER_H
+#define	ETHERNET_DRIVER_H
+
+#include "tcpip_types.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "mac_address.h"
+#include "../tmr1.h"
+
+#define ETH_MTU                 (1500u)     // most bytes after the Ethernet header
+#define ETH_TX_CONTROL_LENGTH   (64u)       // most bytes after the Ethernet header of a frame the control area takes
+
+
+typedef union
+{
+    uint8_t v[4];
+    struct
+    {
+        uint16_t byteCount;
+        unsigned long_drop_event:1;
+        unsigned :1;
+        unsigned excessCarrierEvent:1;
+        unsigned :1;
+        unsigned crcError:1;
+        unsigned lengthCheckError:1;
+        unsigned lengthLongError:1;
+        unsigned rxOK:1;
+        unsigned rxMulticast:1;
+        unsigned rxBroadcast:1;
+        unsigned dribbleNibble:1;
+        unsigned controlFrame:1;
+        unsigned pauseControlFrame:1;
+        unsigned unknownContrlFrame:1;
+        unsigned vlanTagPresent:1;
+        unsigned zero:1;
+    };
+}receiveStatusVector_t;
+
+
+typedef struct 
+{
+	unsigned error:1;
+	unsigned pktReady:1;
+	unsigned up:1;
+	unsigned idle:1;
+	unsigned linkChange:1;
+        unsigned bufferBusy:1;
+        unsigned :3;
+        uint16_t saveRDPT;
+        uint16_t saveWRPT;
+} ethernetDriver_t;
+
+typedef struct 
+{
+    uint16_t flags;
+    uint16_t packetStart;
+    uint16_t packetEnd;
+
+    tmr1Stamp_t queuedAt;           // when ETH_Send queued it
+
+    void    *prevPacket;
+    void    *nextPacket;
+} txPacket_t;
+
+// transmit classes, a queued control packet is sent before any bulk packet
+typedef enum
+{
+    ETH_TX_BULK,                    // data
+    ETH_TX_CONTROL,                 // ARP, ICMP and TCP segments without data
+    ETH_TX_CLASSES
+} ethTxClass_t;
+
+typedef struct
+{
+    uint8_t queued;                 // packets of the class waiting to be sent
+    uint8_t queuedPeak;
+    uint32_t sent;
+    uint32_t latencyTicks;          // TMR1 ticks from ETH_Send to the start of transmission, summed
+    uint16_t latencyPeak;           // 0xFFFF for a packet that waited longer
+} ethTxClassStats_t;
+
+typedef struct
+{
+    uint16_t shiftsAvoided;         // TX Buffer wraps with packets still queued
+    uint32_t shiftBytesAvoided;     // queued bytes a compaction would have moved
+    uint16_t dmaDrops;              // packets dropped because their DMA copy timed out
+    uint16_t overtaken;             // control packets sent ahead of an older bulk packet
+    uint16_t controlArea;           // small packets written to the control area while the ring was full
+    ethTxClassStats_t classes[ETH_TX_CLASSES];
+} ethTxStats_t;
+
+typedef struct
+{
+    uint16_t start;                 // address of the packet in the RX buffer
+    uint16_t next;                  // next packet pointer
+    receiveStatusVector_t status;
+} rxDescriptor_t;
+
+typedef struct
+{
+    uint8_t waitingPeak;            // most packets waiting in the RX ring
+    uint16_t ringFull;              // times the RX ring was full
+    uint16_t overflows;             // times the RX buffer overflowed and packets were lost
+    uint16_t pauses;                // times PAUSE frames were started to hold the link partner
+} ethRxStats_t;
+
+// broadcast frames taken by the receive filter
+typedef enum
+{
+    ETH_RX_BROADCAST,               // all of them
+    ETH_RX_ARP,                     // ARP only
+    ETH_RX_ARP_FOR                  // ARP for one IP address only
+} ethRxFilter_t;
+
+extern volatile ethernetDriver_t ethData;
+extern ethTxStats_t ethTxStats;
+extern ethRxStats_t ethRxStats;
+
+#define ETH_packetReady() (ETH_RxPacketsWaiting() != 0)
+#define ETH_linkCheck()   ethData.up
+#define ETH_linkChanged() ethData.linkChange
+
+
+void ETH_Init(void);            // setup the ethernet and get it running
+void ETH_EventHandler(void);    // Manage the MAC events.  Poll this
+void ETH_ISR(void);             // Ethernet interrupt, records received packets
+uint8_t ETH_RxPacketsWaiting(void); // received packets not flushed yet
+uint16_t ETH_NextPacketLength(void);  // length of the next received packet, 0 if none
+void ETH_NextPacketUpdate(void);    // Update the pointers for the next available RX packets
+void ETH_ResetReceiver(void);   // Reset the receiver
+void ETH_SendSystemReset(void); // Reset the transmitter
+void ETH_SetRxFilter(ethRxFilter_t filter, uint32_t ipAddress); // choose the broadcast frames to receive
+
+// Read functions for data
+uint16_t ETH_ReadBlock(void*, uint16_t); // read a block of data from the MAC
+uint8_t ETH_Read8(void);                 // read 1 byte from the MAC
+uint16_t ETH_Read16(void);               // read 2 bytes and return them in host order
+uint32_t ETH_Read24(void);              // read 3 bytes and return them in host order
+uint32_t ETH_Read32(void);               // read 4 bytes and return them in host order
+void ETH_Dump(uint16_t);                 // drop N bytes from a packet (data is lost)
+void ETH_Flush(void);                    // drop the rest of this packet and release the buffer
+
+uint16_t ETH_GetFreeTxBufferSize(void);                         // returns the available space size in the TX buffer
+bool ETH_TxReady(uint16_t length);                              // true if ETH_WriteStart can start a packet of length bytes now
+
+error_msg ETH_WriteStart(const mac48Address_t *dest_mac, uint16_t type, uint16_t length);  // length: most bytes written after the header
+void ETH_SetTxClass(ethTxClass_t txClass);                         // transmit class of the packet being written, bulk by default
+uint16_t ETH_WriteString(const char *string);                            // write a string of data into the MAC
+uint16_t ETH_WriteBlock(const char *, uint16_t);                         // write a block of data into the MAC    jira:M8TS-608
+void ETH_Write8(uint8_t);                                          // write a byte into the MAC
+void ETH_Write16(uint16_t);                                        // write 2 bytes into the MAC in Network order
+void ETH_Write24(uint32_t data);                                   // write 3 bytes into the MAC in Network order
+void ETH_Write32(uint32_t);                                        // write 4 bytes into the MAC in Network order
+void ETH_Insert(char *,uint16_t, uint16_t);                        // insert N bytes into a specific offset in the TX packet
+error_msg ETH_Copy(uint16_t);                                      // copy N bytes from saved read location into the current tx location
+error_msg ETH_CopyFrom(uint16_t source, uint16_t len);             // copy N bytes from an SRAM address into the current tx location
+error_msg ETH_Send(void);                                          // Send the TX packet
+
+uint16_t ETH_TxComputeChecksum(uint16_t position, uint16_t len, uint16_t seed); // compute the checksum of len bytes starting with position.
+void ETH_TxChecksumStart(void);                                    // start summing the bytes written from here on
+uint16_t ETH_TxChecksumGet(uint16_t seed);                         // checksum of the bytes written since ETH_TxChecksumStart
+uint16_t ETH_RxComputeChecksum(uint16_t len, uint16_t seed);
+void ETH_RxChecksumStart(uint16_t seed);                           // start summing the received data from here on
+uint16_t ETH_ReadBlockChecksum(void *, uint16_t);                  // read a block of data from the MAC and sum it
+void ETH_RxChecksumAhead(uint16_t len);                            // sum the next len bytes without reading them
+uint16_t ETH_RxChecksumGet(void);                                  // 0 if the summed data checks out
+
+void ETH_GetMAC(uint8_t *);            // get the MAC address
+void ETH_SetMAC(uint8_t *);            // set the MAC address
+uint16_t ETH_GetWritePtr();
+void ETH_SaveRDPT(void);               // save the receive pointer for copy
+void ETH_ResetReadPtr();               //Reset the receive pointer to the Init
+uint16_t ETH_GetReadPtr(void);         //returns the value of the read pointer
+void ETH_SetReadPtr(uint16_t);         //sets the read pointer to a specific address
+uint16_t ETH_GetStatusVectorByteCount(void);
+void ETH_SetStatusVectorByteCount(uint16_t);
+
+void ETH_ResetByteCount(void);
+uint16_t ETH_GetByteCount(void);
+
+uint16_t ETH_ReadSavedWRPT(void);
+void ETH_SaveWRPT(void);
+void ETH_SetRxByteCount(uint16_t count);
+uint16_t ETH_GetRxByteCount(void);
+
+bool ETH_CheckLinkUp(void);
+
+// Ethernet SRAM outside the RX and TX buffers, see sram_heap.h
+uint16_t ETH_GetHeapStart(void);                                                // first address after the RX buffer
+void ETH_SramRead(uint16_t address, void *data, uint16_t len);                  // read a block, the read pointer is kept
+void ETH_SramWrite(uint16_t address, const void *data, uint16_t len);           // write a block, the write pointer is kept
+error_msg ETH_SramCopy(uint16_t destination, uint16_t source, uint16_t len);    // DMA copy a block and wait for it
+uint16_t ETH_SramChecksum(uint16_t address, uint16_t len);                      // folded sum of a block, not inverted
+
+void ETH_TxReset(void);
+void ETH_MoveBackReadPtr(uint16_t offset);
+
+
+#endif	/* ETHERNET_DRIVER_H */
+
@@ -1,52 +1,52 @@
-/**
- lfsr API Header File
-
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-   lfsr.h
-
-  Summary:
-    Header file for the lfsr implementation.
-
-  Description:
-    This header file provides APIs for the lfsr implementation
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software
-and any derivatives exclusively with Microchip products.
-
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS,
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE
-IN ANY APPLICATION.
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS.
-
-*/
-
-#ifndef __LFSR_H
-#define __LFSR_H
-#include <stdint.h>
-
-typedef uint8_t lfsr_t;
-int lfsr_getSequenceCount(void);
-lfsr_t lfsr_getSequence(void);
-void lfsr_reset(void);
-void lfsr_setSequence(uint16_t s);  //jira: CAE_MCU8-5647
-lfsr_t lfsr(void);
-lfsr_t lfsrWithSeed(uint8_t lfsrSeed);
-
-#endif // __LFSR_H
+/**
+ lfsr API Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+   lfsr.h
+
+  Summary:
+    Header file for the lfsr implementation.
+
+  Description:
+    This header file provides APIs for the lfsr implementation
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software
+and any derivatives exclusively with Microchip products.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS,
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE
+IN ANY APPLICATION.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS.
+
+*/
+
+#ifndef __LFSR_H
+#define __LFSR_H
+#include <stdint.h>
+
+typedef uint8_t lfsr_t;
+int lfsr_getSequenceCount(void);
+lfsr_t lfsr_getSequence(void);
+void lfsr_reset(void);
+void lfsr_setSequence(uint16_t s);  //jira: CAE_MCU8-5647
+lfsr_t lfsr(void);
+lfsr_t lfsrWithSeed(uint8_t lfsrSeed);
+
+#endif // __LFSR_H
@@ -1,62 +1,62 @@
-/**
-  Descriptive File Name
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    log_console.h
-
-  Summary:
-    This is the header file for the log_console.c
-
-  Description:
-    This header file provides the API for sending log messages to console.
-
- */
-
-/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
- * and any derivatives exclusively with Microchip products. 
- * 
- * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
- * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
- * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
- * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
- * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
- *
- * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
- * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
- * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
- * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
- * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
- * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
- * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
- *
- * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
- * TERMS. 
- */
-
-// This is a guard condition so that contents of this file are not included
-// more than once.  
-#ifndef LOG_CONSOLE_H
-#define	LOG_CONSOLE_H
-
-
-/*Log a message to console.
- * The function will log a message to console using UART.
- * 
- * @param message
- *      Message
- * 
- * @param priorityVal
- *      Message priority
- * 
- * @param return
- *      1
- * 
- */
-uint8_t logConsole(const char *message, uint8_t priorityVal);
-
-
-#endif	/* LOG_CONSOLE_H */
-
+/**
+  Descriptive File Name
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    log_console.h
+
+  Summary:
+    This is the header file for the log_console.c
+
+  Description:
+    This header file provides the API for sending log messages to console.
+
+ */
+
+/* Microchip Technology Inc. and its subsidiaries.  You may use this software 
+ * and any derivatives exclusively with Microchip products. 
+ * 
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER 
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED 
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A 
+ * PARTICULAR PURPOSE, OR ITS INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION 
+ * WITH ANY OTHER PRODUCTS, OR USE IN ANY APPLICATION. 
+ *
+ * IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+ * INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+ * WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS 
+ * BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE.  TO THE 
+ * FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS 
+ * IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF 
+ * ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+ *
+ * MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE 
+ * TERMS. 
+ */
+
+// This is a guard condition so that contents of this file are not included
+// more than once.  
+#ifndef LOG_CONSOLE_H
+#define	LOG_CONSOLE_H
+
+
+/*Log a message to console.
+ * The function will log a message to console using UART.
+ * 
+ * @param message
+ *      Message
+ * 
+ * @param priorityVal
+ *      Message priority
+ * 
+ * @param return
+ *      1
+ * 
+ */
+uint8_t logConsole(const char *message, uint8_t priorityVal);
+
+
+#endif	/* LOG_CONSOLE_H */
+
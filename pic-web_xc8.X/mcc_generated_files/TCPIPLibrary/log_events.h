@@ -0,0 +1,91 @@
+/**
+  Binary log events header file
+	
+  File Name:
+    log_events.h
+
+  Summary:
+    The events logged through LOG_Event().
+
+  Description:
+    This header file lists the log events of the stack with their text.  The
+    firmware only uses the event IDs, the host decoder (sim/log-decode) is
+    built from the same list and prints the text.
+
+ */
+
+#ifndef LOG_EVENTS_H
+#define	LOG_EVENTS_H
+
+// EVENT(id, text): the text may print the two arguments of the record with
+// unsigned int conversions (%u, %x, %04X...).  Add new events at the end, the
+// IDs of older firmware then still decode.
+#define LOG_EVENT_LIST(EVENT) \
+    EVENT(LOG_EV_NET_VLAN_DROPPED,         "VLAN Packet Dropped") \
+    EVENT(LOG_EV_NET_RX_ARP,               "RX ARPV4 Packet") \
+    EVENT(LOG_EV_NET_RX_IPV4,              "RX IPV4 Packet") \
+    EVENT(LOG_EV_NET_IPV6_DROPPED,         "RX IPV6 Packet Dropped") \
+    EVENT(LOG_EV_NET_8023_LENGTH,          "802.3 length 0x%04X") \
+    EVENT(LOG_EV_NET_8023_TYPE,            "802.3 type 0x%04X") \
+    EVENT(LOG_EV_IPV4_RX_ICMP,             "IPv4 RX ICMP") \
+    EVENT(LOG_EV_IPV4_ICMP_CHECKSUM,       "icmp wrong cksm : %x") \
+    EVENT(LOG_EV_IPV4_RX_UDP,              "IPv4 RX UDP") \
+    EVENT(LOG_EV_IPV4_RX_TCP,              "IPv4 RX TCP") \
+    EVENT(LOG_EV_TCP_PACKET_SENT,          "tcp_packet sent") \
+    EVENT(LOG_EV_TCP_OPT_BAD_SIZE,         "tcp_parseopt: bad option size length") \
+    EVENT(LOG_EV_TCP_OPT_OTHER,            "tcp_parseopt: other") \
+    EVENT(LOG_EV_TCP_OPT_BAD_LENGTH,       "tcp_parseopt: bad option length") \
+    EVENT(LOG_EV_TCP_OPT_BAD_TOTAL,        "tcp_parseopt: bad length") \
+    EVENT(LOG_EV_TCP_BAD_CHECKSUM,         "pkt dropped: bad checksum") \
+    EVENT(LOG_EV_TCP_FOUND_SYNACK,         "found syn&ack") \
+    EVENT(LOG_EV_TCP_FOUND_SYN,            "found syn") \
+    EVENT(LOG_EV_TCP_FOUND_FINACK,         "found fin&ack") \
+    EVENT(LOG_EV_TCP_FOUND_FIN,            "found fin") \
+    EVENT(LOG_EV_TCP_FOUND_RSTACK,         "found rst&ack") \
+    EVENT(LOG_EV_TCP_FOUND_RST,            "found rst") \
+    EVENT(LOG_EV_TCP_FOUND_ACK,            "found ack") \
+    EVENT(LOG_EV_TCP_CONFUSED,             "confused") \
+    EVENT(LOG_EV_TCP_BAD_OPTIONS,          "pkt dropped: bad options") \
+    EVENT(LOG_EV_TCP_LISTEN_RX_SYN,        "LISTEN: rx_syn") \
+    EVENT(LOG_EV_TCP_LISTEN_CLOSE,         "LISTEN: close") \
+    EVENT(LOG_EV_TCP_SYN_SENT_RX_SYN,      "SYN_SENT: rx_syn") \
+    EVENT(LOG_EV_TCP_SYN_SENT_RX_SYNACK,   "SYN_SENT: rx_synack") \
+    EVENT(LOG_EV_TCP_SYN_SENT_RX_ACK,      "SYN_SENT: rx_ack") \
+    EVENT(LOG_EV_TCP_SYN_SENT_CLOSE,       "SYN_SENT: close") \
+    EVENT(LOG_EV_TCP_SYN_SENT_TIMEOUT,     "SYN_SENT: timeout") \
+    EVENT(LOG_EV_TCP_SYN_RCVD_RX_SYNACK,   "SYN_RECEIVED: rx_synack") \
+    EVENT(LOG_EV_TCP_SYN_RCVD_RX_ACK,      "SYN_RECEIVED: rx_ack") \
+    EVENT(LOG_EV_TCP_SYN_RCVD_CLOSE,       "SYN_RECEIVED: close") \
+    EVENT(LOG_EV_TCP_SYN_RCVD_RX_RST,      "SYN_RECEIVED: rx_rst") \
+    EVENT(LOG_EV_TCP_RST_SEQ_OK,           "rst seq OK") \
+    EVENT(LOG_EV_TCP_SYN_RCVD_TIMEOUT,     "SYN_RECEIVED: timeout") \
+    EVENT(LOG_EV_TCP_ESTABLISHED_RX_ACK,   "ESTABLISHED: rx_ack") \
+    EVENT(LOG_EV_TCP_ESTABLISHED_CLOSE,    "ESTABLISHED: close") \
+    EVENT(LOG_EV_TCP_ESTABLISHED_RX_FIN,   "ESTABLISHED: rx_fin") \
+    EVENT(LOG_EV_TCP_ESTABLISHED_TIMEOUT,  "ESTABLISHED: timeout") \
+    EVENT(LOG_EV_TCP_FIN_WAIT_1_RX_ACK,    "FIN_WAIT_1: rx_ack") \
+    EVENT(LOG_EV_TCP_FIN_WAIT_1_RX_FINACK, "FIN_WAIT_1: rx_finack") \
+    EVENT(LOG_EV_TCP_FIN_WAIT_1_TIMEOUT,   "FIN_WAIT_1: timeout") \
+    EVENT(LOG_EV_TCP_FIN_WAIT_2_RX_FIN,    "FIN_WAIT_2: rx_fin/rx_finack") \
+    EVENT(LOG_EV_TCP_FIN_WAIT_2_TIMEOUT,   "FIN_WAIT_2: timeout") \
+    EVENT(LOG_EV_TCP_CLOSING_RX_ACK,       "CLOSING: rx_ack") \
+    EVENT(LOG_EV_TCP_LAST_ACK_RX_ACK,      "LAST_ACK: rx_ack") \
+    EVENT(LOG_EV_TCP_TIME_WAIT,            "Time Wait") \
+    EVENT(LOG_EV_TCP_CLOSED_ACTIVE_OPEN,   "CLOSED: active_open") \
+    EVENT(LOG_EV_TCP_CLOSED_PASSIVE_OPEN,  "CLOSED: passive_open") \
+    EVENT(LOG_EV_TCP_BIND,                 "tcp_bind") \
+    EVENT(LOG_EV_TCP_LISTEN,               "tcp_listen") \
+    EVENT(LOG_EV_TCP_CLOSE,                "tcp_close") \
+    EVENT(LOG_EV_TCP_TIMEOUT,              "tcp timeout") \
+    EVENT(LOG_EV_LOOP_OVER_BUDGET,         "main loop pass of %u ticks, stage %u took most")
+
+#define LOG_EVENT_ID(id, text)      id,
+#define LOG_EVENT_TEXT(id, text)    text,
+
+typedef enum
+{
+    LOG_EVENT_LIST(LOG_EVENT_ID)
+    LOG_EV_LAST                     /* keep this one at the end of the list */
+} LOG_EVENT;
+
+#endif	/* LOG_EVENTS_H */
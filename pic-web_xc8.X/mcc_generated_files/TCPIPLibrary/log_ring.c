@@ -0,0 +1,110 @@
+/**
+  Binary log ring implementation
+	
+  File Name:
+    log_ring.c
+
+  Summary:
+    Ring of binary log records, drained to UDP in idle time.
+
+  Description:
+    This file provides a log destination that only stores an event ID, the
+    priority, a time stamp and two integer arguments per message.  Nothing is
+    formatted on the device: the records are sent as they are when the
+    network is idle and sim/log-decode turns them back into text.
+
+ */
+
+/**
+ Section: Included Files
+ */
+
+#include <time.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "log_ring.h"
+#include "tcpip_types.h"
+#include "udpv4.h"
+#include "ethernet_driver.h"
+#include "ip_database.h"
+#include "tcpip_config.h"
+
+typedef struct
+{
+    uint8_t event;
+    uint8_t priVal;
+    uint16_t seconds;
+    uint16_t arg0;
+    uint16_t arg1;
+} logRecord_t;
+
+logRingStats_t logRingStats;
+
+static logRecord_t ring[LOG_RING_RECORDS];
+static uint8_t ringHead;        // next record written, free running
+static uint8_t ringTail;        // next record sent, free running
+static uint16_t ringLost;       // records lost since the last datagram
+
+void logRingInit(void)
+{
+    ringHead = 0;
+    ringTail = 0;
+    ringLost = 0;
+}
+
+void logRing(uint8_t event, uint8_t priorityVal, uint16_t arg0, uint16_t arg1)
+{
+    logRecord_t *record;
+
+    if((uint8_t)(ringHead - ringTail) >= LOG_RING_RECORDS)
+    {
+        ringLost++;
+        logRingStats.lost++;
+        return;
+    }
+    record = &ring[ringHead & (LOG_RING_RECORDS - 1u)];
+    record->event = event;
+    record->priVal = priorityVal;
+    record->seconds = (uint16_t)time(NULL);
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+    ringHead++;
+    logRingStats.records++;
+}
+
+void LOG_RingDrain(void)
+{
+    logRecord_t *record;
+    uint8_t count = (uint8_t)(ringHead - ringTail);
+
+    if((count == 0) && (ringLost == 0))
+    {
+        return;
+    }
+    if((ipdb_getAddress() == 0) || !ETH_TxReady(ETH_MTU))
+    {
+        return;
+    }
+    if(UDP_Start(0xFFFFFFFF, LOG_RING_PORT, LOG_RING_PORT) != SUCCESS)
+    {
+        return;
+    }
+
+    UDP_Write8(LOG_RING_VERSION);
+    UDP_Write8(count);
+    UDP_Write16(ringLost);
+    UDP_Write32((uint32_t)time(NULL));
+    while(ringTail != ringHead)
+    {
+        record = &ring[ringTail & (LOG_RING_RECORDS - 1u)];
+        UDP_Write8(record->event);
+        UDP_Write8(record->priVal);
+        UDP_Write16(record->seconds);
+        UDP_Write16(record->arg0);
+        UDP_Write16(record->arg1);
+        ringTail++;
+    }
+    UDP_Send();
+    ringLost = 0;
+    logRingStats.datagrams++;
+}
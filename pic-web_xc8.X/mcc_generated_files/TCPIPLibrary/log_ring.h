@@ -0,0 +1,94 @@
+/**
+  Binary log ring header file
+	
+  File Name:
+    log_ring.h
+
+  Summary:
+    Header file for log_ring.c.
+
+  Description:
+    This header file provides the API for the ring of binary log records
+    and the format of the datagrams it is drained to.
+
+ */
+
+#ifndef LOG_RING_H
+#define	LOG_RING_H
+
+#include <stdint.h>
+#include "tcpip_config.h"
+
+// Every datagram to LOG_RING_PORT starts with a header, followed by count
+// records, all fields in network byte order:
+//
+//   header  version (1), count (1), lost (2), seconds (4)
+//   record  event (1), priVal (1), seconds (2), arg0 (2), arg1 (2)
+//
+// lost is the number of records dropped since the previous datagram because
+// the ring was full.  The seconds of a record are the low 16 bits of time(),
+// the header carries the full time() of the drain.
+#define LOG_RING_VERSION        (1u)
+#define LOG_RING_HEADER_SIZE    (8u)
+#define LOG_RING_RECORD_SIZE    (8u)
+
+#if (LOG_RING_RECORDS & (LOG_RING_RECORDS - 1)) || (LOG_RING_RECORDS > 128)
+#error "LOG_RING_RECORDS must be a power of 2, at most 128"
+#endif
+
+typedef struct
+{
+    uint32_t records;               // records written to the ring
+    uint16_t lost;                  // records dropped because the ring was full
+    uint16_t datagrams;             // datagrams sent by LOG_RingDrain()
+} logRingStats_t;
+
+extern logRingStats_t logRingStats;
+
+
+/*Log Ring Initialization.
+ * The function will empty the ring.
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void logRingInit(void);
+
+
+/*Store a log record.
+ * The function will add a record to the ring, or count it as lost when the
+ * ring is full.
+ * 
+ * @param event
+ *      Event ID from log_events.h
+ * 
+ * @param priorityVal
+ *      Message priority
+ * 
+ * @param arg0, arg1
+ *      Event arguments
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void logRing(uint8_t event, uint8_t priorityVal, uint16_t arg0, uint16_t arg1);
+
+
+/*Drain the log ring.
+ * The function will send the waiting records in one broadcast datagram.
+ * Network_Manage() calls it when no received frame waits; nothing is sent
+ * before the stack has an address or while the TX buffer is full.
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void LOG_RingDrain(void);
+
+#endif	/* LOG_RING_H */
@@ -1,93 +1,290 @@
-/**
- Sending Syslog messages 
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    log_syslog.c
-
-  Summary:
-    Implementation for sending Syslog messages (RFC 5424)
-
-  Description:
-    This source file provides the implementation of the APIs for sending Syslog messages.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-/**
- Section: Included Files
- */
-
-
-#include <xc.h>
-#include <time.h>
-#include <stdio.h>
-#include <stdint.h>
-#include "log.h"
-#include "tcpip_types.h"
-#include "udpv4.h"
-#include "udpv4_port_handler_table.h"
-#include "ip_database.h"
-#include "log_syslog.h"
-
-error_msg logSyslog(const char *message, uint8_t priorityVal)
-{    
-    char storage[12];      
-    struct tm * SYSLOG_time1;   
-    time_t time1;
-    error_msg error;
-    unsigned long ip;
-    
-    ip = ipdb_getAddress();    
-    time1 = time(NULL);
-    error = UDP_Start(0xFFFFFFFF,SOURCEPORT_SYSLOG,DESTPORT_SYSLOG);
-    
-    if( SUCCESS == error)
-    {
-        SYSLOG_time1 = gmtime(&time1);
-        sprintf(storage,"<%d>%d ",priorityVal, SYSLOG_VERSION);
-        UDP_WriteString(storage);
-        sprintf(storage,"%d-%.2d-%.2d",SYSLOG_time1->tm_year, SYSLOG_time1->tm_mon, SYSLOG_time1->tm_mday);
-        UDP_WriteString(storage);
-        sprintf(storage,"T%.2d:%.2d:%.2dZ",SYSLOG_time1->tm_hour, SYSLOG_time1->tm_min, SYSLOG_time1->tm_sec);
-        UDP_WriteString(storage);
-        sprintf(storage," %d.%d.%d.%d",((char*)&ip)[3],((char*)&ip)[2],((char*)&ip)[1],((char*)&ip)[0]); //Hostnmame      
-        UDP_WriteString(storage);
-        sprintf(storage," %s", LOG_NILVALUE); //App-name
-        UDP_WriteString(storage);
-        sprintf(storage," %s", LOG_NILVALUE); //Procid
-        UDP_WriteString(storage);   
-        sprintf(storage," %s", LOG_NILVALUE); //Msgid
-        UDP_WriteString(storage);    
-        sprintf(storage," %s[", LOG_NILVALUE); //structured data
-        UDP_WriteString(storage);        
-        UDP_WriteString(message);
-        sprintf(storage,"]"); //structured data
-        UDP_WriteString(storage);    
-        UDP_Send();
-    }    
-    return error;
-}
\ No newline at end of file
+/**
+ Sending Syslog messages 
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    log_syslog.c
+
+  Summary:
+    Implementation for sending Syslog messages (RFC 5424)
+
+  Description:
+    This source file provides the implementation of the APIs for sending Syslog messages.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+/**
+ Section: Included Files
+ */
+
+
+#include <xc.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "log.h"
+#include "tcpip_types.h"
+#include "udpv4.h"
+#include "udpv4_port_handler_table.h"
+#include "ip_database.h"
+#include "log_syslog.h"
+#include "sram_heap.h"
+#include "ethernet_driver.h"
+#include "tcpip_config.h"
+
+#define SYSLOG_SUMMARY_PRI      ((LOG_SYSLOG << 3) | LOG_NOTICE)
+#define SYSLOG_SENT(error)      (((error) == SUCCESS) || ((error) == TX_QUEUED))
+
+#if !defined(SYSLOG_SINGLE_MESSAGE) && (SYSLOG_BATCH_SIZE > SRAM_LARGE_BLOCK_SIZE)
+#error "SYSLOG_BATCH_SIZE must fit in an SRAM heap block"
+#endif
+
+// the batch keeps its block, TCP_Send() must still find a large one
+#if !defined(SYSLOG_SINGLE_MESSAGE) && (SYSLOG_BATCH_SIZE > SRAM_SMALL_BLOCK_SIZE) && (SRAM_LARGE_BLOCKS < 2)
+#error "SRAM_LARGE_BLOCKS must leave a large block to TCP next to the syslog batch"
+#endif
+
+logSyslogStats_t logSyslogStats;
+
+static uint8_t tokens;          // messages that may be sent now
+static time_t tokensTime;       // time the bucket was last filled
+static uint16_t suppressed;     // messages dropped since the last summary
+
+// time stamp, host name and empty fields are the same for every message of
+// a second, they are formatted once
+static char stamp[52];
+static time_t stampTime;
+static uint32_t stampAddress;
+static bool stampValid;
+
+#ifndef SYSLOG_SINGLE_MESSAGE
+static sramBlock_t batchBlock;
+static uint16_t batchLength;
+static time_t batchTime;        // time the first message of the batch was added
+#endif
+
+static uint32_t SYSLOG_Destination(void)
+{
+    return (ipdb_getSyslog() != 0) ? ipdb_getSyslog() : 0xFFFFFFFF;
+}
+
+static void SYSLOG_Refill(time_t now)
+{
+    uint32_t refill;
+
+    if(now != tokensTime)
+    {
+        refill = (uint32_t)(now - tokensTime) * SYSLOG_RATE;
+        tokens = (refill >= (uint32_t)(SYSLOG_BURST - tokens)) ? SYSLOG_BURST : (uint8_t)(tokens + refill);
+        tokensTime = now;
+    }
+}
+
+static void SYSLOG_Stamp(time_t now)
+{
+    struct tm * SYSLOG_time1;
+    uint32_t ip = ipdb_getAddress();
+
+    if(stampValid && (now == stampTime) && (ip == stampAddress))
+    {
+        return;
+    }
+    SYSLOG_time1 = gmtime(&now);
+    sprintf(stamp, "%u-%.2u-%.2uT%.2u:%.2u:%.2uZ %u.%u.%u.%u %s %s %s %s[", (uint16_t)(SYSLOG_time1->tm_year + 1900),
+            (uint8_t)(SYSLOG_time1->tm_mon + 1), (uint8_t)SYSLOG_time1->tm_mday, (uint8_t)SYSLOG_time1->tm_hour,
+            (uint8_t)SYSLOG_time1->tm_min, (uint8_t)SYSLOG_time1->tm_sec,
+            ((uint8_t*)&ip)[3], ((uint8_t*)&ip)[2], ((uint8_t*)&ip)[1], ((uint8_t*)&ip)[0],
+            LOG_NILVALUE, LOG_NILVALUE, LOG_NILVALUE, LOG_NILVALUE);
+    stampTime = now;
+    stampAddress = ip;
+    stampValid = true;
+}
+
+static error_msg SYSLOG_SendLine(const char *pri, const char *message)
+{
+    error_msg error;
+
+    error = UDP_Start(SYSLOG_Destination(), SOURCEPORT_SYSLOG, DESTPORT_SYSLOG);
+    if(SUCCESS == error)
+    {
+        UDP_WriteString(pri);
+        UDP_WriteString(stamp);
+        UDP_WriteString(message);
+        UDP_WriteString("]");
+        error = UDP_Send();
+        logSyslogStats.datagrams++;
+    }
+    return error;
+}
+
+#ifndef SYSLOG_SINGLE_MESSAGE
+static error_msg SYSLOG_Flush(void)
+{
+    error_msg error;
+
+    if(batchLength == 0)
+    {
+        return SUCCESS;
+    }
+    error = UDP_Start(SYSLOG_Destination(), SOURCEPORT_SYSLOG, DESTPORT_SYSLOG);
+    if(SUCCESS == error)
+    {
+        UDP_WriteSramBlock(batchBlock, 0, batchLength);
+        error = UDP_Send();
+        logSyslogStats.datagrams++;
+
+        // the copy into the TX buffer is done before the block is written again
+        SRAM_Free(batchBlock);
+        batchBlock = SRAM_NO_BLOCK;
+        batchLength = 0;
+    }
+    return error;
+}
+#endif
+
+/**
+ * Send one message line, or add it to the batch.  Lines of a batch end with
+ * a newline, the collector splits the datagram there.
+ */
+static error_msg SYSLOG_Line(const char *message, uint8_t priorityVal, time_t now)
+{
+    char pri[8];
+#ifndef SYSLOG_SINGLE_MESSAGE
+    uint16_t priLength;
+    uint16_t stampLength;
+    uint16_t messageLength;
+    uint16_t length;
+#endif
+
+    sprintf(pri, "<%d>%d ", priorityVal, SYSLOG_VERSION);
+    SYSLOG_Stamp(now);
+
+#ifndef SYSLOG_SINGLE_MESSAGE
+    priLength = (uint16_t)strlen(pri);
+    stampLength = (uint16_t)strlen(stamp);
+    messageLength = (uint16_t)strlen(message);
+    length = priLength + stampLength + messageLength + 2u;
+
+    if(length <= SYSLOG_BATCH_SIZE)
+    {
+        if((batchLength + length > SYSLOG_BATCH_SIZE) && !SYSLOG_SENT(SYSLOG_Flush()))
+        {
+            return BUFFER_BUSY;
+        }
+        if(batchBlock == SRAM_NO_BLOCK)
+        {
+            batchBlock = SRAM_Alloc(SYSLOG_BATCH_SIZE);
+            batchTime = now;
+        }
+        if(batchBlock != SRAM_NO_BLOCK)
+        {
+            batchLength += SRAM_Write(batchBlock, batchLength, pri, priLength);
+            batchLength += SRAM_Write(batchBlock, batchLength, stamp, stampLength);
+            batchLength += SRAM_Write(batchBlock, batchLength, message, messageLength);
+            batchLength += SRAM_Write(batchBlock, batchLength, "]\n", 2);
+            return SUCCESS;
+        }
+    }
+    // too long for a batch or no heap block free
+#endif
+    return SYSLOG_SendLine(pri, message);
+}
+
+static void SYSLOG_Summary(time_t now)
+{
+    char summary[28];
+
+    sprintf(summary, "%u messages suppressed", suppressed);
+    if(SYSLOG_SENT(SYSLOG_Line(summary, SYSLOG_SUMMARY_PRI, now)))
+    {
+        tokens--;
+        suppressed = 0;
+    }
+}
+
+void logSyslogInit(void)
+{
+#ifndef SYSLOG_SINGLE_MESSAGE
+    batchBlock = SRAM_NO_BLOCK;     // SRAM_HeapInit() freed it
+    batchLength = 0;
+#endif
+    tokens = SYSLOG_BURST;
+    tokensTime = time(NULL);
+    suppressed = 0;
+    stampValid = false;
+}
+
+error_msg logSyslog(const char *message, uint8_t priorityVal)
+{    
+    time_t now;
+    error_msg error;
+
+    now = time(NULL);
+    SYSLOG_Refill(now);
+    if((suppressed != 0) && (tokens != 0))
+    {
+        SYSLOG_Summary(now);
+    }
+    if(tokens == 0)
+    {
+        suppressed++;
+        logSyslogStats.suppressed++;
+        return BUFFER_BUSY;
+    }
+
+    error = SYSLOG_Line(message, priorityVal, now);
+    if(SYSLOG_SENT(error))
+    {
+        tokens--;
+        logSyslogStats.messages++;
+    }
+    else
+    {
+        suppressed++;
+        logSyslogStats.suppressed++;
+    }
+    return error;
+}
+
+void LOG_SyslogUpdate(void)
+{
+    time_t now;
+
+    now = time(NULL);
+    SYSLOG_Refill(now);
+    if((suppressed != 0) && (tokens != 0))
+    {
+        SYSLOG_Summary(now);
+    }
+#ifndef SYSLOG_SINGLE_MESSAGE
+    if((batchLength != 0) && ((now - batchTime) >= SYSLOG_FLUSH_SECONDS))
+    {
+        SYSLOG_Flush();
+    }
+#endif
+}
@@ -1,66 +1,66 @@
-/**
-  MAC Address Header File
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    mac_address.h
-
-  Summary:
-    Public Interface definition for MAC Address access.
-
-  Description:
-    This files include definitions of public interface for accessing the MAC Address.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-#ifndef MAC_ADDRESS_H
-#define	MAC_ADDRESS_H
-
-#include <stdint.h>
-
-/******************************** MAC Address *********************************/
-#define MAC_ADDRESS {0x02,0x00,0x00,0x00,0x00,0x01}
-
-typedef union
-{
-    uint8_t mac_array[6];
-    struct { uint8_t byte1,byte2,byte3,byte4,byte5,byte6; } s;
-} mac48Address_t;
-
-typedef union
-{
-    uint8_t mac_array[8];
-    struct { uint8_t byte1,byte2,byte3,byte4,byte5,byte6,byte7,byte8; } s;
-} mac64Address_t;
-
-extern const mac48Address_t broadcastMAC;
-extern mac48Address_t hostMacAddress;
-
-const mac48Address_t *MAC_getAddress(void);
-
-#endif	/* MAC_ADDRESS_H */
-
+/**
+  MAC Address Header File
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    mac_address.h
+
+  Summary:
+    Public Interface definition for MAC Address access.
+
+  Description:
+    This files include definitions of public interface for accessing the MAC Address.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+#ifndef MAC_ADDRESS_H
+#define	MAC_ADDRESS_H
+
+#include <stdint.h>
+
+/******************************** MAC Address *********************************/
+#define MAC_ADDRESS {0x02,0x00,0x00,0x00,0x00,0x01}
+
+typedef union
+{
+    uint8_t mac_array[6];
+    struct { uint8_t byte1,byte2,byte3,byte4,byte5,byte6; } s;
+} mac48Address_t;
+
+typedef union
+{
+    uint8_t mac_array[8];
+    struct { uint8_t byte1,byte2,byte3,byte4,byte5,byte6,byte7,byte8; } s;
+} mac64Address_t;
+
+extern const mac48Address_t broadcastMAC;
+extern mac48Address_t hostMacAddress;
+
+const mac48Address_t *MAC_getAddress(void);
+
+#endif	/* MAC_ADDRESS_H */
+
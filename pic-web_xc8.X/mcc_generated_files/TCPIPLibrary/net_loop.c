@@ -0,0 +1,139 @@
+/**
+  Main loop monitor implementation
+	
+  File Name:
+    net_loop.c
+
+  Summary:
+    Main loop latency monitor.
+
+  Description:
+    This file times the passes of the main loop and of its stages with TMR1.
+
+ */
+
+/**
+ Section: Included Files
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "net_loop.h"
+#include "log.h"
+#include "tcpip_config.h"
+#include "../tmr1.h"
+
+netLoop_t netLoop;
+
+static tmr1Stamp_t loopMark;
+static uint16_t stageTicks[NET_LOOP_STAGES];
+#ifdef ENABLE_LOOP_BUDGET_WARNING
+static time_t warningTime;
+#endif
+
+void NET_LoopReset(void)
+{
+    memset(&netLoop, 0, sizeof(netLoop));
+    memset(stageTicks, 0, sizeof(stageTicks));
+    TMR1_ReadStamp(&loopMark);
+#ifdef ENABLE_LOOP_BUDGET_WARNING
+    warningTime = time(NULL) - 1;
+#endif
+}
+
+void NET_LoopStage(netLoopStage_t stage)
+{
+    uint16_t ticks = TMR1_ElapsedSince(&loopMark);
+
+    // the few ticks between the two readings are the monitor's own
+    TMR1_ReadStamp(&loopMark);
+    if(stageTicks[stage] > 0xFFFF - ticks)
+    {
+        ticks = 0xFFFF - stageTicks[stage];
+    }
+    stageTicks[stage] += ticks;
+}
+
+void NET_LoopEnd(void)
+{
+    netLoopStageStats_t *s;
+    uint16_t ticks = 0;
+    uint16_t v;
+    uint8_t bucket = 0;
+    uint8_t worst = 0;
+    uint8_t i;
+
+    for(i = 0; i < NET_LOOP_STAGES; i++)
+    {
+        v = stageTicks[i];
+        s = &netLoop.stages[i];
+        s->ticks += v;
+        if(v > s->peak)
+        {
+            s->peak = v;
+        }
+        if(v > stageTicks[worst])
+        {
+            worst = i;
+        }
+        ticks = (ticks > 0xFFFF - v) ? 0xFFFF : ticks + v;
+        stageTicks[i] = 0;
+    }
+
+    v = ticks;
+    while(v && (bucket < NET_LOOP_BUCKETS - 1u))
+    {
+        v >>= 1;
+        bucket++;
+    }
+    if(netLoop.buckets[bucket] != 0xFFFF)
+    {
+        netLoop.buckets[bucket]++;
+    }
+    if(ticks > netLoop.peak)
+    {
+        netLoop.peak = ticks;
+        netLoop.peakStage = worst;
+    }
+    netLoop.passes++;
+
+    if(ticks > NET_LOOP_TICK_BUDGET)
+    {
+        netLoop.overBudget++;
+        netLoop.stages[worst].overBudget++;
+#ifdef ENABLE_LOOP_BUDGET_WARNING
+        if(time(NULL) != warningTime)
+        {
+            warningTime = time(NULL);
+            LOG_Event(LOG_EV_LOOP_OVER_BUDGET, LOG_KERN, LOG_WARNING, ticks, worst);
+        }
+#endif
+    }
+}
+
+uint16_t NET_LoopPercentile(uint8_t percent)
+{
+    uint32_t total = 0;
+    uint32_t count = 0;
+    uint8_t bucket;
+
+    for(bucket = 0; bucket < NET_LOOP_BUCKETS; bucket++)
+    {
+        total += netLoop.buckets[bucket];
+    }
+    total = (total * percent + 99u) / 100u;
+    if(total == 0)
+    {
+        return 0;
+    }
+    for(bucket = 0; bucket < NET_LOOP_BUCKETS - 1u; bucket++)
+    {
+        count += netLoop.buckets[bucket];
+        if(count >= total)
+        {
+            return (uint16_t)((1ul << bucket) - 1u);
+        }
+    }
+    return 0xFFFF;
+}
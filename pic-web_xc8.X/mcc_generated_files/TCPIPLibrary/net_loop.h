@@ -0,0 +1,114 @@
+/**
+  Main loop monitor header file
+	
+  File Name:
+    net_loop.h
+
+  Summary:
+    Header file for net_loop.c.
+
+  Description:
+    This header file provides the monitor that times the passes of the main
+    loop with TMR1 and tells which stage, the network or the application,
+    made the slow ones.
+
+ */
+
+#ifndef NET_LOOP_H
+#define	NET_LOOP_H
+
+#include <stdint.h>
+#include "tcpip_config.h"
+
+// The main loop marks the end of each stage and of the pass:
+//
+//     Network_Manage();
+//     NET_LoopStage(NET_LOOP_NETWORK);
+//     DEMO_TCP_EchoServer();
+//     NET_LoopStage(NET_LOOP_APP);
+//     NET_LoopEnd();
+//
+// A stage is charged the time since the previous mark.  Times are TMR1
+// ticks (8 Tcy); bucket 0 counts the passes under one tick, bucket n the
+// ones from 2^(n-1) to 2^n - 1 ticks and the last bucket everything longer.
+// Stages and passes of 0xFFFF ticks (~52 ms) or more count as 0xFFFF.
+typedef enum
+{
+    NET_LOOP_NETWORK,               // Network_Manage()
+    NET_LOOP_APP,                   // the application tasks
+    NET_LOOP_STAGES
+} netLoopStage_t;
+
+typedef struct
+{
+    uint32_t ticks;                 // summed
+    uint16_t peak;
+    uint16_t overBudget;            // passes over NET_LOOP_TICK_BUDGET this stage took the most of
+} netLoopStageStats_t;
+
+typedef struct
+{
+    uint32_t passes;
+    uint16_t peak;                  // longest pass
+    uint8_t peakStage;              // stage that took the most of it
+    uint16_t overBudget;            // passes over NET_LOOP_TICK_BUDGET
+    uint16_t buckets[NET_LOOP_BUCKETS];     // stop at 0xFFFF
+    netLoopStageStats_t stages[NET_LOOP_STAGES];
+} netLoop_t;
+
+extern netLoop_t netLoop;
+
+
+/*Main Loop Monitor Reset.
+ * The function will clear the statistics and start timing the next stage.
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_LoopReset(void);
+
+
+/*End of a stage.
+ * The function will charge the time since the previous mark to the stage.
+ * 
+ * @param stage
+ *      Stage that just ended
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_LoopStage(netLoopStage_t stage);
+
+
+/*End of a pass.
+ * The function will count the pass of the main loop in the histogram.  With
+ * ENABLE_LOOP_BUDGET_WARNING a pass over NET_LOOP_TICK_BUDGET logs
+ * LOG_EV_LOOP_OVER_BUDGET, at most once a second.
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_LoopEnd(void);
+
+
+/*Pass time percentile.
+ * The function will look up the histogram bucket that holds the percentile.
+ * 
+ * @param percent
+ *      Percentile, 1 to 100
+ * 
+ * @param return
+ *      Most ticks of the bucket, 0xFFFF for the last one and 0 before
+ *      the first pass
+ * 
+ */
+uint16_t NET_LoopPercentile(uint8_t percent);
+
+#endif	/* NET_LOOP_H */
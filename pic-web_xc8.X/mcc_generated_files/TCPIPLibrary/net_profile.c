@@ -0,0 +1,58 @@
+/**
+  Network profiling implementation
+	
+  File Name:
+    net_profile.c
+
+  Summary:
+    Histograms of the time spent in the network hot path.
+
+  Description:
+    This file provides the log2 histograms the NET_PROFILE_START() and
+    NET_PROFILE_STOP() probes fill.  They are read with the statistics query
+    of net_stats.h.
+
+ */
+
+/**
+ Section: Included Files
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "net_profile.h"
+#include "tcpip_config.h"
+
+#ifdef ENABLE_NETWORK_PROFILE
+
+netProfile_t netProfile[NET_PROFILE_PROBES];
+
+void NET_ProfileReset(void)
+{
+    memset(netProfile, 0, sizeof(netProfile));
+}
+
+void NET_ProfileAdd(netProfileProbe_t probe, uint16_t ticks)
+{
+    netProfile_t *p = &netProfile[probe];
+    uint16_t v = ticks;
+    uint8_t bucket = 0;
+
+    while(v && (bucket < NET_PROFILE_BUCKETS - 1u))
+    {
+        v >>= 1;
+        bucket++;
+    }
+    if(p->buckets[bucket] != 0xFFFF)
+    {
+        p->buckets[bucket]++;
+    }
+    if(ticks > p->peak)
+    {
+        p->peak = ticks;
+    }
+    p->ticks += ticks;
+    p->count++;
+}
+
+#endif
@@ -0,0 +1,90 @@
+/**
+  Network profiling header file
+	
+  File Name:
+    net_profile.h
+
+  Summary:
+    Header file for net_profile.c.
+
+  Description:
+    This header file provides the probes that time the network hot path
+    with TMR1 and the histograms they fill.  Without ENABLE_NETWORK_PROFILE
+    in tcpip_config.h the probes compile to nothing.
+
+ */
+
+#ifndef NET_PROFILE_H
+#define	NET_PROFILE_H
+
+#include <stdint.h>
+#include "tcpip_config.h"
+#include "../tmr1.h"
+
+typedef enum
+{
+    NET_PROFILE_ETH_EVENTS,         // ETH_EventHandler()
+    NET_PROFILE_NETWORK_READ,       // Network_Read() of one frame
+    NET_PROFILE_IPV4_PACKET,        // IPV4_Packet()
+    NET_PROFILE_TCP_RECV,           // TCP_Recv()
+    NET_PROFILE_TCP_FSM,            // TCP_FiniteStateMachine()
+    NET_PROFILE_TCP_SND,            // TCP_Snd()
+    NET_PROFILE_CHECKSUM,           // block sums by the DMA or in software
+    NET_PROFILE_PROBES
+} netProfileProbe_t;
+
+// The probes nest, the time of a probe includes the probes it calls.  Times
+// are TMR1 ticks (8 Tcy); bucket 0 counts the calls under one tick, bucket n
+// the ones from 2^(n-1) to 2^n - 1 ticks and the last bucket everything
+// longer.  The bucket counts stop at 0xFFFF.
+typedef struct
+{
+    uint32_t count;
+    uint32_t ticks;                 // summed
+    uint16_t peak;
+    uint16_t buckets[NET_PROFILE_BUCKETS];
+} netProfile_t;
+
+#ifdef ENABLE_NETWORK_PROFILE
+
+extern netProfile_t netProfile[NET_PROFILE_PROBES];
+
+#define NET_PROFILE_START(start)            uint16_t start = TMR1_ReadTimer()
+#define NET_PROFILE_STOP(probe, start)      NET_ProfileAdd(probe, TMR1_ElapsedTicks(start))
+
+
+/*Network Profile Reset.
+ * The function will clear the histograms.
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_ProfileReset(void);
+
+
+/*Add a timing.
+ * The function will count one pass of a probe in its histogram.
+ * 
+ * @param probe
+ *      Probe that was timed
+ * 
+ * @param ticks
+ *      TMR1 ticks the pass took
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_ProfileAdd(netProfileProbe_t probe, uint16_t ticks);
+
+#else
+
+#define NET_PROFILE_START(start)
+#define NET_PROFILE_STOP(probe, start)
+
+#endif
+
+#endif	/* NET_PROFILE_H */
@@ -0,0 +1,202 @@
+/**
+  Network statistics implementation
+	
+  File Name:
+    net_stats.c
+
+  Summary:
+    Per layer counters of the stack and their UDP query.
+
+  Description:
+    This file provides the counters the layers update as frames go in and
+    out, and answers the binary requests that read them, and optionally
+    clear them, over UDP.
+
+ */
+
+/**
+ Section: Included Files
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "net_stats.h"
+#include "net_profile.h"
+#include "net_loop.h"
+#include "tcpip_types.h"
+#include "udpv4.h"
+#include "ethernet_driver.h"
+#include "tcpip_config.h"
+
+netStats_t netStats;
+
+extern socklistsize_t tcbListSize;
+
+void NET_StatsReset(void)
+{
+    uint8_t i;
+
+    memset(&netStats, 0, sizeof(netStats));
+    ethRxStats.overflows = 0;
+    for(i = 0; i < ETH_TX_CLASSES; i++)
+    {
+        ethTxStats.classes[i].queuedPeak = ethTxStats.classes[i].queued;
+    }
+}
+
+void NET_StatsDrop(error_msg code)
+{
+    if((code != SUCCESS) && (code != TX_QUEUED) && ((uint8_t)code < NET_STATS_ERRORS))
+    {
+        netStats.drops[code]++;
+    }
+}
+
+void NET_StatsSent(netStatsType_t type, error_msg code)
+{
+    if((code == SUCCESS) || (code == TX_QUEUED))
+    {
+        netStats.txFrames[type]++;
+    }
+}
+
+static void NET_StatsWriteCounters(uint8_t flags)
+{
+    uint8_t i;
+
+    UDP_Write8(NET_STATS_VERSION);
+    UDP_Write8(NET_STATS_TYPES);
+    UDP_Write8(NET_STATS_ERRORS);
+    UDP_Write8(flags);
+    UDP_Write16((uint16_t)tcbListSize);
+    UDP_Write16(ethRxStats.overflows);
+    UDP_Write8(ethTxStats.classes[ETH_TX_BULK].queuedPeak);
+    UDP_Write8(ethTxStats.classes[ETH_TX_CONTROL].queuedPeak);
+    UDP_Write16(netStats.arpMisses);
+    UDP_Write16(netStats.tcpRetransmits);
+    for(i = 0; i < NET_STATS_TYPES; i++)
+    {
+        UDP_Write32(netStats.rxFrames[i]);
+    }
+    for(i = 0; i < NET_STATS_TYPES; i++)
+    {
+        UDP_Write32(netStats.txFrames[i]);
+    }
+    for(i = 0; i < NET_STATS_ERRORS; i++)
+    {
+        UDP_Write16(netStats.drops[i]);
+    }
+}
+
+static void NET_StatsWriteLoop(uint8_t flags)
+{
+    netLoopStageStats_t *s;
+    uint8_t i;
+
+    UDP_Write8(NET_STATS_VERSION);
+    UDP_Write8(NET_LOOP_STAGES);
+    UDP_Write8(NET_LOOP_BUCKETS);
+    UDP_Write8(flags);
+    UDP_Write32(netLoop.passes);
+    UDP_Write16(NET_LOOP_TICK_BUDGET);
+    UDP_Write16(netLoop.overBudget);
+    UDP_Write16(netLoop.peak);
+    UDP_Write8(netLoop.peakStage);
+    for(s = netLoop.stages; s < netLoop.stages + NET_LOOP_STAGES; s++)
+    {
+        UDP_Write32(s->ticks);
+        UDP_Write16(s->peak);
+        UDP_Write16(s->overBudget);
+    }
+    for(i = 0; i < NET_LOOP_BUCKETS; i++)
+    {
+        UDP_Write16(netLoop.buckets[i]);
+    }
+}
+
+#ifdef ENABLE_NETWORK_PROFILE
+static void NET_StatsWriteProfile(uint8_t flags)
+{
+    netProfile_t *p;
+    uint8_t i;
+
+    UDP_Write8(NET_STATS_VERSION);
+    UDP_Write8(NET_PROFILE_PROBES);
+    UDP_Write8(NET_PROFILE_BUCKETS);
+    UDP_Write8(flags);
+    for(p = netProfile; p < netProfile + NET_PROFILE_PROBES; p++)
+    {
+        UDP_Write32(p->count);
+        UDP_Write32(p->ticks);
+        UDP_Write16(p->peak);
+        for(i = 0; i < NET_PROFILE_BUCKETS; i++)
+        {
+            UDP_Write16(p->buckets[i]);
+        }
+    }
+}
+#endif
+
+void NET_StatsReceive(int16_t length)
+{
+    uint8_t command = NET_STATS_SNAPSHOT;
+    uint8_t flags;
+    error_msg ret;
+
+    if(length > 0)
+    {
+        command = UDP_Read8();
+    }
+    flags = command & NET_STATS_FLAG_RESET;
+    if(command & NET_STATS_LOOP)
+    {
+        flags |= NET_STATS_FLAG_LOOP;
+    }
+#ifdef ENABLE_NETWORK_PROFILE
+    else
+    {
+        flags |= command & NET_STATS_FLAG_PROFILE;
+    }
+#endif
+
+    // the requester is in the ARP table, it just sent us a datagram
+    if(UDP_Start(UDP_GetDestIP(), NET_STATS_PORT, UDP_GetDestPort()) != SUCCESS)
+    {
+        return;
+    }
+    netStats.queries++;
+
+    if(flags & NET_STATS_FLAG_LOOP)
+    {
+        NET_StatsWriteLoop(flags);
+    }
+#ifdef ENABLE_NETWORK_PROFILE
+    else if(flags & NET_STATS_FLAG_PROFILE)
+    {
+        NET_StatsWriteProfile(flags);
+    }
+#endif
+    else
+    {
+        NET_StatsWriteCounters(flags);
+    }
+    ret = UDP_Send();
+
+    // keep the counters when the reply could not be sent
+    if((flags & NET_STATS_FLAG_RESET) && ((ret == SUCCESS) || (ret == TX_QUEUED)))
+    {
+        if(flags & NET_STATS_FLAG_LOOP)
+        {
+            NET_LoopReset();
+            return;
+        }
+#ifdef ENABLE_NETWORK_PROFILE
+        if(flags & NET_STATS_FLAG_PROFILE)
+        {
+            NET_ProfileReset();
+            return;
+        }
+#endif
+        NET_StatsReset();
+    }
+}
@@ -0,0 +1,144 @@
+/**
+  Network statistics header file
+	
+  File Name:
+    net_stats.h
+
+  Summary:
+    Header file for net_stats.c.
+
+  Description:
+    This header file provides the per layer counters of the stack and the
+    format of the UDP query that reads them.
+
+ */
+
+#ifndef NET_STATS_H
+#define	NET_STATS_H
+
+#include <stdint.h>
+#include "tcpip_types.h"
+#include "tcpip_config.h"
+
+// A datagram to NET_STATS_PORT holding one command byte is answered from
+// the same port with the counters, all fields in network byte order:
+//
+//   header  version (1), types (1), errors (1), flags (1)
+//           active TCBs (2), RX overflows (2),
+//           TX queue peak bulk (1), TX queue peak control (1),
+//           ARP misses (2), TCP retransmits (2)
+//   then    types x frames in (4), types x frames out (4),
+//           errors x drops (2)
+//
+// The frame counters follow netStatsType_t, the drops are indexed by the
+// error_msg code.  NET_STATS_RESET clears the counters and the RX overflow
+// and TX queue peaks once the reply is queued; flags bit 0 tells they were.
+//
+// With NET_STATS_PROFILE in the command, and ENABLE_NETWORK_PROFILE
+// defined, the reply holds the histograms of net_profile.h instead:
+//
+//   header  version (1), probes (1), buckets (1), flags (1)
+//   then    probes x (count (4), ticks (4), peak (2), buckets x count (2))
+//
+// flags bit 1 tells which reply it is, NET_STATS_RESET then clears the
+// histograms only.
+//
+// With NET_STATS_LOOP in the command the reply holds the main loop monitor
+// of net_loop.h, ahead of the profile:
+//
+//   header  version (1), stages (1), buckets (1), flags (1)
+//           passes (4), budget (2), passes over budget (2),
+//           peak (2), peak stage (1)
+//   then    stages x (ticks (4), peak (2), passes over budget (2)),
+//           buckets x count (2)
+//
+// flags bit 2 tells it is, NET_STATS_RESET then clears the monitor only.
+#define NET_STATS_VERSION       (1u)
+#define NET_STATS_SNAPSHOT      (0x00u)
+#define NET_STATS_RESET         (0x01u)
+#define NET_STATS_PROFILE       (0x02u)
+#define NET_STATS_LOOP          (0x04u)
+#define NET_STATS_FLAG_RESET    (0x01u)
+#define NET_STATS_FLAG_PROFILE  (0x02u)
+#define NET_STATS_FLAG_LOOP     (0x04u)
+#define NET_STATS_ERRORS        ((uint8_t)ARP_WRONG_PROTOCOL_LEN + 1u)     // error_msg codes
+
+typedef enum
+{
+    NET_STATS_ARP,
+    NET_STATS_IPV4,
+    NET_STATS_IPV6,
+    NET_STATS_VLAN,
+    NET_STATS_OTHER,                // other ethertypes and 802.3 length fields
+    NET_STATS_TYPES
+} netStatsType_t;
+
+typedef struct
+{
+    uint32_t rxFrames[NET_STATS_TYPES];     // frames read, by ethertype
+    uint32_t txFrames[NET_STATS_TYPES];     // frames sent or queued, by ethertype
+    uint16_t drops[NET_STATS_ERRORS];       // received frames dropped, by the error_msg code
+    uint16_t arpMisses;                     // IPv4 packets not started for an unknown MAC address
+    uint16_t tcpRetransmits;                // TCP segments sent again after a timeout
+    uint16_t queries;                       // requests answered on NET_STATS_PORT
+} netStats_t;
+
+extern netStats_t netStats;
+
+
+/*Network Statistics Reset.
+ * The function will clear the counters and the RX overflow and TX queue
+ * peaks of the Ethernet driver.
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_StatsReset(void);
+
+
+/*Count a dropped frame.
+ * The function will count a received frame that was not used.  SUCCESS and
+ * TX_QUEUED are not drops and are ignored.
+ * 
+ * @param code
+ *      Error returned by the layer that dropped the frame
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_StatsDrop(error_msg code);
+
+
+/*Count a sent frame.
+ * The function will count the frame if ETH_Send() sent or queued it.
+ * 
+ * @param type
+ *      Ethertype of the frame
+ * 
+ * @param code
+ *      Value returned by ETH_Send()
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_StatsSent(netStatsType_t type, error_msg code);
+
+
+/*Answer a statistics query.
+ * UDP_CallBackTable dispatches the datagrams to NET_STATS_PORT to it.
+ * 
+ * @param length
+ *      Bytes of the UDP payload
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void NET_StatsReceive(int16_t length);
+
+#endif	/* NET_STATS_H */
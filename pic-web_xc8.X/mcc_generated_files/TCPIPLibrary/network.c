@@ -1,174 +1,319 @@
-/**
-  Network layer implementation
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    network.c
-
-  Summary:
-    Network layer handling.
-
-  Description:
-    This file provides the network layer implementation for TCP/IP stack.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-/**
- Section: Included Files
- */
-
-#include <stdio.h>
-#include <stdbool.h>
-#include <string.h>
-#include <time.h>
-#include "network.h"
-#include "tcpip_types.h"
-#include "arpv4.h"
-#include "ipv4.h"
-#include "tcpv4.h"
-#include "rtcc.h"
-#include "ethernet_driver.h"
-#include "log.h"
-#include "ip_database.h"
-#ifdef ENABLE_NETWORK_DEBUG
-#define logMsg(msg, msgSeverity, msgLogDest)    logMessage(msg, LOG_KERN, msgSeverity, msgLogDest) 
-#else
-#define logMsg(msg, msgSeverity, msgLogDest)
-#endif
-
-time_t arpTimer;
-static void Network_SaveStartPosition(void);
-uint16_t networkStartPosition;
-
-const char *network_errors[] = { "ERROR","SUCCESS","LINK_NOT_FOUND","BUFFER_BUSY",
-                             "TX_LOGIC_NOT_IDLE","MAC_NOT_FOUND",
-                             "IP_WRONG_VERSION","IPV4_CHECKSUM_FAILS",
-                             "DEST_IP_NOT_MATCHED","ICMP_CHECKSUM_FAILS",
-                             "UDP_CHECKSUM_FAILS","TCP_CHECKSUM_FAILS",
-                             "DMA_TIMEOUT","PORT_NOT_AVAILABLE",
-                             "ARP_IP_NOT_MATCHED","EAPol_PACKET_FAILURE"};
-
-void Network_Init(void)
-{
-    ETH_Init();
-    ARPV4_Init();
-    IPV4_Init();
-    TCP_Init();
-    rtcc_init();
-    Network_WaitForLink();  
-    timersInit();
-    LOG_Init();
-}
-
-void timersInit()
-{
-    time(&arpTimer);
-    arpTimer += 10;  
-}
-
-void Network_WaitForLink(void)
-{
-    while(!ETH_CheckLinkUp()) asm("nop");
-}
-
-void Network_Manage(void)
-{
-    time_t now;
-    static time_t nowPv = 0;
-
-    ETH_EventHandler();
-    Network_Read(); // handle any packets that have arrived...
-
-    // manage any outstanding timeouts
-    time(&now);
-    if(now >= arpTimer)
-    {
-        ARPV4_Update();
-        arpTimer = now + 10;
-    }    
-    if(now > nowPv) // at least 1 second has elapsed
-    {
-        // is defined as a minimum of 1 seconds in RFC973
-        TCP_Update();  // handle timeouts
-    }
-    nowPv = now;
-}
-
-void Network_Read(void)
-{
-    ethernetFrame_t header;
-    char debug_str[80];
-
-    if(ETH_packetReady())
-    {
-        ETH_NextPacketUpdate();
-        ETH_ReadBlock((char *)&header, sizeof(header));
-        header.id.type = ntohs(header.id.type); // reverse the type field
-        Network_SaveStartPosition();
-        switch (header.id.type)
-        {
-            case ETHERTYPE_VLAN:
-                logMsg("VLAN Packet Dropped", LOG_INFO, (LOG_DEST_CONSOLE|LOG_DEST_ETHERNET));
-                break;
-            case ETHERTYPE_ARP:
-                logMsg("RX ARPV4 Packet", LOG_INFO, (LOG_DEST_CONSOLE|LOG_DEST_ETHERNET));
-                ARPV4_Packet();
-                break;
-            case ETHERTYPE_IPV4:
-                logMsg("RX IPV4 Packet", LOG_INFO, (LOG_DEST_CONSOLE|LOG_DEST_ETHERNET));
-                IPV4_Packet();
-                break;
-            case ETHERTYPE_IPV6:
-                logMsg("RX IPV6 Packet Dropped", LOG_INFO, (LOG_DEST_CONSOLE|LOG_DEST_ETHERNET));
-                break;
-            default:
-                {
-                    long t = header.id.type;
-                    if(t < 0x05dc) // this is a length field
-                    {
-                        sprintf(debug_str,"802.3 length 0x%04lX",t);                    
-                    }
-                    else
-                        sprintf(debug_str,"802.3 type 0x%04lX",t);
-
-                    logMsg(debug_str, LOG_INFO, (LOG_DEST_CONSOLE|LOG_DEST_ETHERNET));
-                }
-                break;
-        }        
-        ETH_Flush();
-    }
-}
-
-static void Network_SaveStartPosition(void)
-{
-    networkStartPosition = ETH_GetReadPtr();
-}
-
-uint16_t Network_GetStartPosition(void)
-{    
-    return networkStartPosition;
+/**
+  Network layer implementation
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    network.c
+
+  Summary:
+    Network layer handling.
+
+  Description:
+    This file provides the network layer implementation for TCP/IP stack.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+/**
+ Section: Included Files
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "network.h"
+#include "tcpip_types.h"
+#include "arpv4.h"
+#include "ipv4.h"
+#include "tcpv4.h"
+#include "rtcc.h"
+#include "ethernet_driver.h"
+#include "sram_heap.h"
+#include "log.h"
+#include "log_ring.h"
+#include "log_syslog.h"
+#include "net_stats.h"
+#include "net_profile.h"
+#include "net_loop.h"
+#include "ip_database.h"
+#include "udpv4_port_handler_table.h"
+#include "tcpip_config.h"
+#include "../tmr1.h"
+#ifdef ENABLE_NETWORK_DEBUG
+#define logMsg(event, msgSeverity)                  LOG_Event(event, LOG_KERN, msgSeverity, 0, 0)
+#define logMsgArgs(event, msgSeverity, arg0, arg1)  LOG_Event(event, LOG_KERN, msgSeverity, arg0, arg1)
+#else
+#define logMsg(event, msgSeverity)
+#define logMsgArgs(event, msgSeverity, arg0, arg1)
+#endif
+
+time_t arpTimer;
+static uint8_t tcpPeriods;
+static void Network_SaveStartPosition(void);
+static void Network_UpdateRxFilter(void);
+uint16_t networkStartPosition;
+static bool rxFilterSet;
+static ethRxFilter_t rxFilter;
+static uint32_t rxFilterAddress;
+networkRxStats_t networkRxStats;
+
+const char *network_errors[] = { "ERROR","SUCCESS","LINK_NOT_FOUND","BUFFER_BUSY",
+                             "TX_LOGIC_NOT_IDLE","MAC_NOT_FOUND",
+                             "IP_WRONG_VERSION","IPV4_CHECKSUM_FAILS",
+                             "DEST_IP_NOT_MATCHED","ICMP_CHECKSUM_FAILS",
+                             "UDP_CHECKSUM_FAILS","TCP_CHECKSUM_FAILS",
+                             "DMA_TIMEOUT","PORT_NOT_AVAILABLE",
+                             "ARP_IP_NOT_MATCHED","EAPol_PACKET_FAILURE"};
+
+void Network_Init(void)
+{
+    ETH_Init();
+    SRAM_HeapInit();
+    rxFilterSet = false;
+    ARPV4_Init();
+    IPV4_Init();
+    TCP_Init();
+    rtcc_init();
+    Network_WaitForLink();  
+    timersInit();
+    LOG_Init();
+    NET_StatsReset();
+    NET_LoopReset();
+}
+
+void timersInit()
+{
+    time(&arpTimer);
+    arpTimer += 10;  
+    tcpPeriods = timer1Periods;
+}
+
+void Network_WaitForLink(void)
+{
+    while(!ETH_CheckLinkUp()) asm("nop");
+}
+
+void Network_Manage(void)
+{
+    time_t now;
+    NET_PROFILE_START(start);
+
+    ETH_EventHandler();
+    NET_PROFILE_STOP(NET_PROFILE_ETH_EVENTS, start);
+    Network_UpdateRxFilter();
+#ifdef NETWORK_SINGLE_READ
+    Network_Read(); // handle the next packet that has arrived...
+#else
+    Network_ReadBatch(); // handle the packets that have arrived...
+#endif
+    TCP_SendPending(); // and send what did not fit in the TX buffer
+    if(!ETH_packetReady())
+    {
+        LOG_RingDrain(); // send the log records while nothing waits
+        LOG_SyslogUpdate();
+    }
+
+    // manage any outstanding timeouts
+    time(&now);
+    if(now >= arpTimer)
+    {
+        ARPV4_Update();
+        arpTimer = now + 10;
+    }    
+    if(tcpPeriods != timer1Periods) // a TMR1 period has elapsed
+    {
+        // the retransmission time-outs follow the round trip, RFC 6298;
+        // periods missed by a slow loop are skipped, not caught up
+        tcpPeriods = timer1Periods;
+        TCP_Update();  // handle timeouts
+    }
+}
+
+void Network_Read(void)
+{
+    ethernetFrame_t header;
+    NET_PROFILE_START(start);
+
+    if(ETH_packetReady())
+    {
+        ETH_NextPacketUpdate();
+        ETH_ReadBlock((char *)&header, sizeof(header));
+        header.id.type = ntohs(header.id.type); // reverse the type field
+        Network_SaveStartPosition();
+        switch (header.id.type)
+        {
+            case ETHERTYPE_VLAN:
+                logMsg(LOG_EV_NET_VLAN_DROPPED, LOG_INFO);
+                netStats.rxFrames[NET_STATS_VLAN]++;
+                break;
+            case ETHERTYPE_ARP:
+                logMsg(LOG_EV_NET_RX_ARP, LOG_INFO);
+                netStats.rxFrames[NET_STATS_ARP]++;
+                NET_StatsDrop(ARPV4_Packet());
+                break;
+            case ETHERTYPE_IPV4:
+                {
+                    error_msg ret;
+                    NET_PROFILE_START(ipv4Start);
+
+                    logMsg(LOG_EV_NET_RX_IPV4, LOG_INFO);
+                    netStats.rxFrames[NET_STATS_IPV4]++;
+                    ret = IPV4_Packet();
+                    NET_PROFILE_STOP(NET_PROFILE_IPV4_PACKET, ipv4Start);
+                    NET_StatsDrop(ret);
+                }
+                break;
+            case ETHERTYPE_IPV6:
+                logMsg(LOG_EV_NET_IPV6_DROPPED, LOG_INFO);
+                netStats.rxFrames[NET_STATS_IPV6]++;
+                break;
+            default:
+                netStats.rxFrames[NET_STATS_OTHER]++;
+                if(header.id.type < 0x05dc) // this is a length field
+                {
+                    logMsgArgs(LOG_EV_NET_8023_LENGTH, LOG_INFO, header.id.type, 0);
+                }
+                else
+                {
+                    logMsgArgs(LOG_EV_NET_8023_TYPE, LOG_INFO, header.id.type, 0);
+                }
+                break;
+        }        
+        ETH_Flush();
+        NET_PROFILE_STOP(NET_PROFILE_NETWORK_READ, start);
+    }
+}
+
+void Network_ReadBatch(void)
+{
+    uint16_t start;
+    uint16_t length;
+    uint8_t control = 0;
+    uint8_t bulk = 0;
+    uint8_t frames;
+
+    start = TMR1_ReadTimer();
+    while(ETH_packetReady())
+    {
+        // leave the frame for a later call if its reply could not be queued,
+        // the transmitter frees the buffer within a frame time; the reply to
+        // a control frame is small enough for the control area
+        length = ETH_NextPacketLength();
+        if(!ETH_TxReady((length <= NETWORK_CONTROL_FRAME_LENGTH) ? ETH_TX_CONTROL_LENGTH : ETH_MTU))
+        {
+            networkRxStats.txBusyHits++;
+            break;
+        }
+
+        // frames are handled in order, stop at the first one over its budget
+        if(length <= NETWORK_CONTROL_FRAME_LENGTH)
+        {
+            if(control >= NETWORK_RX_CONTROL_BUDGET)
+            {
+                networkRxStats.controlBudgetHits++;
+                break;
+            }
+            control++;
+        }
+        else
+        {
+            if(bulk >= NETWORK_RX_BULK_BUDGET)
+            {
+                networkRxStats.bulkBudgetHits++;
+                break;
+            }
+            bulk++;
+        }
+
+        Network_Read();
+
+        if(TMR1_ElapsedTicks(start) >= NETWORK_RX_TICK_BUDGET)
+        {
+            if(ETH_packetReady())
+            {
+                networkRxStats.tickBudgetHits++;
+            }
+            break;
+        }
+    }
+
+    frames = control + bulk;
+    if(frames)
+    {
+        networkRxStats.lastBatch = frames;
+        if(frames > networkRxStats.batchPeak)
+        {
+            networkRxStats.batchPeak = frames;
+        }
+        networkRxStats.frames += frames;
+        networkRxStats.batches++;
+    }
+}
+
+/**
+ * Let the MAC drop the broadcast frames nothing in the stack would use.
+ * Without an address yet or with a UDP port that takes broadcasts in
+ * UDP_CallBackTable all broadcasts are taken, TCP is unicast only.
+ * Otherwise only ARP requests for our address pass, or any ARP while a
+ * request of our own waits for the reply.
+ */
+static void Network_UpdateRxFilter(void)
+{
+    ethRxFilter_t filter;
+    uint32_t address = ipdb_getAddress();
+
+    if((address == 0) || udp_table_takesBroadcasts())
+    {
+        filter = ETH_RX_BROADCAST;
+    }
+    else if(ARPV4_RequestPending())
+    {
+        filter = ETH_RX_ARP;
+    }
+    else
+    {
+        filter = ETH_RX_ARP_FOR;
+    }
+
+    if(!rxFilterSet || (filter != rxFilter) || (address != rxFilterAddress))
+    {
+        ETH_SetRxFilter(filter, address);
+        rxFilter = filter;
+        rxFilterAddress = address;
+        rxFilterSet = true;
+    }
+}
+
+static void Network_SaveStartPosition(void)
+{
+    networkStartPosition = ETH_GetReadPtr();
+}
+
+uint16_t Network_GetStartPosition(void)
+{    
+    return networkStartPosition;
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+  Ethernet SRAM heap implementation
+	
+  File Name:
+    sram_heap.c
+
+  Summary:
+    Blocks of Ethernet SRAM for stack and application buffers.
+
+  Description:
+    This file provides fixed size block pools in the Ethernet SRAM that the
+    RX and TX buffers leave free.  The data moves through EDATA or the DMA
+    engine, so buffers that are only written once and sent later cost no
+    PIC RAM.
+
+ */
+
+/**
+ Section: Included Files
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "sram_heap.h"
+#include "ethernet_driver.h"
+#include "tcpip_config.h"
+
+sramHeapStats_t sramHeapStats;
+
+static const uint16_t poolBlockSize[SRAM_POOLS] = {SRAM_SMALL_BLOCK_SIZE, SRAM_LARGE_BLOCK_SIZE};
+static const uint8_t poolBlocks[SRAM_POOLS] = {SRAM_SMALL_BLOCKS, SRAM_LARGE_BLOCKS};
+static uint16_t poolStart[SRAM_POOLS];
+static uint8_t poolUsed[SRAM_POOLS];       // bit n is set while block n is allocated
+
+static uint8_t SRAM_PoolOf(sramBlock_t block);
+static uint16_t SRAM_Clip(sramBlock_t block, uint16_t offset, uint16_t length);
+
+void SRAM_HeapInit(void)
+{
+    poolStart[0] = ETH_GetHeapStart();
+    poolStart[1] = poolStart[0] + (SRAM_SMALL_BLOCK_SIZE * SRAM_SMALL_BLOCKS);
+    memset(poolUsed, 0, sizeof(poolUsed));
+    memset(&sramHeapStats, 0, sizeof(sramHeapStats));
+}
+
+sramBlock_t SRAM_Alloc(uint16_t size)
+{
+    uint8_t pool;
+    uint8_t index;
+    uint8_t mask;
+
+    for(pool = 0; pool < SRAM_POOLS; pool++)
+    {
+        if(size > poolBlockSize[pool])
+        {
+            continue;
+        }
+        mask = 1;
+        for(index = 0; index < poolBlocks[pool]; index++)
+        {
+            if((poolUsed[pool] & mask) == 0)
+            {
+                poolUsed[pool] |= mask;
+                if(++sramHeapStats.used[pool] > sramHeapStats.peak[pool])
+                {
+                    sramHeapStats.peak[pool] = sramHeapStats.used[pool];
+                }
+                return poolStart[pool] + index * poolBlockSize[pool];
+            }
+            mask <<= 1;
+        }
+    }
+    sramHeapStats.failures++;
+    return SRAM_NO_BLOCK;
+}
+
+void SRAM_Free(sramBlock_t block)
+{
+    uint8_t pool = SRAM_PoolOf(block);
+    uint8_t mask;
+
+    if(pool < SRAM_POOLS)
+    {
+        mask = 1 << ((block - poolStart[pool]) / poolBlockSize[pool]);
+        if(poolUsed[pool] & mask)
+        {
+            poolUsed[pool] &= ~mask;
+            sramHeapStats.used[pool]--;
+        }
+    }
+}
+
+uint16_t SRAM_BlockSize(sramBlock_t block)
+{
+    uint8_t pool = SRAM_PoolOf(block);
+
+    return (pool < SRAM_POOLS) ? poolBlockSize[pool] : 0;
+}
+
+uint16_t SRAM_Write(sramBlock_t block, uint16_t offset, const void *data, uint16_t length)
+{
+    length = SRAM_Clip(block, offset, length);
+    if(length)
+    {
+        ETH_SramWrite(block + offset, data, length);
+    }
+    return length;
+}
+
+uint16_t SRAM_Read(sramBlock_t block, uint16_t offset, void *data, uint16_t length)
+{
+    length = SRAM_Clip(block, offset, length);
+    if(length)
+    {
+        ETH_SramRead(block + offset, data, length);
+    }
+    return length;
+}
+
+uint16_t SRAM_Copy(sramBlock_t destination, sramBlock_t source, uint16_t length)
+{
+    length = SRAM_Clip(destination, 0, length);
+    length = SRAM_Clip(source, 0, length);
+    if(length && (ETH_SramCopy(destination, source, length) != SUCCESS))
+    {
+        return 0;
+    }
+    return length;
+}
+
+uint16_t SRAM_Checksum(sramBlock_t block, uint16_t offset, uint16_t length)
+{
+    length = SRAM_Clip(block, offset, length);
+    return length ? ETH_SramChecksum(block + offset, length) : 0;
+}
+
+uint16_t SRAM_CopyFromRx(sramBlock_t block, uint16_t offset, uint16_t length)
+{
+    uint16_t available = ETH_GetRxByteCount();
+
+    length = SRAM_Clip(block, offset, length);
+    if(length > available)
+    {
+        length = available;
+    }
+    if(length && (ETH_SramCopy(block + offset, ETH_GetReadPtr(), length) != SUCCESS))
+    {
+        return 0;
+    }
+    return length;
+}
+
+uint16_t SRAM_CopyToTx(sramBlock_t block, uint16_t offset, uint16_t length)
+{
+    length = SRAM_Clip(block, offset, length);
+    if(length)
+    {
+        ETH_CopyFrom(block + offset, length);
+    }
+    return length;
+}
+
+/**
+ * Find the pool a block belongs to
+ * @param block
+ * @return
+ *      The pool, SRAM_POOLS if the block is not the start of a heap block
+ */
+static uint8_t SRAM_PoolOf(sramBlock_t block)
+{
+    uint8_t pool;
+    uint16_t offset;
+
+    for(pool = 0; pool < SRAM_POOLS; pool++)
+    {
+        offset = block - poolStart[pool];
+        if((block >= poolStart[pool]) &&
+           (offset < poolBlocks[pool] * poolBlockSize[pool]) &&
+           ((offset % poolBlockSize[pool]) == 0))
+        {
+            break;
+        }
+    }
+    return pool;
+}
+
+/**
+ * Limit an access to the bytes of the block from offset on
+ * @param block
+ * @param offset
+ * @param length
+ * @return
+ *      The number of bytes that can be accessed
+ */
+static uint16_t SRAM_Clip(sramBlock_t block, uint16_t offset, uint16_t length)
+{
+    uint16_t size = SRAM_BlockSize(block);
+
+    if(offset >= size)
+    {
+        return 0;
+    }
+    size -= offset;
+    return (length < size) ? length : size;
+}
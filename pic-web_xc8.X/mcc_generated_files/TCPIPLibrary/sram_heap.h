@@ -0,0 +1,191 @@
+/**
+  Ethernet SRAM heap header file
+	
+  File Name:
+    sram_heap.h
+
+  Summary:
+    Header file for sram_heap.c.
+
+  Description:
+    This header file provides the API for the blocks of Ethernet SRAM kept
+    between the RX and TX buffers.
+
+ */
+
+#ifndef SRAM_HEAP_H
+#define	SRAM_HEAP_H
+
+#include <stdint.h>
+#include "tcpip_types.h"
+#include "tcpip_config.h"
+
+// A block is named by its Ethernet SRAM address.  The RX buffer starts at 0,
+// so 0 is never a heap address.
+typedef uint16_t sramBlock_t;
+
+#define SRAM_NO_BLOCK           (0u)
+#define SRAM_POOLS              (2u)
+#define SRAM_HEAP_SIZE          ((SRAM_SMALL_BLOCK_SIZE * SRAM_SMALL_BLOCKS) + (SRAM_LARGE_BLOCK_SIZE * SRAM_LARGE_BLOCKS))
+
+#if (SRAM_SMALL_BLOCKS > 8) || (SRAM_LARGE_BLOCKS > 8)
+#error "An SRAM heap pool holds at most 8 blocks"
+#endif
+
+typedef struct
+{
+    uint8_t used[SRAM_POOLS];       // blocks allocated now, small pool first
+    uint8_t peak[SRAM_POOLS];       // most blocks allocated at once
+    uint16_t failures;              // SRAM_Alloc() calls that found no block
+} sramHeapStats_t;
+
+extern sramHeapStats_t sramHeapStats;
+
+
+/*SRAM Heap Initializer.
+ * The function will free every block.  Call it after ETH_Init().
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void SRAM_HeapInit(void);
+
+
+/*Allocating a block.
+ * The function will take a free block of the smallest pool that can hold
+ * size bytes, or of a larger pool when that one is used up.
+ * 
+ * @param size
+ *      Bytes the block must hold
+ * 
+ * @param return
+ *      The block, SRAM_NO_BLOCK if there is none
+ * 
+ */
+sramBlock_t SRAM_Alloc(uint16_t size);
+
+
+/*Freeing a block.
+ * The function will return the block to its pool.  SRAM_NO_BLOCK is ignored.
+ * 
+ * @param block
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void SRAM_Free(sramBlock_t block);
+
+
+/*Block size.
+ * 
+ * @param block
+ * 
+ * @param return
+ *      Bytes the block holds, 0 if it is not a heap block
+ * 
+ */
+uint16_t SRAM_BlockSize(sramBlock_t block);
+
+
+/*Writing to a block.
+ * The function will copy data from RAM into the block, the write is clipped
+ * to the end of the block.
+ * 
+ * @param block
+ * @param offset
+ *      First byte of the block to write
+ * @param data
+ * @param length
+ * 
+ * @param return
+ *      Number of bytes written
+ * 
+ */
+uint16_t SRAM_Write(sramBlock_t block, uint16_t offset, const void *data, uint16_t length);
+
+
+/*Reading from a block.
+ * The function will copy data from the block into RAM, the read is clipped
+ * to the end of the block.
+ * 
+ * @param block
+ * @param offset
+ *      First byte of the block to read
+ * @param data
+ * @param length
+ * 
+ * @param return
+ *      Number of bytes read
+ * 
+ */
+uint16_t SRAM_Read(sramBlock_t block, uint16_t offset, void *data, uint16_t length);
+
+
+/*Copying between blocks.
+ * The function will DMA copy the start of one block into another and wait
+ * for it.
+ * 
+ * @param destination
+ * @param source
+ * @param length
+ * 
+ * @param return
+ *      Number of bytes copied, 0 if the DMA timed out
+ * 
+ */
+uint16_t SRAM_Copy(sramBlock_t destination, sramBlock_t source, uint16_t length);
+
+
+/*Summing a block.
+ * The function will compute the Internet checksum sum of part of the block,
+ * with the DMA checksum engine.
+ * 
+ * @param block
+ * @param offset
+ *      First byte of the block to sum, the sum is aligned to it
+ * @param length
+ * 
+ * @param return
+ *      The folded sum, not inverted, 0 if nothing was summed
+ * 
+ */
+uint16_t SRAM_Checksum(sramBlock_t block, uint16_t offset, uint16_t length);
+
+
+/*Saving received data.
+ * The function will DMA copy bytes of the received packet, from the read
+ * pointer on, into the block.  The read pointer does not move.
+ * 
+ * @param block
+ * @param offset
+ *      First byte of the block to write
+ * @param length
+ * 
+ * @param return
+ *      Number of bytes copied, 0 if the DMA timed out
+ * 
+ */
+uint16_t SRAM_CopyFromRx(sramBlock_t block, uint16_t offset, uint16_t length);
+
+
+/*Sending saved data.
+ * The function will append bytes of the block to the packet being written,
+ * like ETH_Copy() the copy runs in the background.
+ * 
+ * @param block
+ * @param offset
+ *      First byte of the block to send
+ * @param length
+ * 
+ * @param return
+ *      Number of bytes appended
+ * 
+ */
+uint16_t SRAM_CopyToTx(sramBlock_t block, uint16_t offset, uint16_t length);
+
+
+#endif	/* SRAM_HEAP_H */
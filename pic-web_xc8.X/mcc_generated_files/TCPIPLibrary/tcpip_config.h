@@ -1,88 +1,169 @@
-/**
-  TCP/IP Stack User configuration options header file
-
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    tcpip_config.h
-
-  Summary:
-    Header file for TCP/IP Stack User configuration options
-
-  Description:
-    This header file provides the TCP/IP Stack User configuration options.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software
-and any derivatives exclusively with Microchip products.
-
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS,
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE
-IN ANY APPLICATION.
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS.
-
-*/
-
-#ifndef TCPIP_CONFIG_H
-#define	TCPIP_CONFIG_H
-
-
-
-/**
-  Section: Included Files
-*/
-
-/**
-  Section: Macro Declarations
-*/
-
-/* Build the IPv4 Address*/
-#define MAKE_IPV4_ADDRESS(a,b,c,d) ((uint32_t)(((uint32_t)a << 24) | ((uint32_t)b<<16) | ((uint32_t)c << 8) | (uint32_t)d))
-
-
-/******************************** ARP Protocol Defines *********************************/
-#define ARP_MAP_SIZE 8
-
-
-
-
-/******************************** IP Protocol Defines ********************************/
-#define IPv4_TTL            64u
-
-/******************************** TCP Protocol Defines *********************************/
-// Define the maximum segment size for the 
-#define TCP_MAX_SEG_SIZE    1460u
-#define TICK_SECOND 1
-
-// TCP Timeout and retransmit numbers
-#define TCP_START_TIMEOUT_VAL           ((unsigned long)TICK_SECOND*2)	// Timeout to retransmit unacked data
-
-#define TCP_MAX_RETRIES                 (5u)                // Maximum number of retransmission attempts
-#define TCP_MAX_SYN_RETRIES             (3u)                // Smaller than all other retries to reduce SYN flood DoS duration
-
-#define LOCAL_TCP_PORT_START_NUMBER     (1024u)             // define the lower port number to be used as a local port
-#define LOCAL_TCP_PORT_END_NUMBER       (65535u)            // define the highest port number to be used as a local port
-
-/************************ Neighbor Discovery Protocol Defines **************************/
-
-/******************************** TCP/IP stack debug Defines *********************************/
-
-//#define ENABLE_TCP_DEBUG
-//#define ENABLE_IP_DEBUG
-//#define ENABLE_NET_DEBUG
-
+/**
+  TCP/IP Stack User configuration options header file
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    tcpip_config.h
+
+  Summary:
+    Header file for TCP/IP Stack User configuration options
+
+  Description:
+    This header file provides the TCP/IP Stack User configuration options.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software
+and any derivatives exclusively with Microchip products.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS,
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE
+IN ANY APPLICATION.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS.
+
+*/
+
+#ifndef TCPIP_CONFIG_H
+#define	TCPIP_CONFIG_H
+
+
+
+/**
+  Section: Included Files
+*/
+
+/**
+  Section: Macro Declarations
+*/
+
+/* Build the IPv4 Address*/
+#define MAKE_IPV4_ADDRESS(a,b,c,d) ((uint32_t)(((uint32_t)a << 24) | ((uint32_t)b<<16) | ((uint32_t)c << 8) | (uint32_t)d))
+
+
+/******************************** Network Receive Defines *********************************/
+// Network_Manage() handles received frames in batches, frames of up to
+// NETWORK_CONTROL_FRAME_LENGTH bytes (ARP, bare TCP segments, small pings)
+// and larger (bulk) frames are counted against separate budgets.
+//#define NETWORK_SINGLE_READ                               // handle one frame per Network_Manage() call
+#define NETWORK_CONTROL_FRAME_LENGTH    (74u)               // Ethernet + IPv4 + TCP header with 20 bytes of options
+#define NETWORK_RX_CONTROL_BUDGET       (8u)                // control frames per call
+#define NETWORK_RX_BULK_BUDGET          (2u)                // bulk frames per call
+#define NETWORK_RX_TICK_BUDGET          (1250u)             // TMR1 ticks (8 Tcy) per call, ~1 ms
+
+/******************************** Ethernet SRAM Heap Defines *********************************/
+// Blocks of Ethernet SRAM taken from the end of the RX buffer, see sram_heap.h.
+// Up to 8 blocks per pool, the block sizes keep the heap size even.  The
+// syslog batch holds a large block, TCP_Send() copies into the other one.
+#define SRAM_SMALL_BLOCK_SIZE           (64u)               // bytes per small block
+#define SRAM_SMALL_BLOCKS               (5u)                // number of small blocks
+#define SRAM_LARGE_BLOCK_SIZE           (512u)              // bytes per large block
+#define SRAM_LARGE_BLOCKS               (2u)                // number of large blocks
+
+/******************************** ARP Protocol Defines *********************************/
+#define ARP_MAP_SIZE 8
+
+
+
+
+/******************************** IP Protocol Defines ********************************/
+#define IPv4_TTL            64u
+
+/******************************** TCP Protocol Defines *********************************/
+// Define the maximum segment size for the 
+#define TCP_MAX_SEG_SIZE    1460u
+// TCP_Update() runs every TMR1 period, the TCP time-outs count those
+#define TICK_SECOND                     (1000u / TMR1_PERIOD_MS)
+
+// Window of sockets with a receive handler, the segments in flight wait in
+// the Ethernet RX buffer
+#define TCP_RX_HANDLER_WINDOW           (2u * TCP_MAX_SEG_SIZE)
+
+// Longest the ACK of a received segment waits for data to ride on, every
+// second segment is acknowledged at once; 0 acknowledges each one at once
+#define TCP_DELAYED_ACK_MS              (200u)
+
+// TCP_Send() copies the data into an SRAM heap block when one is free and
+// large enough, retransmissions are then copied from there by the DMA
+//#define TCP_TX_IN_APP_RAM                                 // keep unacknowledged data in the application buffer
+
+// Segments of the TCP_Send() data in flight at once, as far as the remote
+// window goes; 1 waits for the ACK of each segment before sending the next
+#define TCP_MAX_SEGMENTS_IN_FLIGHT      (4u)
+
+// Lookup buckets of the received segments, a power of two; the sockets are
+// spread over them by remote address, remote port and local port
+#define TCP_TCB_HASH_BUCKETS            (8u)
+
+// Connections a tcpListener_t keeps in the handshake or waiting for
+// TCP_Accept(), at most
+#define TCP_LISTEN_BACKLOG_MAX          (4u)
+
+// TCP Timeout and retransmit numbers
+#define TCP_START_TIMEOUT_VAL           ((unsigned long)TICK_SECOND*2)	// Timeout to retransmit the SYN and FIN segments
+
+// Data is sent again after a time-out computed from the round trip times
+// measured on the connection (RFC 6298), kept between these bounds; the
+// first segments wait TCP_RTO_INITIAL_MS.  A time-out runs out up to one
+// TMR1 period early, so keep the floor above one period
+#define TCP_RTO_MIN_MS                  (100u)
+#define TCP_RTO_MAX_MS                  (60000u)
+#define TCP_RTO_INITIAL_MS              (1000u)
+
+#define TCP_MAX_RETRIES                 (5u)                // Maximum number of retransmission attempts
+#define TCP_MAX_SYN_RETRIES             (3u)                // Smaller than all other retries to reduce SYN flood DoS duration
+
+#define LOCAL_TCP_PORT_START_NUMBER     (1024u)             // define the lower port number to be used as a local port
+#define LOCAL_TCP_PORT_END_NUMBER       (65535u)            // define the highest port number to be used as a local port
+
+/******************************** Log Defines ****************************************/
+// LOG_Event() records wait in a RAM ring of LOG_RING_RECORDS (8 bytes each)
+// until Network_Manage() finds the network idle and broadcasts them to
+// LOG_RING_PORT, see log_ring.h
+#define LOG_RING_RECORDS                (16u)               // power of 2, at most 128
+#define LOG_RING_PORT                   (5140u)             // UDP port of the log datagrams
+
+// logMessage() text for LOG_DEST_ETHERNET is collected in an SRAM heap block
+// and sent to the collector (ipdb_setSyslog(), broadcast while it is 0) when
+// the next message would not fit or SYSLOG_FLUSH_SECONDS after the first
+// one.  A token bucket of SYSLOG_BURST messages, refilled with SYSLOG_RATE
+// a second, limits the messages sent; the dropped ones are counted in a
+// "N messages suppressed" message once tokens are back.
+//#define SYSLOG_SINGLE_MESSAGE                             // send every message in its own datagram
+#define SYSLOG_BATCH_SIZE               (512u)              // bytes per datagram, at most SRAM_LARGE_BLOCK_SIZE
+#define SYSLOG_FLUSH_SECONDS            (1u)                // longest wait of a message in the batch
+#define SYSLOG_RATE                     (10u)               // messages per second
+#define SYSLOG_BURST                    (20u)               // messages sent at once after a quiet time
+
+/******************************** Statistics Defines *********************************/
+// the counters in net_stats.h are read, and cleared, with a datagram to
+// NET_STATS_PORT
+#define NET_STATS_PORT                  (5141u)             // UDP port of the statistics queries
+#define NET_PROFILE_BUCKETS             (12u)               // log2 buckets of the ENABLE_NETWORK_PROFILE histograms
+#define NET_LOOP_BUCKETS                (16u)               // log2 buckets of the main loop pass times, see net_loop.h
+#define NET_LOOP_TICK_BUDGET            (2500u)             // TMR1 ticks (8 Tcy) per main loop pass, ~2 ms
+
+/************************ Neighbor Discovery Protocol Defines **************************/
+
+/******************************** TCP/IP stack debug Defines *********************************/
+
+//#define ENABLE_TCP_DEBUG
+//#define ENABLE_IP_DEBUG
+//#define ENABLE_NET_DEBUG
+//#define ENABLE_NETWORK_PROFILE                            // time the hot path into histograms, see net_profile.h
+//#define ENABLE_LOOP_BUDGET_WARNING                        // log the main loop passes over NET_LOOP_TICK_BUDGET
+
 #endif	/* TCPIP_CONFIG_H */
\ No newline at end of file
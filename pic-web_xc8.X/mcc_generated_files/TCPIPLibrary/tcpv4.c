@@ -1,1583 +1,2440 @@
-/**
-    Transmission Control Protocol (TCP) version4 implementation
-    
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    tcpv4.c
-
-  Summary:
-    This is the implementation of for TCP version 4 stack
-
-  Description:
-    This header file provides the implementation of the API for the TCP v4 stack.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-#include <stdio.h>
-#include <stddef.h>
-#include <string.h>
-#include "ipv4.h"
-#include "tcpv4.h"
-#include "network.h"
-#include "ethernet_driver.h"
-#include "tcpip_types.h"
-#include "log.h"
-#include "tcpip_config.h"
-#include "icmp.h"
-
-tcpTCB_t *tcbList;
-socklistsize_t tcbListSize;
-tcpTCB_t *currentTCB;
-
-static tcpHeader_t tcpHeader;
-static uint16_t nextAvailablePort;
-static uint32_t nextSequenceNumber;
-
-static uint32_t receivedRemoteAddress;
-static uint16_t rcvPayloadLen;
-static uint16_t tcpMss = 536;
-
-//jira: CAE_MCU8-6056
-static uint16_t tcpDataLength;
-static uint16_t bytesToSendForRetransmit = 0;
-static uint8_t *txBufferPtrForRetransmit;
-static uint32_t localSeqnoForRetransmit;
-static uint32_t lastAckNumber;
-
-#ifdef ENABLE_NETWORK_DEBUG
-#define logMsg(msg, msgSeverity, msgLogDest)    logMessage(msg, LOG_KERN, msgSeverity, msgLogDest)  
-#else
-#define logMsg(msg, msgSeverity, msgLogDest)
-#endif
-
-static error_msg TCP_FiniteStateMachine(void);  //jira: CAE_MCU8-5647
-
-static error_msg TCP_TimoutRetransmit(void);
-
-/** The function will insert a pointer to the new TCB into the TCB pointer list.
- *
- *  @param ptr
- *      pointer to the user allocated memory for the TCB structure
- *
- * @return
- *      Status of the function
- */
-static void TCB_Insert(tcpTCB_t *ptr)
-{
-    // Insert the new TCB at the head of the list.
-    // This prevents a list traversal and saves time.
-    if(tcbList != NULL)
-    {
-        // link this TCB as the previous one for the top of the list
-        tcbList->prevTCB = ptr;
-    }
-    ptr->nextTCB = tcbList; // put the existing list at the end of this tcb...
-    tcbList = ptr;           // put this tcb at the head of the list.
-    ptr->prevTCB = NULL;     // make sure that the upstream pointer is empty
-    tcbListSize ++;
-}
-
-/** The function will remove a pointer to a TCB from the TCB pointer list
- *  and connect any TCB's before & behind together.
- *
- *  @param ptr
- *      pointer to the user allocated memory for the TCB structure
- *
- * @return
- *      None
- */
-static void TCB_Remove(tcpTCB_t *ptr)
-{
-    if(tcbListSize > 1)
-    {
-        // check if this is the first in list
-        if(ptr->prevTCB == NULL)
-        {
-            tcbList = ptr->nextTCB;
-            ((tcpTCB_t *)(ptr->nextTCB))->prevTCB = NULL;
-        } else
-        {
-            ((tcpTCB_t *)(ptr->prevTCB))->nextTCB = ptr->nextTCB;
-            ((tcpTCB_t *)(ptr->nextTCB))->prevTCB = ptr->prevTCB;
-        }
-        tcbListSize --;
-    }
-    else if(tcbListSize==1)
-    {
-        tcbList = NULL;
-    }
-}
-
-/** Reseting the socket to a known state.
- * 
- * @param tcbPtr 
- *      pointer to socket/TCB structure
- * 
- * @return
- *      None
- */
-static void TCB_Reset(tcpTCB_t *tcbPtr)
-{
-    tcbPtr->destIP = 0;
-    tcbPtr->destPort = 0;
-    tcbPtr->localSeqno = 0;
-    tcbPtr->localLastAck = 0;
-    tcbPtr->remoteSeqno = 0;
-    tcbPtr->remoteAck = 0;
-    tcbPtr->remoteWnd = 0;
-
-    tcbPtr->timeout = 0;
-    tcbPtr->timeoutReloadValue = 0;
-    tcbPtr->timeoutsCount = 0;
-    tcbPtr->flags = 0;
-    
-    tcbPtr->localPort = 0;
-    tcbPtr->bytesSent = 0;
-    tcbPtr->payloadSave = false;
-    tcbPtr->socketState = SOCKET_CLOSING;
-}
-
-/** Check is a pointer to a socket/TCB. If the pointer is in the TCB list
- *  then it is a valid socket.
- * 
- * @param tcbPtr 
- *      pointer to socket/TCB structure
- * 
- * @return
- *      None
- */
-static error_msg TCB_Check(tcpTCB_t *ptr)   //jira: CAE_MCU8-5647
-{
-    tcpTCB_t *tcbPtr;
-    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
-    socklistsize_t count = 0;
-    
-    if((tcbList != NULL) && (ptr != NULL))
-    {
-        // search for ptr into the active TCB/sockets list
-        tcbPtr = tcbList;
-        while((tcbPtr != NULL) && (count < tcbListSize))
-        {
-            if (tcbPtr == ptr)
-            {
-                ret = SUCCESS;   //jira: CAE_MCU8-5647
-                break;
-            }
-            else
-            {
-                tcbPtr = tcbPtr->nextTCB;
-                count ++;
-            }
-        }        
-    }
-    return ret;
-}
-
-
-/** Internal function of the TCP Stack to send an TCP packet.
- * 
- * @param tcbPtr
- *      pointer to the socket/TCB structure
- * 
- * @return
- *      true - The buffer was send successfully
- * @return
- *      false - Send buffer fails.
- */
-static error_msg TCP_Snd(tcpTCB_t *tcbPtr)   //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;
-    tcpHeader_t txHeader;
-    uint16_t payloadLength;
-    uint16_t cksm;
-    uint8_t *data;
-
-    txHeader.sourcePort = htons(tcbPtr->localPort);
-    txHeader.destPort = htons(tcbPtr->destPort);
-
-    txHeader.sequenceNumber = htonl(tcbPtr->localSeqno);
-
-    txHeader.ackNumber = htonl(tcbPtr->remoteAck); //ask for next packet
-
-    txHeader.ns = 0;          // make sure we clean unused fields
-    txHeader.reserved = 0;    // make sure we clean unused fields
-    txHeader.dataOffset = 5;  // We don't support options for now
-    txHeader.windowSize = htons(tcbPtr->localWnd);
-    txHeader.checksum = 0;
-    txHeader.urgentPtr = 0;
-
-    if ((tcbPtr->flags) & (TCP_SYN_FLAG | TCP_RST_FLAG))
-    {
-        tcpDataLength = 0; // SYN and RST packets doesn't have any payload
-    } 
-    else if(tcbPtr->payloadSave == true)
-    {
-        tcpDataLength = 0;
-    }else
-    {
-        tcpDataLength = tcbPtr->bytesSent;
-
-        if (tcpDataLength != 0)
-        {
-            if(tcbPtr->remoteWnd == 0)
-            {
-                tcbPtr->remoteWnd = 1;
-            }
-            if(tcpDataLength > tcbPtr->remoteWnd)
-            {
-                tcpDataLength = tcbPtr->remoteWnd;
-            }
-
-            if(tcpDataLength > tcbPtr->mss)
-            {
-                tcpDataLength = tcbPtr->mss;
-            }
-            data = tcbPtr->txBufferPtr;
-
-            // update the pointer to the next byte that needs to be sent
-            tcbPtr->txBufferPtr = tcbPtr->txBufferPtr + tcpDataLength;
-            tcbPtr->bytesToSend = tcbPtr->bytesSent - tcpDataLength;
-
-            if (tcbPtr->bytesToSend == 0)
-            {
-                tcbPtr->flags = tcbPtr->flags | TCP_PSH_FLAG;
-            }
-        }
-    }
-    //update the TCP Flags
-    txHeader.flags = tcbPtr->flags;
-    payloadLength = sizeof(tcpHeader_t) + tcpDataLength;
-
-    ret = IPv4_Start(tcbPtr->destIP, TCP_TCPIP);
-    if (ret == SUCCESS)
-    {
-        ETH_WriteBlock((char *) &txHeader, sizeof(tcpHeader_t));   //jira: M8TS-608
-
-        if (tcpDataLength > 0)
-        {
-            ETH_WriteBlock((char *) data, tcpDataLength);   //jira: M8TS-608
-        }
-
-        cksm = payloadLength + TCP_TCPIP;
-        // Calculate the TCP checksum
-        cksm = ETH_TxComputeChecksum(sizeof(ethernetFrame_t) + sizeof(ipv4Header_t) - 8, payloadLength + 8, cksm);
-        ETH_Insert((char *)&cksm, 2, sizeof(ethernetFrame_t) + sizeof(ipv4Header_t) + offsetof(tcpHeader_t,checksum));
-
-        ret = IPV4_Send(payloadLength);        
-//        tcbPtr->txBufferPtr = tcbPtr->txBufferPtr - tcpDataLength;
-    }
-
-    // The packet wasn't transmitted
-    // Use the timeout to retry again later
-    if (ret != SUCCESS && ret != TX_QUEUED)	// jira: CAE_MCU8-5647, CAE_MCU8-6056
-    {
-        // make sure we keep the remaining timeouts and skip this send  that failed
-        // try at least once
-        tcbPtr->timeoutsCount = tcbPtr->timeoutsCount - 1u; // CAE_MCU8-5749, CAE_MCU8-5647
-
-        if (tcbPtr->timeout == 0)
-        {
-            tcbPtr->timeout = TCP_START_TIMEOUT_VAL;
-        }
-    }
-    else
-    {
-        //if the packet was sent increment the Seqno.
-        tcbPtr->localSeqno = tcbPtr->localSeqno + tcpDataLength;
-        logMsg("tcp_packet sent",LOG_INFO, LOG_DEST_CONSOLE);
-    }
-
-    return ret;
-}
-
-/** Internal function of the TCP Stack. Will copy the TCP packet payload to 
- * the socket RX buffer. This function will also send the ACK for
- * the received packet and any ready to be send data.
- * 
- * @param len
- *      length of the payload received
- * 
- * @return
- *      true - The payload was copied to RX buffer successfully
- * @return
- *      false - Copying the payload failed.
- */
-error_msg TCP_PayloadSave(uint16_t len)   //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;   //jira: CAE_MCU8-5647
-    uint16_t buffer_size;
-
-    // check if we have a valid buffer
-    if (currentTCB->rxBufState == RX_BUFF_IN_USE)
-    {
-        // make sure we have enough space
-        if (currentTCB->localWnd >= len)
-        {
-            buffer_size = len;
-        }else
-        {
-            buffer_size = currentTCB->localWnd;
-        }
-        
-        ETH_ReadBlock(currentTCB->rxBufferPtr, buffer_size);
-        currentTCB->rxBufferPtr =  currentTCB->rxBufferPtr + buffer_size;
-
-        //update the local window to inform the remote of the available space
-        currentTCB->localWnd =  currentTCB->localWnd - buffer_size;
-        currentTCB->remoteAck = currentTCB->remoteSeqno + buffer_size;
-
-        //prepare to send the ACK and maybe some data if there are any
-        currentTCB->flags = TCP_ACK_FLAG;
-        currentTCB->payloadSave = true;
-        
-        TCP_Snd(currentTCB);
-        currentTCB->payloadSave = false;
-        ret = SUCCESS;    //jira: CAE_MCU8-5647
-    }
-    return ret;
-}
-
-
-/** This function will read and parse the OPTIONS field in TCP header.
- *  Each TCP header could have the options field.
- *  we will read only the ones that has SYN or SYN + ACK
- *  for the other TCP headers the options will be skipped.
- *
- * @param 
- *      None
- *  
- * @return
- *      true - parsing the options filed was successfully
- * @return
- *      false - parsing the options filed was failed.
- */
-static error_msg TCP_ParseTCPOptions(void)   //jira: CAE_MCU8-5647
-{
-    uint8_t  opt;
-    uint16_t tcpOptionsSize;
-    error_msg ret;     //jira: CAE_MCU8-5647
-
-    ret = ERROR;      //jira: CAE_MCU8-5647
-    // Check for the option fields in TCP header
-    tcpOptionsSize = (uint16_t)(tcpHeader.dataOffset << 2u) - (uint16_t)sizeof(tcpHeader_t);   //jira: CAE_MCU8-5647
-
-    if (tcpOptionsSize > 0)
-    {
-        // RFC 1122, page 85, Section 4.2.2.6  Maximum Segment Size Option: RFC-793 Section 3.1
-        // more explanations in RFC-6691
-        tcpMss = 536;
-        // parse the option only for SYN segments
-        if(tcpHeader.syn)
-        {
-            // Parse for the TCP MSS option, if present.
-            while(tcpOptionsSize--)
-            {
-                opt = ETH_Read8();
-                switch (opt)
-                {
-                    case TCP_EOP:
-                        // End of options.
-                        if (tcpOptionsSize)
-                        {
-                            // dump remaining unused bytes
-                            ETH_Dump(tcpOptionsSize);
-                            tcpOptionsSize = 0;
-                        }
-                        ret = SUCCESS;    //jira: CAE_MCU8-5647
-                        break;
-                    case TCP_NOP:
-                        // NOP option.
-                        break;
-                    case TCP_MSS:
-                        if (tcpOptionsSize >= 3) // at least 3 more bytes
-                        {
-                            opt = ETH_Read8();
-                            if (opt == 0x04)
-                            {
-                                // An MSS option with the right option length.
-                                tcpMss = ETH_Read16(); // value returned in host endianess
-                                // Advance to the next option
-                                tcpOptionsSize = tcpOptionsSize - 3;
-
-                                // Limit the mss to the configured TCP_MAX_SEG_SIZE
-                                if (tcpMss > TCP_MAX_SEG_SIZE)
-                                {
-                                    tcpMss = TCP_MAX_SEG_SIZE;
-                                }
-                                // so far so good
-                                ret = SUCCESS;    //jira: CAE_MCU8-5647
-                            }else
-                            {
-                                // Bad option size length
-                                logMsg("tcp_parseopt: bad option size length",LOG_INFO, LOG_DEST_CONSOLE);
-                                // unexpected error
-                                tcpOptionsSize = 0;
-                                ret = ERROR;     //jira: CAE_MCU8-5647
-                            }
-                        }else
-                        {
-                            // unexpected error
-                            tcpOptionsSize = 0;
-                            ret = ERROR;     //jira: CAE_MCU8-5647
-                        }
-                        break;
-                    default:
-                        logMsg("tcp_parseopt: other",LOG_INFO, LOG_DEST_CONSOLE);
-                        opt = ETH_Read8();
-                        tcpOptionsSize--;
-
-                        if (opt > 1) // this should be at least 2 to be valid
-                        {
-                            // adjust for the remaining bytes for the current option
-                            opt = opt - 2u;    //jira: CAE_MCU8-5647
-                            if (opt <= tcpOptionsSize)
-                            {
-                                // All other options have a length field, so that we easily can skip them.
-                                ETH_Dump(opt);
-                                tcpOptionsSize = tcpOptionsSize - opt;
-                                ret = SUCCESS;    //jira: CAE_MCU8-5647
-                            }else
-                            {
-                                logMsg("tcp_parseopt: bad option length",LOG_INFO, LOG_DEST_CONSOLE);
-                                // the options are malformed and we don't process them further.
-                                tcpOptionsSize = 0;
-                                ret = ERROR;     //jira: CAE_MCU8-5647
-                            }
-                        }else
-                        {
-                            logMsg("tcp_parseopt: bad length",LOG_INFO, LOG_DEST_CONSOLE);
-                            // If the length field is zero, the options are malformed
-                            // and we don't process them further.
-                            tcpOptionsSize = 0;
-                            ret = ERROR;     //jira: CAE_MCU8-5647
-                        }
-                        break;
-                }
-            }
-        }else // jump over the Options from TCP header
-        {
-            ETH_Dump(tcpOptionsSize);
-            ret = SUCCESS;    //jira: CAE_MCU8-5647
-        }
-    }else
-    {
-        ret = SUCCESS;    //jira: CAE_MCU8-5647
-    }
-
-    return ret;
-}
-
-/** This function will be called by the IP layer for each received TCP packet.
- * It will identify the destination socket and also parse the TCP header.
- * 
- * @param remoteAddress
- *      Source IP address for the received TCP packet
- * 
- * @param length
- *      Length of the TCP payload
- * 
- * @return
- *      None
- */
-void TCP_Recv(uint32_t remoteAddress, uint16_t length)
-{
-    tcpTCB_t *tcbPtr;
-    socklistsize_t count = 0;
-
-    tcbPtr = NULL;
-    //make sure we will not reuse old values
-    receivedRemoteAddress = 0;
-    rcvPayloadLen = 0;
-
-    ETH_ReadBlock((char *)&tcpHeader,sizeof(tcpHeader_t));
-
-    currentTCB = NULL;
-
-    // quick check on destination port
-    if ((tcpHeader.destPort != 0) && (tcpHeader.sourcePort != 0))
-    {
-        tcpHeader.sourcePort = ntohs(tcpHeader.sourcePort);
-        tcpHeader.destPort = ntohs(tcpHeader.destPort);
-        
-        // search for active TCB
-        tcbPtr = tcbList;
-        while((tcbPtr != NULL) && (count < tcbListSize))
-        {
-            if (tcpHeader.destPort == tcbPtr->localPort)
-            {
-                currentTCB = tcbPtr;
-                break;
-            }
-            else
-            {
-                tcbPtr = tcbPtr->nextTCB;
-                count ++;
-            }
-        }
-
-        if (currentTCB != NULL)
-        {
-            if((tcpHeader.sourcePort == currentTCB->destPort) ||
-               (currentTCB->destIP == 0))
-            {
-                // we will need this if the port is in listen mode
-                // or to check for the correct TCB
-                receivedRemoteAddress = remoteAddress;
-                rcvPayloadLen = length - (uint16_t)(tcpHeader.dataOffset << 2);
-
-                // check/skip the TCP header options
-                if (TCP_ParseTCPOptions() == SUCCESS)
-                {
-                    // we got a packet
-                    // sort out the events
-                    if(tcpHeader.syn)
-                    {
-                        if(tcpHeader.ack)
-                        {
-                            logMsg("found syn&ack",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->connectionEvent = RCV_SYNACK;
-                        } else
-                        {
-                            logMsg("found syn",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->connectionEvent = RCV_SYN;
-                        }
-                    } else if(tcpHeader.fin)
-                    {
-                        if(tcpHeader.ack)
-                        {
-                            logMsg("found fin&ack",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->connectionEvent = RCV_FINACK;
-                        } else
-                        {
-                            logMsg("found fin",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->connectionEvent = RCV_FIN;
-                        }
-                    } else if(tcpHeader.rst)
-                    {
-                        if(tcpHeader.ack)
-                        {
-                            logMsg("found rst&ack",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->connectionEvent = RCV_RSTACK;
-                        } else
-                        {
-                            logMsg("found rst",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->connectionEvent = RCV_RST;
-                        }
-                    } else if(tcpHeader.ack)
-                    {
-                        logMsg("found ack",LOG_INFO, LOG_DEST_CONSOLE);
-                        currentTCB->connectionEvent = RCV_ACK;
-                    }
-                    else
-                    {
-                        logMsg("confused",LOG_INFO, LOG_DEST_CONSOLE);
-                    }
-                    // convert it here to save some cycles later
-                    tcpHeader.ackNumber = ntohl(tcpHeader.ackNumber);
-                    tcpHeader.sequenceNumber = ntohl(tcpHeader.sequenceNumber);
-
-                    TCP_FiniteStateMachine();
-                }else
-                {
-                    logMsg("pkt dropped: bad options",LOG_INFO, LOG_DEST_CONSOLE);
-                }
-            } // we will not send a reset message for PORT not open
-        }
-    }
-}
-
-
-/** This function is TCP stack state machine.
- * 
- *  The function is called each time an event (opening/closing a connection,
- *  receiving TCP packet, etc) occurs.
- * 
- * @param 
- *      None
- * 
- * @return
- *      None
- */
-static error_msg TCP_FiniteStateMachine(void)  //jira: CAE_MCU8-5647
-{
-    uint16_t notAckBytes;
-    error_msg ret = ERROR;  //jira: CAE_MCU8-5647
-
-    tcp_fsm_states_t nextState = currentTCB->fsmState; // default don't change states
-    tcpEvent_t event = currentTCB->connectionEvent;
-    if(isPortUnreachable(currentTCB->localPort))
-    {
-        event = RCV_RST;
-        resetPortUnreachable();
-    }
-    switch (currentTCB->fsmState)
-    {
-        case LISTEN:
-            switch (event)
-            {
-                case RCV_SYN:
-                    logMsg("LISTEN: rx_syn",LOG_INFO, LOG_DEST_CONSOLE);
-                    // Start the connection on the TCB
-
-                    currentTCB->destIP = receivedRemoteAddress;
-                    currentTCB->destPort = tcpHeader.sourcePort;
-
-                    // TO DO modify the start seq no to be "random"
-                    currentTCB->localLastAck = 0;
-
-                    currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
-                    currentTCB->remoteAck = currentTCB->remoteSeqno + 1; // ask for next packet
-
-                    // save data from TCP header
-                    currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
-                    currentTCB->mss = tcpMss;
-
-                    // create and send a SYN+ACK packet
-                    currentTCB->flags =   TCP_SYN_FLAG | TCP_ACK_FLAG;
-                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutsCount = TCP_MAX_SYN_RETRIES;
-
-                    TCP_Snd(currentTCB);
-                    nextState = SYN_RECEIVED;
-                    break;
-                case CLOSE:
-                    logMsg("LISTEN: close",LOG_INFO, LOG_DEST_CONSOLE);
-                    nextState = CLOSED;
-                    TCB_Reset(currentTCB);
-                    break;
-                default:
-                    // for all other cases the packet is invalid and will be discarded
-                    break;
-            }
-            break;
-        case SYN_SENT:
-            switch (event)
-            {
-                case RCV_SYN:
-                    logMsg("SYN_SENT: rx_syn",LOG_INFO, LOG_DEST_CONSOLE);
-                    // Simultaneous open
-                    currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
-                    currentTCB->remoteAck = tcpHeader.sequenceNumber + 1; //ask for next packet
-
-                    // save data from TCP header
-                    currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
-                    currentTCB->mss = tcpMss;
-
-                    // create and send a ACK packet
-                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutsCount = TCP_MAX_SYN_RETRIES;
-                    currentTCB->flags = TCP_SYN_FLAG | TCP_ACK_FLAG;
-
-                    TCP_Snd(currentTCB);
-
-                    //Go to SYN_RECEIVED and waiting for the ack
-                    nextState = SYN_RECEIVED;
-                    break;
-                case RCV_SYNACK:
-                    logMsg("SYN_SENT: rx_synack",LOG_INFO, LOG_DEST_CONSOLE);
-
-                    currentTCB->timeout = 0;
-
-                    if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
-                    {
-                        // create and send a ACK packet
-                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
-                        currentTCB->flags =  TCP_ACK_FLAG;
-
-                        // save data from TCP header
-                        currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
-                        // ask for next packet
-                        currentTCB->remoteAck = tcpHeader.sequenceNumber + 1;
-
-                        currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
-                        currentTCB->mss = tcpMss;
-
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = ESTABLISHED;
-                            currentTCB->socketState = SOCKET_CONNECTED;
-                        }
-                    }
-                    else
-                    {
-                        //send reset
-                        currentTCB->localSeqno = tcpHeader.ackNumber;
-                        currentTCB->flags =  TCP_RST_FLAG | TCP_ACK_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    }
-                    break;
-                case RCV_ACK:
-                    logMsg("SYN_SENT: rx_ack",LOG_INFO, LOG_DEST_CONSOLE);
-
-                    currentTCB->timeout = 0;
-
-                    if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
-                    {
-                        // create and send a ACK packet
-                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
-                        currentTCB->flags =  TCP_ACK_FLAG;
-
-                        // save data from TCP header
-                        currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
-                        currentTCB->remoteAck = tcpHeader.sequenceNumber + 1; // ask for next packet
-
-                        currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
-                        currentTCB->mss = tcpMss;
-
-                        nextState = ESTABLISHED;
-                        currentTCB->socketState = SOCKET_CONNECTED;
-                    }
-                    else
-                    {
-                        //send reset
-                        currentTCB->localSeqno = tcpHeader.ackNumber;
-                        currentTCB->flags =  TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))    //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    }
-                    break;
-                case CLOSE:
-                    logMsg("SYN_SENT: close",LOG_INFO, LOG_DEST_CONSOLE);
-                    //go to CLOSED state
-                    nextState = CLOSED;
-                    TCB_Reset(currentTCB);
-                    break;
-                case TIMEOUT:
-                    logMsg("SYN_SENT: timeout",LOG_INFO, LOG_DEST_CONSOLE);
-                    // looks like the the packet was lost
-                    // check inside the packet to see where to jump next
-                    if (currentTCB->timeoutsCount)
-                    {
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            if (currentTCB->flags & TCP_RST_FLAG)
-                            {
-                                nextState = CLOSED;
-                                TCB_Reset(currentTCB);
-                            }else
-                            if(currentTCB->flags & TCP_ACK_FLAG)
-                            {
-                                nextState = ESTABLISHED;
-                                currentTCB->socketState = SOCKET_CONNECTED;
-                            }                        
-                        }
-                    }else
-                    {
-                        // just reset the connection if there is no reply
-                        currentTCB->flags = TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    } 
-                    break;
-                case RCV_RST:
-                case RCV_RSTACK:
-                    // port seems not to be opened
-                    nextState = CLOSED;
-                    TCB_Reset(currentTCB);
-                    break;
-                default:
-                    // for all other cases the packet is invalid and will be discarded
-                    break;
-            }
-            break;
-        case SYN_RECEIVED:
-            switch (event)
-            {
-                case RCV_SYNACK:
-                    logMsg("SYN_RECEIVED: rx_synack",LOG_INFO, LOG_DEST_CONSOLE);
-                    if (currentTCB->localPort == tcpHeader.destPort)
-                    {
-                        // stop the current timeout
-                        currentTCB->timeout = 0;
-
-                        // This is part of simultaneous open
-                        // TO DO: Check if the received packet is the one that we expect
-                        if ((currentTCB->destIP == receivedRemoteAddress) && (currentTCB->destPort == tcpHeader.sourcePort))
-                        if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
-
-                        nextState = ESTABLISHED;
-                        currentTCB->socketState = SOCKET_CONNECTED;
-                    }
-                    break;
-                case RCV_ACK:
-                    logMsg("SYN_RECEIVED: rx_ack",LOG_INFO, LOG_DEST_CONSOLE);
-
-                    // check if the packet is for the curent TCB
-                    // we need to check the remote IP adress and remote port
-                    if ((currentTCB->destIP == receivedRemoteAddress) && (currentTCB->destPort == tcpHeader.sourcePort))
-                    {
-                        // check the sequence numbers
-                        // is it the packet that I've ask for?
-                        if (currentTCB->remoteAck == tcpHeader.sequenceNumber)
-                        {
-                            // is ACK OK?
-                            if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
-                            {
-                                currentTCB->localSeqno = currentTCB->localSeqno + 1;
-                                // stop the current timeout
-                                currentTCB->timeout = 0;
-                                
-                                nextState = ESTABLISHED;
-                                currentTCB->socketState = SOCKET_CONNECTED;
-                            }
-                        }
-                    }
-                    break;
-                case CLOSE:
-                    logMsg("SYN_RECEIVED: close",LOG_INFO, LOG_DEST_CONSOLE);
-                    // stop the current timeout
-                    currentTCB->timeout = 0;
-                    // Need to send FIN and go to the FIN_WAIT_1
-                    currentTCB->flags = TCP_FIN_FLAG;
-                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutsCount = TCP_MAX_RETRIES;
-                    
-                    nextState = FIN_WAIT_1;
-                    TCP_Snd(currentTCB);
-                    break;
-                case RCV_RSTACK:
-                case RCV_RST:
-                    // Reset the connection
-                    logMsg("SYN_RECEIVED:  rx_rst",LOG_INFO, LOG_DEST_CONSOLE);
-                    //check if the local port match; else drop the pachet
-                    if (currentTCB->localPort == tcpHeader.destPort)
-                    {
-                        if (currentTCB->remoteAck ==  tcpHeader.sequenceNumber)
-                        {
-                            logMsg("rst seq OK",LOG_INFO, LOG_DEST_CONSOLE);
-                            currentTCB->destIP = 0;
-                            currentTCB->destPort = 0;
-                            currentTCB->localSeqno = 0;
-                            currentTCB->localLastAck = 0;
-                            currentTCB->remoteSeqno = 0;
-                            currentTCB->remoteAck = 0;
-                            currentTCB->remoteWnd = 0;
-                            //TCP_MAX_SEG_SIZE instead of 0
-                            currentTCB->mss = TCP_MAX_SEG_SIZE;
-                            
-                            nextState = LISTEN;
-                        }
-                    }
-                    break;
-                case TIMEOUT:
-                    logMsg("SYN_RECEIVED:  timeout",LOG_INFO, LOG_DEST_CONSOLE);
-                    if (currentTCB->timeoutsCount)
-                    {
-                        TCP_Snd(currentTCB);
-                    }
-                    else
-                    {
-                        //reseting the connection if there is no reply
-                        currentTCB->flags =   TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            currentTCB->destIP = 0;
-                            currentTCB->destPort = 0;
-                            currentTCB->localSeqno = 0;
-                            currentTCB->localLastAck = 0;
-                            currentTCB->remoteSeqno = 0;
-                            currentTCB->remoteAck = 0;
-                            currentTCB->remoteWnd = 0;
-                            //TCP_MAX_SEG_SIZE instead of 0
-                            currentTCB->mss = TCP_MAX_SEG_SIZE;
-                            nextState = LISTEN;
-                        }
-                    }
-                    break;
-                default:
-                    // invalid packet so drop it
-                    break;
-            }
-            break;
-        case ESTABLISHED:
-            switch (event)
-            {
-                case RCV_ACK:
-                    logMsg("ESTABLISHED: rx_ack",LOG_INFO, LOG_DEST_CONSOLE);
-                    if (currentTCB->destIP == receivedRemoteAddress)
-                    {
-                        // is sequence number OK?
-                        // remote ACK should be equal to header sequence number
-                        // we don't accept out of order packet (not enough memory)
-                        if (currentTCB->remoteAck == tcpHeader.sequenceNumber)
-                        {
-                            // This is a ACK packet only
-                            // check the ACK sequence
-                            // check if this is on already received Ack
-                            if (currentTCB->localLastAck < tcpHeader.ackNumber)
-                            {
-                                // check how many bytes sent was acknowledged
-                                if ((currentTCB->localSeqno + 1) >= tcpHeader.ackNumber)
-                                {
-                                    notAckBytes = currentTCB->localSeqno - tcpHeader.ackNumber;
-
-                                    // update the pointer for next TX
-                                    currentTCB->txBufferPtr = currentTCB->txBufferPtr - notAckBytes;
-                                    currentTCB->bytesToSend = currentTCB->bytesToSend  + notAckBytes;
-                                    
-                                    currentTCB->localLastAck = tcpHeader.ackNumber - 1;
-                                    currentTCB->localSeqno = tcpHeader.ackNumber;
-                                    if(bytesToSendForRetransmit == 0)
-                                    {
-                                        localSeqnoForRetransmit = currentTCB->localSeqno;
-                                    }
-                                    // Check if all TX buffer/data was acknowledged
-                                    if(currentTCB->bytesToSend == 0) 
-                                    {
-                                        if (currentTCB->txBufState == TX_BUFF_IN_USE)
-                                        {
-                                            currentTCB->txBufState = NO_BUFF;
-                                            //stop timeout
-                                            currentTCB->timeout = 0;
-                                        }
-                                    }                                    
-                                    else
-                                    {       
-                                        if(bytesToSendForRetransmit)	//jira: CAE_MCU8-6056
-                                        {
-                                            currentTCB->txBufferPtr = txBufferPtrForRetransmit;
-                                            currentTCB->bytesSent = bytesToSendForRetransmit;
-                                            currentTCB->localSeqno = localSeqnoForRetransmit;
-                                        }
-                                        else
-                                        {
-                                            currentTCB->bytesSent = currentTCB->bytesToSend;
-                                        }
-                                        currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                                        currentTCB->timeoutsCount = TCP_MAX_RETRIES;
-                                        TCP_Snd(currentTCB);
-                                        if( (bytesToSendForRetransmit>0) && (lastAckNumber != tcpHeader.ackNumber) )	//jira: CAE_MCU8-6056
-                                        {
-                                            bytesToSendForRetransmit =0;
-                                        }
-                                    }
-
-                                    
-                                    // check if the packet has payload
-                                    if(rcvPayloadLen > 0)
-                                    {
-                                        currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
-
-                                        // copy the payload to the local buffer
-                                        TCP_PayloadSave(rcvPayloadLen);
-                                    }
-                                }else
-                                {
-                                    // this is a wrong Ack
-                                    // ACK a packet that wasn't transmitted
-                                }
-                            }
-                        }
-                    }
-                    break;
-                case CLOSE:
-                    logMsg("ESTABLISHED: close",LOG_INFO, LOG_DEST_CONSOLE);
-                    currentTCB->flags = TCP_FIN_FLAG | TCP_ACK_FLAG ;	//jira: M8TS-514, M8TS-538, M8TS-463
-                    nextState = FIN_WAIT_1;
-                    currentTCB->timeout = 0;
-                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutsCount = TCP_MAX_RETRIES;
-                    TCP_Snd(currentTCB);
-                    break;
-                case RCV_FIN:
-                    logMsg("ESTABLISHED: rx_fin",LOG_INFO, LOG_DEST_CONSOLE);
-                    break;
-                case RCV_FINACK:
-                    if (currentTCB->destIP == receivedRemoteAddress)        //jira: CAE_MCU8-5830
-                    {
-                        // is sequence number OK?
-                        // remote ACK should be equal to header sequence number
-                        // we don't accept out of order packet (not enough memory)
-                        if (currentTCB->remoteAck == tcpHeader.sequenceNumber)    //jira: CAE_MCU8-5830
-                        {
-                            currentTCB->bytesSent = 0;                   
-                            // ACK the current packet
-                            // TO DO  check if it's a valid packet
-                            currentTCB->localSeqno = tcpHeader.ackNumber;
-                            currentTCB->remoteAck = currentTCB->remoteAck + 1;
-
-                            // check if the packet has payload added for MCCV3xx-6762
-                            if(rcvPayloadLen > 0)	 //jira: CAE_MCU8-6056
-                            {
-                                currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
-
-                                // copy the payload to the local buffer
-                                TCP_PayloadSave(rcvPayloadLen);
-                            }
-
-                            currentTCB->socketState = SOCKET_CLOSING;
-                            currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                            currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                            currentTCB->timeoutsCount = TCP_MAX_RETRIES;
-                            // JUMP over CLOSE_WAIT state and send one packet with FIN + ACK
-                            currentTCB->flags =  TCP_FIN_FLAG | TCP_ACK_FLAG;
-
-                            nextState = LAST_ACK;
-                            TCP_Snd(currentTCB);
-                        }
-                    }
-                    break;
-                case RCV_RST:
-                case RCV_RSTACK:                     
-                    currentTCB->flags = TCP_RST_FLAG;
-                    TCP_Snd(currentTCB);
-                    nextState = CLOSED;
-                    TCB_Reset(currentTCB);
-                    break;
-                case TIMEOUT:
-                    logMsg("ESTABLISHED:  timeout",LOG_INFO, LOG_DEST_CONSOLE);
-                    if (currentTCB->timeoutsCount)
-                    {
-                        TCP_TimoutRetransmit();	//jira: CAE_MCU8-6056
-                    }else
-                    {
-                        // reset the connection if there is no reply
-                        currentTCB->flags =   TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))    //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    }
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case FIN_WAIT_1:
-            switch (event)
-            {
-                case RCV_FIN:
-                    currentTCB->flags =  TCP_ACK_FLAG;
-                    if (currentTCB->remoteAck == tcpHeader.sequenceNumber)	//jira: M8TS-514, M8TS-538, M8TS-463	
-                    {
-                        currentTCB->bytesSent = 0;                   
-                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
-                        currentTCB->remoteAck = currentTCB->remoteAck + 1;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647
-                       {
-                           nextState = CLOSING;
-                       }
-                    }     
-                    break;
-                case RCV_ACK:
-                    logMsg("FIN_WAIT_1: rx_ack",LOG_INFO, LOG_DEST_CONSOLE);
-                    // stop the current timeout
-                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutsCount = 1;
-                    nextState = FIN_WAIT_2;
-                    break;
-                case RCV_FINACK:
-                    logMsg("FIN_WAIT_1: rx_finack",LOG_INFO, LOG_DEST_CONSOLE);
-                    currentTCB->flags =  TCP_ACK_FLAG;
-                    if (currentTCB->remoteAck == tcpHeader.sequenceNumber)	//jira: M8TS-514, M8TS-538, M8TS-463
-                    {
-                        currentTCB->bytesSent = 0;                   
-                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
-                        currentTCB->remoteAck = currentTCB->remoteAck + 1;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647
-                        {
-                            nextState = TIME_WAIT;
-                        }
-                    }
-                    break;
-                case TIMEOUT:
-                    logMsg("FIN_WAIT_1:  timeout",LOG_INFO, LOG_DEST_CONSOLE);
-                    if (currentTCB->timeoutsCount)
-                    {
-                        TCP_Snd(currentTCB);
-                    }else
-                    {
-                        // just reset the connection if there is no reply
-                        currentTCB->flags =   TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    }
-                    break;                    
-                default:
-                    break;
-            }
-            break;
-        case FIN_WAIT_2:
-            switch (event)
-            {
-                case RCV_FINACK:					 		//jira: M8TS-514, M8TS-538, M8TS-463                   
-                case RCV_FIN:
-                    logMsg("FIN_WAIT_2: rx_fin/rx_finack",LOG_INFO, LOG_DEST_CONSOLE);
-                    currentTCB->flags =  TCP_ACK_FLAG;					//jira: M8TS-514, M8TS-538, M8TS-463
-                    if (currentTCB->remoteAck == tcpHeader.sequenceNumber)
-                    {
-                        currentTCB->bytesSent = 0;                   
-                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
-                        currentTCB->remoteAck = currentTCB->remoteAck + 1;     
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647
-                        {
-                            nextState = TIME_WAIT;
-                        }   
-                    }
-                                 
-                    break;
-                case TIMEOUT:
-                    logMsg("FIN_WAIT_2:  timeout",LOG_INFO, LOG_DEST_CONSOLE);
-                    if (currentTCB->timeoutsCount)
-                    {
-                        TCP_Snd(currentTCB);
-                    }else
-                    {
-                        // just reset the connection if there is no reply
-                        currentTCB->flags =   TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    }
-                    break; 
-                default:
-                    break;
-            }
-            break;
-        case CLOSE_WAIT:
-            // This state is defined in RFC, but is not used in the application
-            break;
-        case CLOSING:
-            switch (event)
-            {
-                case RCV_ACK:
-                    logMsg("CLOSING: rx_ack",LOG_INFO, LOG_DEST_CONSOLE);
-                    nextState = TIME_WAIT;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case LAST_ACK:
-            // check if the packet belongs to the curent TCB
-            switch (event)
-            {
-                case RCV_FINACK:
-                case RCV_ACK:
-                    if ((currentTCB->destIP == receivedRemoteAddress) &&
-                        (currentTCB->destPort == tcpHeader.sourcePort))
-                    {
-                        logMsg("LAST_ACK: rx_ack",LOG_INFO, LOG_DEST_CONSOLE);
-                        nextState = CLOSED;
-                        TCB_Reset(currentTCB);
-                    }
-                    break;
-                case TIMEOUT:
-                    if (currentTCB->timeoutsCount)
-                    {
-                        TCP_Snd(currentTCB);
-                    }else
-                    {
-                        // just reset the connection if there is no reply
-                        currentTCB->flags =   TCP_RST_FLAG;
-                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))    //jira: CAE_MCU8-5647, CAE_MCU8-6056
-                        {
-                            nextState = CLOSED;
-                            TCB_Reset(currentTCB);
-                        }
-                    }
-                default:
-                    break;
-            }
-            break;
-        case TIME_WAIT:
-            logMsg("Time Wait",LOG_INFO, LOG_DEST_CONSOLE);
-            nextState = CLOSED;
-            TCB_Reset(currentTCB);
-            break;
-        case CLOSED:
-            switch (event)
-            {
-                case ACTIVE_OPEN:
-                    logMsg("CLOSED: active_open",LOG_INFO, LOG_DEST_CONSOLE);
-                    // create and send a SYN packet
-                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                    currentTCB->timeoutsCount = TCP_MAX_SYN_RETRIES;
-                    currentTCB->flags = TCP_SYN_FLAG;
-                    TCP_Snd(currentTCB);
-                    nextState = SYN_SENT;
-                    ret = SUCCESS;    //jira: CAE_MCU8-5647
-                    break;
-                case PASIVE_OPEN:
-                    logMsg("CLOSED: passive_open",LOG_INFO, LOG_DEST_CONSOLE);
-                    currentTCB->destIP = 0;
-                    currentTCB->destPort = 0;
-                    nextState = LISTEN;
-                    ret = SUCCESS;    //jira: CAE_MCU8-5647
-                    break;
-                default:
-                    break;
-            }
-            break;
-        default:
-            break;
-    }
-    currentTCB->connectionEvent = NOP; // we are handling the event...
-    currentTCB->fsmState = nextState;
-    return ret;
-}
-
-
-void TCP_Init(void)
-{
-    tcbList = NULL;
-    tcbListSize = 0;
-    nextAvailablePort = LOCAL_TCP_PORT_START_NUMBER;
-    nextSequenceNumber = 0;
-}
-
-error_msg TCP_SocketInit(tcpTCB_t *tcbPtr)   //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
-    
-    // verify that this socket is not in the list
-    if(TCB_Check(tcbPtr) == ERROR)    //jira: CAE_MCU8-5647
-    {
-        TCB_Reset(tcbPtr);
-
-        tcbPtr->localWnd = 0; // here we should put the RX buffer size
-        tcbPtr->mss = TCP_MAX_SEG_SIZE;
-        tcbPtr->fsmState = CLOSED;
-        tcbPtr->connectionEvent = NOP;
-        tcbPtr->rxBufferStart = NULL;
-        tcbPtr->rxBufState = NO_BUFF;
-        tcbPtr->txBufferStart = NULL;
-        tcbPtr->txBufferPtr = NULL;
-        tcbPtr->bytesToSend = 0;
-        tcbPtr->bytesSent = 0;
-        tcbPtr->payloadSave = false;
-        tcbPtr->txBufState = NO_BUFF;
-        tcbPtr->socketState = SOCKET_CLOSED;
-
-        TCB_Insert(tcbPtr);
-        ret = SUCCESS;   //jira: CAE_MCU8-5647
-    }
-    return ret;
-}
-
-error_msg TCP_SocketRemove(tcpTCB_t *tcbPtr)    //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;   //jira: CAE_MCU8-5647
-    
-    // verify that this socket is in the Closed State
-    if(TCP_SocketPoll(tcbPtr) == SOCKET_CLOSING)
-    {
-        TCB_Remove(tcbPtr);
-        ret = SUCCESS;    //jira: CAE_MCU8-5647
-    }
-    return ret;
-}
-
-socketState_t TCP_SocketPoll(tcpTCB_t *socket_ptr)
-{
-    socketState_t tmpSocketState;
-   
-    tmpSocketState = NOT_A_SOCKET;
-    
-    if (TCB_Check(socket_ptr) == SUCCESS)    //jira: CAE_MCU8-5647
-    {
-        tmpSocketState = socket_ptr->socketState;
-    }
-
-    return tmpSocketState;
-}
-
-
-error_msg TCP_Bind(tcpTCB_t *tcbPtr, uint16_t port)    //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
-
-    logMsg("tcp_bind",LOG_INFO, LOG_DEST_CONSOLE);
-
-    if (TCB_Check(tcbPtr) == SUCCESS)    //jira: CAE_MCU8-5647
-    {
-        tcbPtr->localPort = port;
-        ret = SUCCESS;   //jira: CAE_MCU8-5647
-    }
-    return ret;
-}
-
-
-error_msg TCP_Listen(tcpTCB_t *tcbPtr)    //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
-
-    logMsg("tcp_listen",LOG_INFO, LOG_DEST_CONSOLE);
-
-    if (TCB_Check(tcbPtr) == SUCCESS)    //jira: CAE_MCU8-5647
-    {
-        tcbPtr->connectionEvent = PASIVE_OPEN;
-        tcbPtr->socketState = SOCKET_IN_PROGRESS;
-        tcbPtr->localSeqno = nextSequenceNumber;
-        currentTCB = tcbPtr;
-        if (tcbPtr->localPort == 0)
-        {
-            tcbPtr->localPort = nextAvailablePort++;
-        }
-        ret = TCP_FiniteStateMachine();
-    }
-    return ret;
-}
-
-
-error_msg TCP_Connect(tcpTCB_t *tcbPtr, sockaddr_in4_t *srvaddr)   //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
-
-    if (TCP_SocketPoll(tcbPtr) == SOCKET_CLOSED)
-    {
-        tcbPtr->destIP = srvaddr->addr.s_addr;
-        tcbPtr->destPort = srvaddr->port;
-        if(tcbPtr->localPort == 0)
-        {
-            // use a "random" port for the local one
-            tcbPtr->localPort = nextAvailablePort++;
-        }
-
-        tcbPtr->fsmState = CLOSED;
-        tcbPtr->socketState = SOCKET_IN_PROGRESS;
-        tcbPtr->localSeqno = nextSequenceNumber;
-        tcbPtr->connectionEvent = ACTIVE_OPEN;
-
-        currentTCB = tcbPtr;
-        ret = TCP_FiniteStateMachine();
-    }
-
-    return ret;
-}
-
-
-error_msg TCP_Close(tcpTCB_t *tcbPtr)   //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
-
-    logMsg("tcp_close",LOG_INFO, LOG_DEST_CONSOLE);
-
-    if (TCB_Check(tcbPtr) == SUCCESS)    //jira: CAE_MCU8-5647
-    {
-        tcbPtr->connectionEvent = CLOSE;
-        
-
-        tcbPtr->txBufState = NO_BUFF;
-        tcbPtr->rxBufState = NO_BUFF;
-        tcbPtr->txBufferPtr = NULL;
-        tcbPtr->txBufferStart = NULL;
-        tcbPtr->rxBufferPtr = NULL;
-        tcbPtr->rxBufferStart = NULL;
-        tcbPtr->bytesToSend = 0;
-        tcbPtr->bytesSent = 0;
-        tcbPtr->payloadSave = false;
-
-        // likely to change this to a needs TX time queue
-        currentTCB = tcbPtr;
-        ret = TCP_FiniteStateMachine();
-    }
-    return ret;
-}
-
-
-error_msg TCP_Send(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t dataLen)    //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
-
-    if (TCP_SocketPoll(tcbPtr) == SOCKET_CONNECTED)
-    {
-        if (tcbPtr->txBufState == NO_BUFF)
-        {
-            if (data != NULL)
-            {
-                tcbPtr->txBufferStart = data;
-                tcbPtr->txBufferPtr = tcbPtr->txBufferStart;
-                tcbPtr->bytesToSend = dataLen;
-                tcbPtr->txBufState = TX_BUFF_IN_USE;
-                tcbPtr->bytesSent = dataLen;
-
-                tcbPtr->timeout = TCP_START_TIMEOUT_VAL; 
-                tcbPtr->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
-                tcbPtr->timeoutsCount = TCP_MAX_RETRIES;
-
-                tcbPtr->flags = TCP_ACK_FLAG;
-
-                TCP_Snd(tcbPtr);
-                ret = SUCCESS;    //jira: CAE_MCU8-5647
-            }
-        }
-    }
-    return ret;
-}
-
-
-error_msg TCP_SendDone(tcpTCB_t *tcbPtr)    //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;      //jira: CAE_MCU8-5647
-
-    if(TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
-    {
-        if (tcbPtr->txBufState == NO_BUFF)
-        {
-            ret = SUCCESS;   //jira: CAE_MCU8-5647
-        }
-    }
-    return ret;
-}
-
-error_msg TCP_InsertRxBuffer(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t data_len)     //jira: CAE_MCU8-5647
-{
-    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
-
-    if (TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
-    {
-        if (tcbPtr->rxBufState == NO_BUFF)
-        {
-            if (data != NULL)
-            {
-                tcbPtr->rxBufferStart = data;
-                tcbPtr->rxBufferPtr = tcbPtr->rxBufferStart;
-                tcbPtr->localWnd = data_len;  // update the available receive windows
-                tcbPtr->rxBufState = RX_BUFF_IN_USE;
-                ret = SUCCESS;    //jira: CAE_MCU8-5647
-            }
-        }
-    }
-    return ret;
-}
-
-
-int16_t TCP_GetReceivedData(tcpTCB_t *tcbPtr)
-{
-    int16_t ret = 0;
-
-    if (TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
-    {
-        if (tcbPtr->rxBufState == RX_BUFF_IN_USE)
-        {
-            ret = tcbPtr->rxBufferPtr - tcbPtr->rxBufferStart;
-
-            if (ret != 0)
-            {
-                tcbPtr->localWnd = 0;
-                tcbPtr->rxBufState = NO_BUFF;
-            }
-        }
-    }
-    return ret;
-}
-
-int16_t TCP_GetRxLength(tcpTCB_t *tcbPtr)
-{
-    int16_t ret = 0;
-
-    if (TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
-    {
-        if (tcbPtr->rxBufState == RX_BUFF_IN_USE)
-        {
-            ret = tcbPtr->rxBufferPtr - tcbPtr->rxBufferStart;
-        }
-    }
-    return ret;
-}
-
-void TCP_Update(void)
-{
-    tcpTCB_t *tcbPtr;
-    tcbPtr = NULL;
-    int count = 0;
-
-    // update sequence number and local port number in order to be different
-    // for each new connection
-    nextSequenceNumber++;
-
-    // keep local port number in the general port range
-    nextAvailablePort = nextAvailablePort + 1;
-    if (nextAvailablePort < LOCAL_TCP_PORT_START_NUMBER)
-    {
-        nextAvailablePort = LOCAL_TCP_PORT_START_NUMBER;
-    }
-    //TO DO also local seq number should be "random"
-
-    tcbPtr = tcbList;
-    while((tcbPtr != NULL) && (count < tcbListSize))
-    {
-        if (tcbPtr->timeout > 0)
-        {
-            logMsg("tcp timeout",LOG_INFO, LOG_DEST_CONSOLE);
-            tcbPtr->timeout = tcbPtr->timeout - 1;
-
-            if (tcbPtr->timeout == 0)
-            {
-                // MAKE sure we don't overwrite anything else
-                if (tcbPtr->connectionEvent == NOP)
-                {
-                    int retries = TCP_MAX_RETRIES - tcbPtr->timeoutsCount; // Jira: CAE_MCU8-5772
-                    if(retries < 0){
-                        retries = 0;
-                    }
-                    tcbPtr->timeout = tcbPtr->timeoutReloadValue << retries; 
-                    //if not zero
-                    if (tcbPtr->timeoutsCount != 0)
-                        tcbPtr->timeoutsCount = tcbPtr->timeoutsCount - 1u;  //jira: CAE_MCU8-5647
-                    tcbPtr->connectionEvent = TIMEOUT;
-                    currentTCB = tcbPtr;
-                    TCP_FiniteStateMachine();
-                }
-            }
-        }
-        tcbPtr = tcbPtr->nextTCB;
-        count ++;
-    }
-}
-
-static error_msg TCP_TimoutRetransmit(void)	//jira: CAE_MCU8-6056
-{
-    currentTCB->txBufferPtr -= tcpDataLength;
-    txBufferPtrForRetransmit = currentTCB->txBufferPtr;
-    bytesToSendForRetransmit = tcpDataLength;
-    currentTCB->localSeqno = localSeqnoForRetransmit;
-    lastAckNumber = tcpHeader.ackNumber;
-    return TCP_Snd(currentTCB);
+/**
+    Transmission Control Protocol (TCP) version4 implementation
+    
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    tcpv4.c
+
+  Summary:
+    This is the implementation of for TCP version 4 stack
+
+  Description:
+    This header file provides the implementation of the API for the TCP v4 stack.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "ipv4.h"
+#include "tcpv4.h"
+#include "network.h"
+#include "ethernet_driver.h"
+#include "tcpip_types.h"
+#include "log.h"
+#include "tcpip_config.h"
+#include "icmp.h"
+#include "net_stats.h"
+#include "net_profile.h"
+#include "../tmr1.h"
+
+tcpTCB_t *tcbList;
+socklistsize_t tcbListSize;
+tcpTCB_t *currentTCB;
+tcpLookupStats_t tcpLookupStats;
+
+static tcpTCB_t *tcbHash[TCP_TCB_HASH_BUCKETS];
+
+// TMR1 periods of a time in ms, rounded up
+#define TCP_MS_TO_PERIODS(ms)   (((ms) + TMR1_PERIOD_MS - 1u) / TMR1_PERIOD_MS)
+
+#define TCP_DELAYED_ACK_PERIODS TCP_MS_TO_PERIODS(TCP_DELAYED_ACK_MS)
+#define TCP_RTO_MIN             TCP_MS_TO_PERIODS(TCP_RTO_MIN_MS)
+#define TCP_RTO_MAX             TCP_MS_TO_PERIODS(TCP_RTO_MAX_MS)
+#define TCP_RTO_INITIAL         TCP_MS_TO_PERIODS(TCP_RTO_INITIAL_MS)
+
+static tcpHeader_t tcpHeader;
+static uint16_t tcpTicks;           // TCP_Update() calls, the clock of the round trip times
+static uint16_t nextAvailablePort;
+static uint32_t nextSequenceNumber;
+
+static uint32_t receivedRemoteAddress;
+static uint16_t rcvPayloadLen;
+static bool rcvPayloadStaged;   // the payload was copied to the RX buffer while checking the segment
+static uint16_t rcvPayloadLeft;  // payload bytes a receive handler has not consumed yet
+static uint16_t tcpMss = 536;
+
+//jira: CAE_MCU8-6056
+static uint16_t tcpDataLength;
+
+#ifdef ENABLE_NETWORK_DEBUG
+#define logMsg(event, msgSeverity)    LOG_Event(event, LOG_KERN, msgSeverity, 0, 0)
+#else
+#define logMsg(event, msgSeverity)
+#endif
+
+static error_msg TCP_FiniteStateMachine(void);  //jira: CAE_MCU8-5647
+
+static error_msg TCP_TimoutRetransmit(void);
+
+static void TCP_SndData(tcpTCB_t *tcbPtr);
+
+static void TCP_ListenerQueue(tcpTCB_t *tcbPtr);
+
+#ifndef TCP_TX_IN_APP_RAM
+/** Give the copy of the tx buffer back to the SRAM heap.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_TxBlockRelease(tcpTCB_t *tcbPtr)
+{
+    SRAM_Free(tcbPtr->txBlock);
+    tcbPtr->txBlock = SRAM_NO_BLOCK;
+}
+
+/** Append the payload of the segment from the copy of the tx buffer.
+ *  The bytes are moved by the DMA, so they are not part of the running TX
+ *  checksum; their sum is kept and reused while the same bytes are sent
+ *  again.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @param offset
+ *      position of the payload in the tx buffer
+ *
+ * @return
+ *      sum of the payload, not inverted
+ */
+static uint16_t TCP_TxBlockCopy(tcpTCB_t *tcbPtr, uint16_t offset)
+{
+    if ((offset != tcbPtr->txSumOffset) || (tcpDataLength != tcbPtr->txSumLength))
+    {
+        tcbPtr->txSum = SRAM_Checksum(tcbPtr->txBlock, offset, tcpDataLength);
+        tcbPtr->txSumOffset = offset;
+        tcbPtr->txSumLength = tcpDataLength;
+    }
+    SRAM_CopyToTx(tcbPtr->txBlock, offset, tcpDataLength);
+    return tcbPtr->txSum;
+}
+#endif
+
+/** Bytes sent and not acknowledged yet.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      localSeqno less the oldest byte not acknowledged
+ */
+static uint16_t TCP_BytesInFlight(tcpTCB_t *tcbPtr)
+{
+    return (uint16_t)(tcbPtr->localSeqno - (tcbPtr->localLastAck + 1));
+}
+
+/** Note a segment with payload that was sent.
+ *  The segments follow each other from localLastAck + 1 on, so their
+ *  lengths give the sequence range of each one.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @param length
+ *      payload of the segment
+ *
+ * @return
+ *      None
+ */
+static void TCP_SegmentSent(tcpTCB_t *tcbPtr, uint16_t length)
+{
+    uint8_t i;
+
+    if (tcbPtr->segCount < TCP_MAX_SEGMENTS_IN_FLIGHT)
+    {
+        i = tcbPtr->segHead + tcbPtr->segCount;
+        if (i >= TCP_MAX_SEGMENTS_IN_FLIGHT)
+        {
+            i = i - TCP_MAX_SEGMENTS_IN_FLIGHT;
+        }
+        tcbPtr->segLength[i] = length;
+        tcbPtr->segCount++;
+    }
+    else
+    {
+        // keep the count right, the newest segment grows
+        i = tcbPtr->segHead + tcbPtr->segCount - 1u;
+        if (i >= TCP_MAX_SEGMENTS_IN_FLIGHT)
+        {
+            i = i - TCP_MAX_SEGMENTS_IN_FLIGHT;
+        }
+        tcbPtr->segLength[i] = tcbPtr->segLength[i] + length;
+    }
+}
+
+/** Drop the acknowledged segments.
+ *  A partial ACK leaves the rest of its segment as the oldest one in flight.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @param acked
+ *      bytes the ACK covers beyond localLastAck + 1
+ *
+ * @return
+ *      None
+ */
+static void TCP_SegmentsAcked(tcpTCB_t *tcbPtr, uint16_t acked)
+{
+    while ((acked != 0) && (tcbPtr->segCount != 0))
+    {
+        if (acked < tcbPtr->segLength[tcbPtr->segHead])
+        {
+            tcbPtr->segLength[tcbPtr->segHead] = tcbPtr->segLength[tcbPtr->segHead] - acked;
+            break;
+        }
+        acked = acked - tcbPtr->segLength[tcbPtr->segHead];
+        tcbPtr->segHead++;
+        if (tcbPtr->segHead == TCP_MAX_SEGMENTS_IN_FLIGHT)
+        {
+            tcbPtr->segHead = 0;
+        }
+        tcbPtr->segCount--;
+    }
+}
+
+/** Forget the segments in flight, they are sent again from localLastAck + 1.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_SegmentsClear(tcpTCB_t *tcbPtr)
+{
+    tcbPtr->segHead = 0;
+    tcbPtr->segCount = 0;
+}
+
+/** Time the round trip of a segment, one at a time.  Bytes that were sent
+ *  before are not timed, their ACK may be for either copy (Karn's rule).
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @param length
+ *      payload of the segment, sent from localSeqno on
+ *
+ * @return
+ *      None
+ */
+static void TCP_RttStart(tcpTCB_t *tcbPtr, uint16_t length)
+{
+    if (!tcbPtr->rttTiming && ((int32_t)(tcbPtr->localSeqno - tcbPtr->rttSeqno) >= 0))
+    {
+        tcbPtr->rttSeqno = tcbPtr->localSeqno + length;
+        tcbPtr->rttStart = tcpTicks;
+        tcbPtr->rttTiming = true;
+    }
+}
+
+/** End the round trip being timed once the ACK covers its segment and
+ *  compute the time-out of the data from it the RFC 6298 way,
+ *  SRTT + max(G, 4 * RTTVAR) with G one TMR1 period, using Jacobson's
+ *  scaled sums.  The round trip is counted in TCP_Update() calls like the
+ *  time-out itself, a sample over TCP_RTO_MAX counts as TCP_RTO_MAX.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @param ackNumber
+ *      acknowledgment number of the received segment
+ *
+ * @return
+ *      None
+ */
+static void TCP_RttAcked(tcpTCB_t *tcbPtr, uint32_t ackNumber)
+{
+    int16_t delta;
+    uint16_t rto;
+    uint16_t rtt;
+
+    if (!tcbPtr->rttTiming || ((int32_t)(ackNumber - tcbPtr->rttSeqno) < 0))
+    {
+        return;
+    }
+    tcbPtr->rttTiming = false;
+    rtt = tcpTicks - tcbPtr->rttStart;
+    if (rtt > TCP_RTO_MAX)
+    {
+        rtt = TCP_RTO_MAX;
+    }
+
+    if (tcbPtr->srtt == 0)
+    {
+        // SRTT = R, RTTVAR = R / 2
+        tcbPtr->srtt = rtt << 3;
+        tcbPtr->rttVar = rtt << 1;
+    }
+    else
+    {
+        // SRTT += (R - SRTT) / 8, RTTVAR += (|R - SRTT| - RTTVAR) / 4
+        delta = (int16_t)rtt - (int16_t)(tcbPtr->srtt >> 3);
+        tcbPtr->srtt = (uint16_t)((int16_t)tcbPtr->srtt + delta);
+        if (delta < 0)
+        {
+            delta = -delta;
+        }
+        tcbPtr->rttVar = tcbPtr->rttVar - (tcbPtr->rttVar >> 2) + (uint16_t)delta;
+    }
+
+    rto = (tcbPtr->srtt >> 3) + ((tcbPtr->rttVar > 1u) ? tcbPtr->rttVar : 1u);
+    if (rto < TCP_RTO_MIN)
+    {
+        rto = TCP_RTO_MIN;
+    }
+    else if (rto > TCP_RTO_MAX)
+    {
+        rto = TCP_RTO_MAX;
+    }
+    tcbPtr->rto = rto;
+}
+
+/** Lookup bucket of a connection.  A socket that is not connected has no
+ *  remote address and port and so shares the bucket of its local port with
+ *  the other sockets listening there.
+ *
+ * @param address
+ *      remote IP address
+ *
+ * @param remotePort
+ *      remote port
+ *
+ * @param localPort
+ *      local port
+ *
+ * @return
+ *      bucket index
+ */
+static uint8_t TCB_Hash(uint32_t address, uint16_t remotePort, uint16_t localPort)
+{
+    uint16_t key;
+
+    key = (uint16_t)address ^ (uint16_t)(address >> 16) ^ remotePort ^ localPort;
+    return (uint8_t)(key ^ (key >> 8)) & (uint8_t)(TCP_TCB_HASH_BUCKETS - 1u);
+}
+
+/** Link the TCB into the lookup bucket of its current addresses.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCB_HashLink(tcpTCB_t *tcbPtr)
+{
+    tcbPtr->hashBucket = TCB_Hash(tcbPtr->destIP, tcbPtr->destPort, tcbPtr->localPort);
+    tcbPtr->nextHash = tcbHash[tcbPtr->hashBucket];
+    tcbHash[tcbPtr->hashBucket] = tcbPtr;
+}
+
+/** Take the TCB out of its lookup bucket.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCB_HashUnlink(tcpTCB_t *tcbPtr)
+{
+    tcpTCB_t **link;
+
+    link = &tcbHash[tcbPtr->hashBucket];
+    while (*link != NULL)
+    {
+        if (*link == tcbPtr)
+        {
+            *link = tcbPtr->nextHash;
+            break;
+        }
+        link = (tcpTCB_t **)&((*link)->nextHash);
+    }
+    tcbPtr->nextHash = NULL;
+}
+
+/** Move the TCB to the lookup bucket of its addresses after they changed.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCB_Rehash(tcpTCB_t *tcbPtr)
+{
+    if (tcbPtr->hashBucket != TCB_Hash(tcbPtr->destIP, tcbPtr->destPort, tcbPtr->localPort))
+    {
+        TCB_HashUnlink(tcbPtr);
+        TCB_HashLink(tcbPtr);
+    }
+}
+
+/** Find the socket of a received segment: the connection with the same
+ *  remote address, remote port and local port, or else a socket without a
+ *  remote end on the local port, a listening one first.
+ *
+ * @param address
+ *      remote IP address
+ *
+ * @param remotePort
+ *      remote port
+ *
+ * @param localPort
+ *      local port
+ *
+ * @return
+ *      pointer to the socket/TCB structure, NULL if there is none
+ */
+static tcpTCB_t *TCB_Lookup(uint32_t address, uint16_t remotePort, uint16_t localPort)
+{
+    tcpTCB_t *tcbPtr;
+    tcpTCB_t *found = NULL;
+
+    tcpLookupStats.lookups++;
+    tcbPtr = tcbHash[TCB_Hash(address, remotePort, localPort)];
+    while (tcbPtr != NULL)
+    {
+        tcpLookupStats.compares++;
+        if ((tcbPtr->localPort == localPort) && (tcbPtr->destPort == remotePort) && (tcbPtr->destIP == address))
+        {
+            return tcbPtr;
+        }
+        tcbPtr = tcbPtr->nextHash;
+    }
+
+    tcbPtr = tcbHash[TCB_Hash(0, 0, localPort)];
+    while (tcbPtr != NULL)
+    {
+        tcpLookupStats.compares++;
+        if ((tcbPtr->localPort == localPort) && (tcbPtr->destIP == 0))
+        {
+            if (tcbPtr->fsmState == LISTEN)
+            {
+                return tcbPtr;
+            }
+            if (found == NULL)
+            {
+                found = tcbPtr;
+            }
+        }
+        tcbPtr = tcbPtr->nextHash;
+    }
+    return found;
+}
+
+/** The function will insert a pointer to the new TCB into the TCB pointer list.
+ *
+ *  @param ptr
+ *      pointer to the user allocated memory for the TCB structure
+ *
+ * @return
+ *      Status of the function
+ */
+static void TCB_Insert(tcpTCB_t *ptr)
+{
+    // Insert the new TCB at the head of the list.
+    // This prevents a list traversal and saves time.
+    if(tcbList != NULL)
+    {
+        // link this TCB as the previous one for the top of the list
+        tcbList->prevTCB = ptr;
+    }
+    ptr->nextTCB = tcbList; // put the existing list at the end of this tcb...
+    tcbList = ptr;           // put this tcb at the head of the list.
+    ptr->prevTCB = NULL;     // make sure that the upstream pointer is empty
+    tcbListSize ++;
+    TCB_HashLink(ptr);
+}
+
+/** The function will remove a pointer to a TCB from the TCB pointer list
+ *  and connect any TCB's before & behind together.
+ *
+ *  @param ptr
+ *      pointer to the user allocated memory for the TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCB_Remove(tcpTCB_t *ptr)
+{
+    TCB_HashUnlink(ptr);
+    if(tcbListSize > 0)
+    {
+        // check if this is the first in list
+        if(ptr->prevTCB == NULL)
+        {
+            tcbList = ptr->nextTCB;
+        } else
+        {
+            ((tcpTCB_t *)(ptr->prevTCB))->nextTCB = ptr->nextTCB;
+        }
+        // or the last one
+        if(ptr->nextTCB != NULL)
+        {
+            ((tcpTCB_t *)(ptr->nextTCB))->prevTCB = ptr->prevTCB;
+        }
+        tcbListSize --;
+    }
+}
+
+/** Reseting the socket to a known state.
+ * 
+ * @param tcbPtr 
+ *      pointer to socket/TCB structure
+ * 
+ * @return
+ *      None
+ */
+static void TCB_Reset(tcpTCB_t *tcbPtr)
+{
+    tcbPtr->destIP = 0;
+    tcbPtr->destPort = 0;
+    tcbPtr->localSeqno = 0;
+    tcbPtr->localLastAck = 0;
+    tcbPtr->remoteSeqno = 0;
+    tcbPtr->remoteAck = 0;
+    tcbPtr->remoteWnd = 0;
+
+    tcbPtr->timeout = 0;
+    tcbPtr->timeoutReloadValue = 0;
+    tcbPtr->timeoutsCount = 0;
+    tcbPtr->srtt = 0;
+    tcbPtr->rttVar = 0;
+    tcbPtr->rto = TCP_RTO_INITIAL;
+    tcbPtr->rttTiming = false;
+    tcbPtr->rtoWaited = 0;
+    tcbPtr->flags = 0;
+    tcbPtr->ackPending = 0;
+    
+    tcbPtr->localPort = 0;
+    tcbPtr->bytesSent = 0;
+    TCP_SegmentsClear(tcbPtr);
+    tcbPtr->payloadSave = false;
+    tcbPtr->socketState = SOCKET_CLOSING;
+}
+
+/** Check is a pointer to a socket/TCB. If the pointer is in the TCB list
+ *  then it is a valid socket.
+ * 
+ * @param tcbPtr 
+ *      pointer to socket/TCB structure
+ * 
+ * @return
+ *      None
+ */
+static error_msg TCB_Check(tcpTCB_t *ptr)   //jira: CAE_MCU8-5647
+{
+    tcpTCB_t *tcbPtr;
+    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
+    socklistsize_t count = 0;
+    
+    if((tcbList != NULL) && (ptr != NULL))
+    {
+        // search for ptr into the active TCB/sockets list
+        tcbPtr = tcbList;
+        while((tcbPtr != NULL) && (count < tcbListSize))
+        {
+            if (tcbPtr == ptr)
+            {
+                ret = SUCCESS;   //jira: CAE_MCU8-5647
+                break;
+            }
+            else
+            {
+                tcbPtr = tcbPtr->nextTCB;
+                count ++;
+            }
+        }        
+    }
+    return ret;
+}
+
+
+/** Internal function of the TCP Stack to send an TCP packet.
+ * 
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      true - The buffer was send successfully
+ * @return
+ *      false - Send buffer fails.
+ */
+static error_msg TCP_Snd(tcpTCB_t *tcbPtr)   //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;
+    tcpHeader_t txHeader;
+    uint16_t payloadLength;
+    uint16_t cksm;
+    uint16_t window;
+    uint32_t seed;
+    uint8_t *data;
+    NET_PROFILE_START(start);
+
+    txHeader.sourcePort = htons(tcbPtr->localPort);
+    txHeader.destPort = htons(tcbPtr->destPort);
+
+    txHeader.sequenceNumber = htonl(tcbPtr->localSeqno);
+
+    txHeader.ackNumber = htonl(tcbPtr->remoteAck); //ask for next packet
+
+    txHeader.ns = 0;          // make sure we clean unused fields
+    txHeader.reserved = 0;    // make sure we clean unused fields
+    txHeader.dataOffset = 5;  // We don't support options for now
+    txHeader.windowSize = htons(tcbPtr->localWnd);
+    txHeader.checksum = 0;
+    txHeader.urgentPtr = 0;
+
+    if ((tcbPtr->flags) & (TCP_SYN_FLAG | TCP_RST_FLAG))
+    {
+        tcpDataLength = 0; // SYN and RST packets doesn't have any payload
+    } 
+    else if(tcbPtr->payloadSave == true)
+    {
+        tcpDataLength = 0;
+    }else
+    {
+        tcpDataLength = tcbPtr->bytesSent;
+
+        if (tcpDataLength != 0)
+        {
+            // what the remote window leaves beyond the bytes in flight,
+            // probe a closed window with one byte
+            window = TCP_BytesInFlight(tcbPtr);
+            window = (tcbPtr->remoteWnd > window) ? tcbPtr->remoteWnd - window : 0;
+            if(window == 0)
+            {
+                window = 1;
+            }
+            if(tcpDataLength > window)
+            {
+                tcpDataLength = window;
+            }
+
+            if(tcpDataLength > tcbPtr->mss)
+            {
+                tcpDataLength = tcbPtr->mss;
+            }
+            data = tcbPtr->txBufferPtr;
+
+            // update the pointer to the next byte that needs to be sent
+            tcbPtr->txBufferPtr = tcbPtr->txBufferPtr + tcpDataLength;
+            tcbPtr->bytesToSend = tcbPtr->bytesSent - tcpDataLength;
+
+            if (tcbPtr->bytesToSend == 0)
+            {
+                tcbPtr->flags = tcbPtr->flags | TCP_PSH_FLAG;
+            }
+        }
+    }
+    //update the TCP Flags
+    txHeader.flags = tcbPtr->flags;
+    payloadLength = sizeof(tcpHeader_t) + tcpDataLength;
+
+    ret = IPv4_Start(tcbPtr->destIP, TCP_TCPIP, payloadLength);
+    if (ret == SUCCESS)
+    {
+        // a segment without data may pass queued data, unless it ends the stream
+        if ((tcpDataLength == 0) && !(tcbPtr->flags & (TCP_FIN_FLAG | TCP_RST_FLAG)))
+        {
+            ETH_SetTxClass(ETH_TX_CONTROL);
+        }
+        ETH_WriteBlock((char *) &txHeader, sizeof(tcpHeader_t));   //jira: M8TS-608
+
+        seed = payloadLength + TCP_TCPIP;
+        if (tcpDataLength > 0)
+        {
+#ifndef TCP_TX_IN_APP_RAM
+            if (tcbPtr->txBlock != SRAM_NO_BLOCK)
+            {
+                seed += TCP_TxBlockCopy(tcbPtr, data - tcbPtr->txBufferStart);
+            }
+            else
+#endif
+            {
+                ETH_WriteBlock((char *) data, tcpDataLength);   //jira: M8TS-608
+            }
+        }
+
+        // wrap the seed
+        while (seed >> 16)
+        {
+            seed = (seed & 0x0FFFF) + (seed >> 16);
+        }
+        // The TCP checksum was summed while the segment was written
+        cksm = ETH_TxChecksumGet((uint16_t)seed);
+        ETH_Insert((char *)&cksm, 2, sizeof(ethernetFrame_t) + sizeof(ipv4Header_t) + offsetof(tcpHeader_t,checksum));
+
+        ret = IPV4_Send(payloadLength);        
+//        tcbPtr->txBufferPtr = tcbPtr->txBufferPtr - tcpDataLength;
+    }
+
+    // The packet wasn't transmitted
+    // Use the timeout to retry again later
+    if (ret != SUCCESS && ret != TX_QUEUED)	// jira: CAE_MCU8-5647, CAE_MCU8-6056
+    {
+        // make sure we keep the remaining timeouts and skip this send  that failed
+        // try at least once
+        tcbPtr->timeoutsCount = tcbPtr->timeoutsCount - 1u; // CAE_MCU8-5749, CAE_MCU8-5647
+
+        // the payload goes out with the retry
+        tcbPtr->txBufferPtr = tcbPtr->txBufferPtr - tcpDataLength;
+        tcbPtr->bytesToSend = tcbPtr->bytesToSend + tcpDataLength;
+
+        if (tcbPtr->timeout == 0)
+        {
+            tcbPtr->timeout = TCP_START_TIMEOUT_VAL;
+        }
+    }
+    else
+    {
+        if (tcpDataLength > 0)
+        {
+            TCP_RttStart(tcbPtr, tcpDataLength);
+        }
+        //if the packet was sent increment the Seqno.
+        tcbPtr->localSeqno = tcbPtr->localSeqno + tcpDataLength;
+        // the received data is acknowledged with it
+        if (tcbPtr->flags & TCP_ACK_FLAG)
+        {
+            tcbPtr->ackPending = 0;
+        }
+        if (tcpDataLength > 0)
+        {
+            TCP_SegmentSent(tcbPtr, tcpDataLength);
+        }
+        logMsg(LOG_EV_TCP_PACKET_SENT, LOG_INFO);
+    }
+
+    NET_PROFILE_STOP(NET_PROFILE_TCP_SND, start);
+    return ret;
+}
+
+/** Send the data of the TX buffer that the remote window and the in-flight
+ *  limit let out, one segment after the other.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_SndData(tcpTCB_t *tcbPtr)
+{
+    error_msg ret;
+    uint16_t inFlight;
+
+    while ((tcbPtr->bytesToSend != 0) && (tcbPtr->segCount < TCP_MAX_SEGMENTS_IN_FLIGHT))
+    {
+        // a closed window is probed once nothing is in flight
+        inFlight = TCP_BytesInFlight(tcbPtr);
+        if ((inFlight != 0) && (inFlight >= tcbPtr->remoteWnd))
+        {
+            break;
+        }
+        tcbPtr->bytesSent = tcbPtr->bytesToSend;
+        ret = TCP_Snd(tcbPtr);
+        if ((ret != SUCCESS) && (ret != TX_QUEUED))
+        {
+            break;
+        }
+    }
+}
+
+/** Send an ACK without data now.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_AckNow(tcpTCB_t *tcbPtr)
+{
+    tcbPtr->flags = TCP_ACK_FLAG;
+    tcbPtr->payloadSave = true;
+    TCP_Snd(tcbPtr);
+    tcbPtr->payloadSave = false;
+}
+
+/** Acknowledge a received segment the RFC 1122 way: every second segment
+ *  at once, otherwise with the next segment sent or TCP_DELAYED_ACK_MS
+ *  later, whichever comes first.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_AckDelayed(tcpTCB_t *tcbPtr)
+{
+    if (tcbPtr->ackPending == 0)
+    {
+        tcbPtr->ackDue = timer1Periods + (uint8_t)TCP_DELAYED_ACK_PERIODS;
+    }
+    tcbPtr->ackPending++;
+    if ((tcbPtr->ackPending >= 2u) || (TCP_DELAYED_ACK_PERIODS == 0u))
+    {
+        TCP_AckNow(tcbPtr);
+    }
+}
+
+/** Internal function of the TCP Stack. Will copy the TCP packet payload to 
+ * the socket RX buffer. This function will also send the ACK for
+ * the received packet and any ready to be send data.
+ * 
+ * @param len
+ *      length of the payload received
+ * 
+ * @return
+ *      true - The payload was copied to RX buffer successfully
+ * @return
+ *      false - Copying the payload failed.
+ */
+error_msg TCP_PayloadSave(uint16_t len)   //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;   //jira: CAE_MCU8-5647
+    uint16_t buffer_size;
+
+    // the handler reads the payload in place, only what it consumed is acknowledged
+    if (currentTCB->rxBufState == RX_HANDLER_IN_USE)
+    {
+        rcvPayloadLeft = len;
+        currentTCB->rxHandler(len);
+        buffer_size = len - rcvPayloadLeft;
+        rcvPayloadLeft = 0;
+
+        currentTCB->remoteAck = currentTCB->remoteSeqno + buffer_size;
+
+        TCP_AckDelayed(currentTCB);
+        ret = SUCCESS;
+    }
+    // check if we have a valid buffer
+    else if (currentTCB->rxBufState == RX_BUFF_IN_USE)
+    {
+        // make sure we have enough space
+        if (currentTCB->localWnd >= len)
+        {
+            buffer_size = len;
+        }else
+        {
+            buffer_size = currentTCB->localWnd;
+        }
+        
+        // the payload is already in place if it was staged by TCP_RxChecksumVerify
+        if (rcvPayloadStaged == false)
+        {
+            ETH_ReadBlock(currentTCB->rxBufferPtr, buffer_size);
+        }
+        currentTCB->rxBufferPtr =  currentTCB->rxBufferPtr + buffer_size;
+
+        //update the local window to inform the remote of the available space
+        currentTCB->localWnd =  currentTCB->localWnd - buffer_size;
+        currentTCB->remoteAck = currentTCB->remoteSeqno + buffer_size;
+
+        // the ACK waits a little for the reply of the application
+        TCP_AckDelayed(currentTCB);
+        ret = SUCCESS;    //jira: CAE_MCU8-5647
+    }
+    return ret;
+}
+
+
+/** This function checks the TCP checksum of the received segment.
+ *  The header was summed when it was read. A payload that follows a plain
+ *  header is copied into the free part of the socket RX buffer while it is
+ *  summed, so every byte is read once; it only becomes visible to the
+ *  application when TCP_PayloadSave() commits it. Anything else is summed
+ *  by the DMA without moving the read pointer.
+ *
+ * @param length
+ *      Length of the TCP segment
+ *
+ * @return
+ *      SUCCESS - The checksum is correct
+ * @return
+ *      TCP_CHECKSUM_FAILS - The segment must be dropped
+ */
+static error_msg TCP_RxChecksumVerify(uint16_t length)
+{
+    uint16_t staged = 0;
+
+    if ((rcvPayloadLen > 0) && (tcpHeader.dataOffset == 5) &&
+        (currentTCB->rxBufState == RX_BUFF_IN_USE))
+    {
+        // same amount TCP_PayloadSave will accept
+        staged = (currentTCB->localWnd >= rcvPayloadLen) ? rcvPayloadLen : currentTCB->localWnd;
+        ETH_ReadBlockChecksum(currentTCB->rxBufferPtr, staged);
+        rcvPayloadStaged = true;
+    }
+    ETH_RxChecksumAhead(length - sizeof(tcpHeader_t) - staged);
+
+    if (ETH_RxChecksumGet() != 0)
+    {
+        rcvPayloadStaged = false;
+        return TCP_CHECKSUM_FAILS;
+    }
+    return SUCCESS;
+}
+
+/** This function will read and parse the OPTIONS field in TCP header.
+ *  Each TCP header could have the options field.
+ *  we will read only the ones that has SYN or SYN + ACK
+ *  for the other TCP headers the options will be skipped.
+ *
+ * @param 
+ *      None
+ *  
+ * @return
+ *      true - parsing the options filed was successfully
+ * @return
+ *      false - parsing the options filed was failed.
+ */
+static error_msg TCP_ParseTCPOptions(void)   //jira: CAE_MCU8-5647
+{
+    uint8_t  opt;
+    uint16_t tcpOptionsSize;
+    error_msg ret;     //jira: CAE_MCU8-5647
+
+    ret = ERROR;      //jira: CAE_MCU8-5647
+    // Check for the option fields in TCP header
+    tcpOptionsSize = (uint16_t)(tcpHeader.dataOffset << 2u) - (uint16_t)sizeof(tcpHeader_t);   //jira: CAE_MCU8-5647
+
+    if (tcpOptionsSize > 0)
+    {
+        // RFC 1122, page 85, Section 4.2.2.6  Maximum Segment Size Option: RFC-793 Section 3.1
+        // more explanations in RFC-6691
+        tcpMss = 536;
+        // parse the option only for SYN segments
+        if(tcpHeader.syn)
+        {
+            // Parse for the TCP MSS option, if present.
+            while(tcpOptionsSize--)
+            {
+                opt = ETH_Read8();
+                switch (opt)
+                {
+                    case TCP_EOP:
+                        // End of options.
+                        if (tcpOptionsSize)
+                        {
+                            // dump remaining unused bytes
+                            ETH_Dump(tcpOptionsSize);
+                            tcpOptionsSize = 0;
+                        }
+                        ret = SUCCESS;    //jira: CAE_MCU8-5647
+                        break;
+                    case TCP_NOP:
+                        // NOP option.
+                        break;
+                    case TCP_MSS:
+                        if (tcpOptionsSize >= 3) // at least 3 more bytes
+                        {
+                            opt = ETH_Read8();
+                            if (opt == 0x04)
+                            {
+                                // An MSS option with the right option length.
+                                tcpMss = ETH_Read16(); // value returned in host endianess
+                                // Advance to the next option
+                                tcpOptionsSize = tcpOptionsSize - 3;
+
+                                // Limit the mss to the configured TCP_MAX_SEG_SIZE
+                                if (tcpMss > TCP_MAX_SEG_SIZE)
+                                {
+                                    tcpMss = TCP_MAX_SEG_SIZE;
+                                }
+                                // so far so good
+                                ret = SUCCESS;    //jira: CAE_MCU8-5647
+                            }else
+                            {
+                                // Bad option size length
+                                logMsg(LOG_EV_TCP_OPT_BAD_SIZE, LOG_INFO);
+                                // unexpected error
+                                tcpOptionsSize = 0;
+                                ret = ERROR;     //jira: CAE_MCU8-5647
+                            }
+                        }else
+                        {
+                            // unexpected error
+                            tcpOptionsSize = 0;
+                            ret = ERROR;     //jira: CAE_MCU8-5647
+                        }
+                        break;
+                    default:
+                        logMsg(LOG_EV_TCP_OPT_OTHER, LOG_INFO);
+                        opt = ETH_Read8();
+                        tcpOptionsSize--;
+
+                        if (opt > 1) // this should be at least 2 to be valid
+                        {
+                            // adjust for the remaining bytes for the current option
+                            opt = opt - 2u;    //jira: CAE_MCU8-5647
+                            if (opt <= tcpOptionsSize)
+                            {
+                                // All other options have a length field, so that we easily can skip them.
+                                ETH_Dump(opt);
+                                tcpOptionsSize = tcpOptionsSize - opt;
+                                ret = SUCCESS;    //jira: CAE_MCU8-5647
+                            }else
+                            {
+                                logMsg(LOG_EV_TCP_OPT_BAD_LENGTH, LOG_INFO);
+                                // the options are malformed and we don't process them further.
+                                tcpOptionsSize = 0;
+                                ret = ERROR;     //jira: CAE_MCU8-5647
+                            }
+                        }else
+                        {
+                            logMsg(LOG_EV_TCP_OPT_BAD_TOTAL, LOG_INFO);
+                            // If the length field is zero, the options are malformed
+                            // and we don't process them further.
+                            tcpOptionsSize = 0;
+                            ret = ERROR;     //jira: CAE_MCU8-5647
+                        }
+                        break;
+                }
+            }
+        }else // jump over the Options from TCP header
+        {
+            ETH_Dump(tcpOptionsSize);
+            ret = SUCCESS;    //jira: CAE_MCU8-5647
+        }
+    }else
+    {
+        ret = SUCCESS;    //jira: CAE_MCU8-5647
+    }
+
+    return ret;
+}
+
+/** This function will be called by the IP layer for each received TCP packet.
+ * It will identify the destination socket and also parse the TCP header.
+ * 
+ * @param remoteAddress
+ *      Source IP address for the received TCP packet
+ * 
+ * @param length
+ *      Length of the TCP payload
+ * 
+ * @param cksm
+ *      Pseudo header checksum, the segment is checked here
+ * 
+ * @return
+ *      None
+ */
+void TCP_Recv(uint32_t remoteAddress, uint16_t length, uint16_t cksm)
+{
+    //make sure we will not reuse old values
+    receivedRemoteAddress = 0;
+    rcvPayloadLen = 0;
+    rcvPayloadStaged = false;
+
+    if (length < sizeof(tcpHeader_t))
+    {
+        return;
+    }
+
+    ETH_RxChecksumStart(cksm);
+    ETH_ReadBlockChecksum((char *)&tcpHeader,sizeof(tcpHeader_t));
+
+    currentTCB = NULL;
+
+    // quick check on destination port
+    if ((tcpHeader.destPort != 0) && (tcpHeader.sourcePort != 0))
+    {
+        tcpHeader.sourcePort = ntohs(tcpHeader.sourcePort);
+        tcpHeader.destPort = ntohs(tcpHeader.destPort);
+        
+        currentTCB = TCB_Lookup(remoteAddress, tcpHeader.sourcePort, tcpHeader.destPort);
+
+        if (currentTCB != NULL)
+        {
+            if((tcpHeader.sourcePort == currentTCB->destPort) ||
+               (currentTCB->destIP == 0))
+            {
+                // we will need this if the port is in listen mode
+                // or to check for the correct TCB
+                receivedRemoteAddress = remoteAddress;
+                rcvPayloadLen = length - (uint16_t)(tcpHeader.dataOffset << 2);
+
+                // check/skip the TCP header options
+                if (TCP_RxChecksumVerify(length) != SUCCESS)
+                {
+                    logMsg(LOG_EV_TCP_BAD_CHECKSUM, LOG_INFO);
+                    NET_StatsDrop(TCP_CHECKSUM_FAILS);
+                }
+                else if (TCP_ParseTCPOptions() == SUCCESS)
+                {
+                    // we got a packet
+                    // sort out the events
+                    if(tcpHeader.syn)
+                    {
+                        if(tcpHeader.ack)
+                        {
+                            logMsg(LOG_EV_TCP_FOUND_SYNACK, LOG_INFO);
+                            currentTCB->connectionEvent = RCV_SYNACK;
+                        } else
+                        {
+                            logMsg(LOG_EV_TCP_FOUND_SYN, LOG_INFO);
+                            currentTCB->connectionEvent = RCV_SYN;
+                        }
+                    } else if(tcpHeader.fin)
+                    {
+                        if(tcpHeader.ack)
+                        {
+                            logMsg(LOG_EV_TCP_FOUND_FINACK, LOG_INFO);
+                            currentTCB->connectionEvent = RCV_FINACK;
+                        } else
+                        {
+                            logMsg(LOG_EV_TCP_FOUND_FIN, LOG_INFO);
+                            currentTCB->connectionEvent = RCV_FIN;
+                        }
+                    } else if(tcpHeader.rst)
+                    {
+                        if(tcpHeader.ack)
+                        {
+                            logMsg(LOG_EV_TCP_FOUND_RSTACK, LOG_INFO);
+                            currentTCB->connectionEvent = RCV_RSTACK;
+                        } else
+                        {
+                            logMsg(LOG_EV_TCP_FOUND_RST, LOG_INFO);
+                            currentTCB->connectionEvent = RCV_RST;
+                        }
+                    } else if(tcpHeader.ack)
+                    {
+                        logMsg(LOG_EV_TCP_FOUND_ACK, LOG_INFO);
+                        currentTCB->connectionEvent = RCV_ACK;
+                    }
+                    else
+                    {
+                        logMsg(LOG_EV_TCP_CONFUSED, LOG_INFO);
+                    }
+                    // convert it here to save some cycles later
+                    tcpHeader.ackNumber = ntohl(tcpHeader.ackNumber);
+                    tcpHeader.sequenceNumber = ntohl(tcpHeader.sequenceNumber);
+
+                    TCP_FiniteStateMachine();
+                }else
+                {
+                    logMsg(LOG_EV_TCP_BAD_OPTIONS, LOG_INFO);
+                }
+            } // we will not send a reset message for PORT not open
+        }
+        else
+        {
+            NET_StatsDrop(PORT_NOT_AVAILABLE);
+        }
+    }
+}
+
+
+/** This function is TCP stack state machine.
+ * 
+ *  The function is called each time an event (opening/closing a connection,
+ *  receiving TCP packet, etc) occurs.
+ * 
+ * @param 
+ *      None
+ * 
+ * @return
+ *      None
+ */
+static error_msg TCP_FiniteStateMachine(void)  //jira: CAE_MCU8-5647
+{
+    uint16_t notAckBytes;
+    uint32_t ackedBytes;
+    error_msg ret = ERROR;  //jira: CAE_MCU8-5647
+
+    tcp_fsm_states_t nextState = currentTCB->fsmState; // default don't change states
+    tcpEvent_t event = currentTCB->connectionEvent;
+    NET_PROFILE_START(start);
+
+    if(isPortUnreachable(currentTCB->localPort))
+    {
+        event = RCV_RST;
+        resetPortUnreachable();
+    }
+    switch (currentTCB->fsmState)
+    {
+        case LISTEN:
+            switch (event)
+            {
+                case RCV_SYN:
+                    logMsg(LOG_EV_TCP_LISTEN_RX_SYN, LOG_INFO);
+                    // Start the connection on the TCB
+
+                    currentTCB->destIP = receivedRemoteAddress;
+                    currentTCB->destPort = tcpHeader.sourcePort;
+
+                    // TO DO modify the start seq no to be "random"
+                    currentTCB->localLastAck = 0;
+
+                    currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
+                    currentTCB->remoteAck = currentTCB->remoteSeqno + 1; // ask for next packet
+
+                    // save data from TCP header
+                    currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
+                    currentTCB->mss = tcpMss;
+
+                    // create and send a SYN+ACK packet
+                    currentTCB->flags =   TCP_SYN_FLAG | TCP_ACK_FLAG;
+                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutsCount = TCP_MAX_SYN_RETRIES;
+
+                    TCP_Snd(currentTCB);
+                    nextState = SYN_RECEIVED;
+                    break;
+                case CLOSE:
+                    logMsg(LOG_EV_TCP_LISTEN_CLOSE, LOG_INFO);
+                    nextState = CLOSED;
+                    TCB_Reset(currentTCB);
+                    break;
+                default:
+                    // for all other cases the packet is invalid and will be discarded
+                    break;
+            }
+            break;
+        case SYN_SENT:
+            switch (event)
+            {
+                case RCV_SYN:
+                    logMsg(LOG_EV_TCP_SYN_SENT_RX_SYN, LOG_INFO);
+                    // Simultaneous open
+                    currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
+                    currentTCB->remoteAck = tcpHeader.sequenceNumber + 1; //ask for next packet
+
+                    // save data from TCP header
+                    currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
+                    currentTCB->mss = tcpMss;
+
+                    // create and send a ACK packet
+                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutsCount = TCP_MAX_SYN_RETRIES;
+                    currentTCB->flags = TCP_SYN_FLAG | TCP_ACK_FLAG;
+
+                    TCP_Snd(currentTCB);
+
+                    //Go to SYN_RECEIVED and waiting for the ack
+                    nextState = SYN_RECEIVED;
+                    break;
+                case RCV_SYNACK:
+                    logMsg(LOG_EV_TCP_SYN_SENT_RX_SYNACK, LOG_INFO);
+
+                    currentTCB->timeout = 0;
+
+                    if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
+                    {
+                        // create and send a ACK packet
+                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
+                        currentTCB->localLastAck = currentTCB->localSeqno - 1;
+                        currentTCB->flags =  TCP_ACK_FLAG;
+
+                        // save data from TCP header
+                        currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
+                        // ask for next packet
+                        currentTCB->remoteAck = tcpHeader.sequenceNumber + 1;
+
+                        currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
+                        currentTCB->mss = tcpMss;
+
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = ESTABLISHED;
+                            currentTCB->socketState = SOCKET_CONNECTED;
+                        }
+                    }
+                    else
+                    {
+                        //send reset
+                        currentTCB->localSeqno = tcpHeader.ackNumber;
+                        currentTCB->flags =  TCP_RST_FLAG | TCP_ACK_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    }
+                    break;
+                case RCV_ACK:
+                    logMsg(LOG_EV_TCP_SYN_SENT_RX_ACK, LOG_INFO);
+
+                    currentTCB->timeout = 0;
+
+                    if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
+                    {
+                        // create and send a ACK packet
+                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
+                        currentTCB->localLastAck = currentTCB->localSeqno - 1;
+                        currentTCB->flags =  TCP_ACK_FLAG;
+
+                        // save data from TCP header
+                        currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
+                        currentTCB->remoteAck = tcpHeader.sequenceNumber + 1; // ask for next packet
+
+                        currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
+                        currentTCB->mss = tcpMss;
+
+                        nextState = ESTABLISHED;
+                        currentTCB->socketState = SOCKET_CONNECTED;
+                    }
+                    else
+                    {
+                        //send reset
+                        currentTCB->localSeqno = tcpHeader.ackNumber;
+                        currentTCB->flags =  TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))    //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    }
+                    break;
+                case CLOSE:
+                    logMsg(LOG_EV_TCP_SYN_SENT_CLOSE, LOG_INFO);
+                    //go to CLOSED state
+                    nextState = CLOSED;
+                    TCB_Reset(currentTCB);
+                    break;
+                case TIMEOUT:
+                    logMsg(LOG_EV_TCP_SYN_SENT_TIMEOUT, LOG_INFO);
+                    // looks like the the packet was lost
+                    // check inside the packet to see where to jump next
+                    if (currentTCB->timeoutsCount)
+                    {
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            if (currentTCB->flags & TCP_RST_FLAG)
+                            {
+                                nextState = CLOSED;
+                                TCB_Reset(currentTCB);
+                            }else
+                            if(currentTCB->flags & TCP_ACK_FLAG)
+                            {
+                                nextState = ESTABLISHED;
+                                currentTCB->socketState = SOCKET_CONNECTED;
+                            }                        
+                        }
+                    }else
+                    {
+                        // just reset the connection if there is no reply
+                        currentTCB->flags = TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    } 
+                    break;
+                case RCV_RST:
+                case RCV_RSTACK:
+                    // port seems not to be opened
+                    nextState = CLOSED;
+                    TCB_Reset(currentTCB);
+                    break;
+                default:
+                    // for all other cases the packet is invalid and will be discarded
+                    break;
+            }
+            break;
+        case SYN_RECEIVED:
+            switch (event)
+            {
+                case RCV_SYNACK:
+                    logMsg(LOG_EV_TCP_SYN_RCVD_RX_SYNACK, LOG_INFO);
+                    if (currentTCB->localPort == tcpHeader.destPort)
+                    {
+                        // stop the current timeout
+                        currentTCB->timeout = 0;
+
+                        // This is part of simultaneous open
+                        // TO DO: Check if the received packet is the one that we expect
+                        if ((currentTCB->destIP == receivedRemoteAddress) && (currentTCB->destPort == tcpHeader.sourcePort))
+                        if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
+
+                        nextState = ESTABLISHED;
+                        currentTCB->socketState = SOCKET_CONNECTED;
+                    }
+                    break;
+                case RCV_ACK:
+                    logMsg(LOG_EV_TCP_SYN_RCVD_RX_ACK, LOG_INFO);
+
+                    // check if the packet is for the curent TCB
+                    // we need to check the remote IP adress and remote port
+                    if ((currentTCB->destIP == receivedRemoteAddress) && (currentTCB->destPort == tcpHeader.sourcePort))
+                    {
+                        // check the sequence numbers
+                        // is it the packet that I've ask for?
+                        if (currentTCB->remoteAck == tcpHeader.sequenceNumber)
+                        {
+                            // is ACK OK?
+                            if ((currentTCB->localSeqno + 1) == tcpHeader.ackNumber)
+                            {
+                                currentTCB->localSeqno = currentTCB->localSeqno + 1;
+                                currentTCB->localLastAck = currentTCB->localSeqno - 1;
+                                // stop the current timeout
+                                currentTCB->timeout = 0;
+                                
+                                nextState = ESTABLISHED;
+                                currentTCB->socketState = SOCKET_CONNECTED;
+                                TCP_ListenerQueue(currentTCB);
+                            }
+                        }
+                    }
+                    break;
+                case CLOSE:
+                    logMsg(LOG_EV_TCP_SYN_RCVD_CLOSE, LOG_INFO);
+                    // stop the current timeout
+                    currentTCB->timeout = 0;
+                    // Need to send FIN and go to the FIN_WAIT_1
+                    currentTCB->flags = TCP_FIN_FLAG;
+                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutsCount = TCP_MAX_RETRIES;
+                    
+                    nextState = FIN_WAIT_1;
+                    TCP_Snd(currentTCB);
+                    break;
+                case RCV_RSTACK:
+                case RCV_RST:
+                    // Reset the connection
+                    logMsg(LOG_EV_TCP_SYN_RCVD_RX_RST, LOG_INFO);
+                    //check if the local port match; else drop the pachet
+                    if (currentTCB->localPort == tcpHeader.destPort)
+                    {
+                        if (currentTCB->remoteAck ==  tcpHeader.sequenceNumber)
+                        {
+                            logMsg(LOG_EV_TCP_RST_SEQ_OK, LOG_INFO);
+                            currentTCB->destIP = 0;
+                            currentTCB->destPort = 0;
+                            currentTCB->localSeqno = 0;
+                            currentTCB->localLastAck = 0;
+                            currentTCB->remoteSeqno = 0;
+                            currentTCB->remoteAck = 0;
+                            currentTCB->remoteWnd = 0;
+                            //TCP_MAX_SEG_SIZE instead of 0
+                            currentTCB->mss = TCP_MAX_SEG_SIZE;
+                            
+                            nextState = LISTEN;
+                        }
+                    }
+                    break;
+                case TIMEOUT:
+                    logMsg(LOG_EV_TCP_SYN_RCVD_TIMEOUT, LOG_INFO);
+                    if (currentTCB->timeoutsCount)
+                    {
+                        TCP_Snd(currentTCB);
+                    }
+                    else
+                    {
+                        //reseting the connection if there is no reply
+                        currentTCB->flags =   TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            currentTCB->destIP = 0;
+                            currentTCB->destPort = 0;
+                            currentTCB->localSeqno = 0;
+                            currentTCB->localLastAck = 0;
+                            currentTCB->remoteSeqno = 0;
+                            currentTCB->remoteAck = 0;
+                            currentTCB->remoteWnd = 0;
+                            //TCP_MAX_SEG_SIZE instead of 0
+                            currentTCB->mss = TCP_MAX_SEG_SIZE;
+                            nextState = LISTEN;
+                        }
+                    }
+                    break;
+                default:
+                    // invalid packet so drop it
+                    break;
+            }
+            break;
+        case ESTABLISHED:
+            switch (event)
+            {
+                case RCV_ACK:
+                    logMsg(LOG_EV_TCP_ESTABLISHED_RX_ACK, LOG_INFO);
+                    if (currentTCB->destIP == receivedRemoteAddress)
+                    {
+                        // is sequence number OK?
+                        // remote ACK should be equal to header sequence number
+                        // we don't accept out of order packet (not enough memory)
+                        if (currentTCB->remoteAck == tcpHeader.sequenceNumber)
+                        {
+                            // This is a ACK packet only
+                            // check the ACK sequence, it may cover any part
+                            // of the bytes in flight or none of them
+                            ackedBytes = tcpHeader.ackNumber - (currentTCB->localLastAck + 1);
+                            notAckBytes = TCP_BytesInFlight(currentTCB);
+                            // check how many bytes sent was acknowledged
+                            if (ackedBytes <= notAckBytes)
+                            {
+                                currentTCB->remoteWnd = ntohs(tcpHeader.windowSize);
+                                if (ackedBytes != 0)
+                                {
+                                    TCP_SegmentsAcked(currentTCB, (uint16_t)ackedBytes);
+                                    TCP_RttAcked(currentTCB, tcpHeader.ackNumber);
+                                    currentTCB->localLastAck = tcpHeader.ackNumber - 1;
+                                }
+                                // Check if all TX buffer/data was acknowledged
+                                if((currentTCB->bytesToSend == 0) && (ackedBytes == notAckBytes))
+                                {
+                                    if (currentTCB->txBufState == TX_BUFF_IN_USE)
+                                    {
+                                        currentTCB->txBufState = NO_BUFF;
+#ifndef TCP_TX_IN_APP_RAM
+                                        TCP_TxBlockRelease(currentTCB);
+#endif
+                                        //stop timeout
+                                        currentTCB->timeout = 0;
+                                    }
+                                }                                    
+                                else
+                                {       
+                                    // new data acknowledged, time the rest from now
+                                    if (ackedBytes != 0)
+                                    {
+                                        currentTCB->timeout = currentTCB->rto;
+                                        currentTCB->timeoutReloadValue = currentTCB->rto;
+                                        currentTCB->timeoutsCount = TCP_MAX_RETRIES;
+                                        currentTCB->rtoWaited = 0;
+                                    }
+                                    TCP_SndData(currentTCB);
+                                }
+
+                                
+                                // check if the packet has payload
+                                if(rcvPayloadLen > 0)
+                                {
+                                    currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
+
+                                    // copy the payload to the local buffer
+                                    TCP_PayloadSave(rcvPayloadLen);
+                                }
+                            }else
+                            {
+                                // this is a wrong Ack
+                                // ACK a packet that wasn't transmitted
+                            }
+                        }
+                    }
+                    break;
+                case CLOSE:
+                    logMsg(LOG_EV_TCP_ESTABLISHED_CLOSE, LOG_INFO);
+                    currentTCB->flags = TCP_FIN_FLAG | TCP_ACK_FLAG ;	//jira: M8TS-514, M8TS-538, M8TS-463
+                    nextState = FIN_WAIT_1;
+                    currentTCB->timeout = 0;
+                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutsCount = TCP_MAX_RETRIES;
+                    TCP_Snd(currentTCB);
+                    break;
+                case RCV_FIN:
+                    logMsg(LOG_EV_TCP_ESTABLISHED_RX_FIN, LOG_INFO);
+                    break;
+                case RCV_FINACK:
+                    if (currentTCB->destIP == receivedRemoteAddress)        //jira: CAE_MCU8-5830
+                    {
+                        // is sequence number OK?
+                        // remote ACK should be equal to header sequence number
+                        // we don't accept out of order packet (not enough memory)
+                        if (currentTCB->remoteAck == tcpHeader.sequenceNumber)    //jira: CAE_MCU8-5830
+                        {
+                            currentTCB->bytesSent = 0;                   
+                            // ACK the current packet
+                            // TO DO  check if it's a valid packet
+                            currentTCB->localSeqno = tcpHeader.ackNumber;
+                            currentTCB->remoteAck = currentTCB->remoteAck + 1;
+
+                            // check if the packet has payload added for MCCV3xx-6762
+                            if(rcvPayloadLen > 0)	 //jira: CAE_MCU8-6056
+                            {
+                                currentTCB->remoteSeqno =  tcpHeader.sequenceNumber;
+
+                                // copy the payload to the local buffer
+                                TCP_PayloadSave(rcvPayloadLen);
+                            }
+
+                            currentTCB->socketState = SOCKET_CLOSING;
+                            currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                            currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
+                            currentTCB->timeoutsCount = TCP_MAX_RETRIES;
+                            // JUMP over CLOSE_WAIT state and send one packet with FIN + ACK
+                            currentTCB->flags =  TCP_FIN_FLAG | TCP_ACK_FLAG;
+
+                            nextState = LAST_ACK;
+                            TCP_Snd(currentTCB);
+                        }
+                    }
+                    break;
+                case RCV_RST:
+                case RCV_RSTACK:                     
+                    currentTCB->flags = TCP_RST_FLAG;
+                    TCP_Snd(currentTCB);
+                    nextState = CLOSED;
+                    TCB_Reset(currentTCB);
+                    break;
+                case TIMEOUT:
+                    logMsg(LOG_EV_TCP_ESTABLISHED_TIMEOUT, LOG_INFO);
+                    if (currentTCB->rtoWaited < TCP_RTO_MAX)
+                    {
+                        TCP_TimoutRetransmit();	//jira: CAE_MCU8-6056
+                    }else
+                    {
+                        // reset the connection if there is no reply
+                        currentTCB->flags =   TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))    //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case FIN_WAIT_1:
+            switch (event)
+            {
+                case RCV_FIN:
+                    currentTCB->flags =  TCP_ACK_FLAG;
+                    if (currentTCB->remoteAck == tcpHeader.sequenceNumber)	//jira: M8TS-514, M8TS-538, M8TS-463	
+                    {
+                        currentTCB->bytesSent = 0;                   
+                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
+                        currentTCB->remoteAck = currentTCB->remoteAck + 1;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647
+                       {
+                           nextState = CLOSING;
+                       }
+                    }     
+                    break;
+                case RCV_ACK:
+                    logMsg(LOG_EV_TCP_FIN_WAIT_1_RX_ACK, LOG_INFO);
+                    // stop the current timeout
+                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutsCount = 1;
+                    nextState = FIN_WAIT_2;
+                    break;
+                case RCV_FINACK:
+                    logMsg(LOG_EV_TCP_FIN_WAIT_1_RX_FINACK, LOG_INFO);
+                    currentTCB->flags =  TCP_ACK_FLAG;
+                    if (currentTCB->remoteAck == tcpHeader.sequenceNumber)	//jira: M8TS-514, M8TS-538, M8TS-463
+                    {
+                        currentTCB->bytesSent = 0;                   
+                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
+                        currentTCB->remoteAck = currentTCB->remoteAck + 1;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647
+                        {
+                            nextState = TIME_WAIT;
+                        }
+                    }
+                    break;
+                case TIMEOUT:
+                    logMsg(LOG_EV_TCP_FIN_WAIT_1_TIMEOUT, LOG_INFO);
+                    if (currentTCB->timeoutsCount)
+                    {
+                        TCP_Snd(currentTCB);
+                    }else
+                    {
+                        // just reset the connection if there is no reply
+                        currentTCB->flags =   TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))  //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    }
+                    break;                    
+                default:
+                    break;
+            }
+            break;
+        case FIN_WAIT_2:
+            switch (event)
+            {
+                case RCV_FINACK:					 		//jira: M8TS-514, M8TS-538, M8TS-463                   
+                case RCV_FIN:
+                    logMsg(LOG_EV_TCP_FIN_WAIT_2_RX_FIN, LOG_INFO);
+                    currentTCB->flags =  TCP_ACK_FLAG;					//jira: M8TS-514, M8TS-538, M8TS-463
+                    if (currentTCB->remoteAck == tcpHeader.sequenceNumber)
+                    {
+                        currentTCB->bytesSent = 0;                   
+                        currentTCB->localSeqno = currentTCB->localSeqno + 1;
+                        currentTCB->remoteAck = currentTCB->remoteAck + 1;     
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647
+                        {
+                            nextState = TIME_WAIT;
+                        }   
+                    }
+                                 
+                    break;
+                case TIMEOUT:
+                    logMsg(LOG_EV_TCP_FIN_WAIT_2_TIMEOUT, LOG_INFO);
+                    if (currentTCB->timeoutsCount)
+                    {
+                        TCP_Snd(currentTCB);
+                    }else
+                    {
+                        // just reset the connection if there is no reply
+                        currentTCB->flags =   TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))   //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    }
+                    break; 
+                default:
+                    break;
+            }
+            break;
+        case CLOSE_WAIT:
+            // This state is defined in RFC, but is not used in the application
+            break;
+        case CLOSING:
+            switch (event)
+            {
+                case RCV_ACK:
+                    logMsg(LOG_EV_TCP_CLOSING_RX_ACK, LOG_INFO);
+                    nextState = TIME_WAIT;
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case LAST_ACK:
+            // check if the packet belongs to the curent TCB
+            switch (event)
+            {
+                case RCV_FINACK:
+                case RCV_ACK:
+                    if ((currentTCB->destIP == receivedRemoteAddress) &&
+                        (currentTCB->destPort == tcpHeader.sourcePort))
+                    {
+                        logMsg(LOG_EV_TCP_LAST_ACK_RX_ACK, LOG_INFO);
+                        nextState = CLOSED;
+                        TCB_Reset(currentTCB);
+                    }
+                    break;
+                case TIMEOUT:
+                    if (currentTCB->timeoutsCount)
+                    {
+                        TCP_Snd(currentTCB);
+                    }else
+                    {
+                        // just reset the connection if there is no reply
+                        currentTCB->flags =   TCP_RST_FLAG;
+                        if(TCP_Snd(currentTCB) == (TX_QUEUED || SUCCESS))    //jira: CAE_MCU8-5647, CAE_MCU8-6056
+                        {
+                            nextState = CLOSED;
+                            TCB_Reset(currentTCB);
+                        }
+                    }
+                default:
+                    break;
+            }
+            break;
+        case TIME_WAIT:
+            logMsg(LOG_EV_TCP_TIME_WAIT, LOG_INFO);
+            nextState = CLOSED;
+            TCB_Reset(currentTCB);
+            break;
+        case CLOSED:
+            switch (event)
+            {
+                case ACTIVE_OPEN:
+                    logMsg(LOG_EV_TCP_CLOSED_ACTIVE_OPEN, LOG_INFO);
+                    // create and send a SYN packet
+                    currentTCB->timeout = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutReloadValue = TCP_START_TIMEOUT_VAL;
+                    currentTCB->timeoutsCount = TCP_MAX_SYN_RETRIES;
+                    currentTCB->flags = TCP_SYN_FLAG;
+                    TCP_Snd(currentTCB);
+                    nextState = SYN_SENT;
+                    ret = SUCCESS;    //jira: CAE_MCU8-5647
+                    break;
+                case PASIVE_OPEN:
+                    logMsg(LOG_EV_TCP_CLOSED_PASSIVE_OPEN, LOG_INFO);
+                    currentTCB->destIP = 0;
+                    currentTCB->destPort = 0;
+                    nextState = LISTEN;
+                    ret = SUCCESS;    //jira: CAE_MCU8-5647
+                    break;
+                default:
+                    break;
+            }
+            break;
+        default:
+            break;
+    }
+    currentTCB->connectionEvent = NOP; // we are handling the event...
+    currentTCB->fsmState = nextState;
+    TCB_Rehash(currentTCB);
+    NET_PROFILE_STOP(NET_PROFILE_TCP_FSM, start);
+    return ret;
+}
+
+
+void TCP_Init(void)
+{
+    tcbList = NULL;
+    tcbListSize = 0;
+    memset(tcbHash, 0, sizeof(tcbHash));
+    memset(&tcpLookupStats, 0, sizeof(tcpLookupStats));
+    nextAvailablePort = LOCAL_TCP_PORT_START_NUMBER;
+    nextSequenceNumber = 0;
+}
+
+error_msg TCP_SocketInit(tcpTCB_t *tcbPtr)   //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
+    
+    // verify that this socket is not in the list
+    if(TCB_Check(tcbPtr) == ERROR)    //jira: CAE_MCU8-5647
+    {
+        TCB_Reset(tcbPtr);
+
+        tcbPtr->localWnd = 0; // here we should put the RX buffer size
+        tcbPtr->mss = TCP_MAX_SEG_SIZE;
+        tcbPtr->fsmState = CLOSED;
+        tcbPtr->connectionEvent = NOP;
+        tcbPtr->rxBufferStart = NULL;
+        tcbPtr->rxBufState = NO_BUFF;
+        tcbPtr->rxHandler = NULL;
+        tcbPtr->txBufferStart = NULL;
+        tcbPtr->txBufferPtr = NULL;
+        tcbPtr->bytesToSend = 0;
+        tcbPtr->bytesSent = 0;
+        TCP_SegmentsClear(tcbPtr);
+#ifndef TCP_TX_IN_APP_RAM
+        tcbPtr->txBlock = SRAM_NO_BLOCK;
+#endif
+        tcbPtr->payloadSave = false;
+        tcbPtr->txBufState = NO_BUFF;
+        tcbPtr->socketState = SOCKET_CLOSED;
+        tcbPtr->listener = NULL;
+
+        TCB_Insert(tcbPtr);
+        ret = SUCCESS;   //jira: CAE_MCU8-5647
+    }
+    return ret;
+}
+
+error_msg TCP_SocketRemove(tcpTCB_t *tcbPtr)    //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;   //jira: CAE_MCU8-5647
+    
+    // verify that this socket is in the Closed State
+    if(TCP_SocketPoll(tcbPtr) == SOCKET_CLOSING)
+    {
+#ifndef TCP_TX_IN_APP_RAM
+        TCP_TxBlockRelease(tcbPtr);
+#endif
+        TCB_Remove(tcbPtr);
+        ret = SUCCESS;    //jira: CAE_MCU8-5647
+    }
+    return ret;
+}
+
+socketState_t TCP_SocketPoll(tcpTCB_t *socket_ptr)
+{
+    socketState_t tmpSocketState;
+   
+    tmpSocketState = NOT_A_SOCKET;
+    
+    if (TCB_Check(socket_ptr) == SUCCESS)    //jira: CAE_MCU8-5647
+    {
+        tmpSocketState = socket_ptr->socketState;
+    }
+
+    return tmpSocketState;
+}
+
+
+error_msg TCP_Bind(tcpTCB_t *tcbPtr, uint16_t port)    //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
+
+    logMsg(LOG_EV_TCP_BIND, LOG_INFO);
+
+    if (TCB_Check(tcbPtr) == SUCCESS)    //jira: CAE_MCU8-5647
+    {
+        tcbPtr->localPort = port;
+        TCB_Rehash(tcbPtr);
+        ret = SUCCESS;   //jira: CAE_MCU8-5647
+    }
+    return ret;
+}
+
+
+error_msg TCP_Listen(tcpTCB_t *tcbPtr)    //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
+
+    logMsg(LOG_EV_TCP_LISTEN, LOG_INFO);
+
+    if (TCB_Check(tcbPtr) == SUCCESS)    //jira: CAE_MCU8-5647
+    {
+        tcbPtr->connectionEvent = PASIVE_OPEN;
+        tcbPtr->socketState = SOCKET_IN_PROGRESS;
+        tcbPtr->localSeqno = nextSequenceNumber;
+        currentTCB = tcbPtr;
+        if (tcbPtr->localPort == 0)
+        {
+            tcbPtr->localPort = nextAvailablePort++;
+        }
+        ret = TCP_FiniteStateMachine();
+    }
+    return ret;
+}
+
+
+/** Put a socket of a listener that completed the handshake in the accept
+ *  queue.
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_ListenerQueue(tcpTCB_t *tcbPtr)
+{
+    tcpListener_t *listener = tcbPtr->listener;
+
+    // the backlog keeps the queue from filling up
+    if ((listener != NULL) && (listener->queueCount < TCP_LISTEN_BACKLOG_MAX))
+    {
+        listener->queue[(listener->queueHead + listener->queueCount) % TCP_LISTEN_BACKLOG_MAX] = tcbPtr;
+        listener->queueCount++;
+    }
+}
+
+/** Check if a socket of a listener waits in its accept queue.
+ *
+ * @param listener
+ *      pointer to the listener structure
+ *
+ * @param tcbPtr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      true - The socket is queued
+ * @return
+ *      false - The socket is not queued
+ */
+static bool TCP_ListenerQueued(tcpListener_t *listener, tcpTCB_t *tcbPtr)
+{
+    uint8_t i;
+
+    for (i = 0; i < listener->queueCount; i++)
+    {
+        if (listener->queue[(listener->queueHead + i) % TCP_LISTEN_BACKLOG_MAX] == tcbPtr)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Take back the sockets of the pool that were removed or that lost their
+ *  connection before it was accepted, and let free ones listen up to the
+ *  backlog.
+ *
+ * @param listener
+ *      pointer to the listener structure
+ *
+ * @return
+ *      None
+ */
+static void TCP_ListenerUpdate(tcpListener_t *listener)
+{
+    tcpTCB_t *tcbPtr;
+    uint8_t owned = 0;
+    uint8_t i;
+
+    for (i = 0; i < listener->poolSize; i++)
+    {
+        tcbPtr = &listener->pool[i];
+        if ((TCB_Check(tcbPtr) == SUCCESS) && (tcbPtr->listener == listener))
+        {
+            if ((tcbPtr->socketState == SOCKET_CLOSING) && !TCP_ListenerQueued(listener, tcbPtr))
+            {
+                TCP_SocketRemove(tcbPtr);
+            }
+            else
+            {
+                owned++;
+            }
+        }
+    }
+
+    for (i = 0; (i < listener->poolSize) && (owned < listener->backlog); i++)
+    {
+        tcbPtr = &listener->pool[i];
+        if (TCB_Check(tcbPtr) == ERROR)
+        {
+            TCP_SocketInit(tcbPtr);
+            tcbPtr->listener = listener;
+            TCP_Bind(tcbPtr, listener->localPort);
+            if (listener->rxBuffers != NULL)
+            {
+                TCP_InsertRxBuffer(tcbPtr, listener->rxBuffers + (uint16_t)i * listener->rxBufferSize, listener->rxBufferSize);
+            }
+            TCP_Listen(tcbPtr);
+            owned++;
+        }
+    }
+}
+
+error_msg TCP_ListenerInit(tcpListener_t *listener, uint16_t port, tcpTCB_t *pool, uint8_t poolSize,
+                           uint8_t *rxBuffers, uint16_t rxBufferSize, uint8_t backlog)
+{
+    error_msg ret = ERROR;
+    uint8_t i;
+
+    if ((listener != NULL) && (pool != NULL) && (poolSize != 0) && (port != 0) &&
+        (backlog != 0) && (backlog <= TCP_LISTEN_BACKLOG_MAX))
+    {
+        // the pool sockets must not be in use
+        for (i = 0; i < poolSize; i++)
+        {
+            if (TCB_Check(&pool[i]) == SUCCESS)
+            {
+                return ret;
+            }
+        }
+        listener->localPort = port;
+        listener->pool = pool;
+        listener->poolSize = poolSize;
+        listener->rxBuffers = rxBuffers;
+        listener->rxBufferSize = rxBufferSize;
+        listener->backlog = backlog;
+        listener->queueHead = 0;
+        listener->queueCount = 0;
+        TCP_ListenerUpdate(listener);
+        ret = SUCCESS;
+    }
+    return ret;
+}
+
+tcpTCB_t *TCP_Accept(tcpListener_t *listener)
+{
+    tcpTCB_t *tcbPtr = NULL;
+
+    // a queued connection that was reset before it was accepted is skipped,
+    // the update then takes the socket back
+    while ((tcbPtr == NULL) && (listener->queueCount != 0))
+    {
+        tcbPtr = listener->queue[listener->queueHead];
+        listener->queueHead = (listener->queueHead + 1u) % TCP_LISTEN_BACKLOG_MAX;
+        listener->queueCount--;
+        if (tcbPtr->socketState == SOCKET_CONNECTED)
+        {
+            tcbPtr->listener = NULL;
+        }
+        else
+        {
+            tcbPtr = NULL;
+        }
+    }
+    TCP_ListenerUpdate(listener);
+    return tcbPtr;
+}
+
+
+error_msg TCP_Connect(tcpTCB_t *tcbPtr, sockaddr_in4_t *srvaddr)   //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
+
+    if (TCP_SocketPoll(tcbPtr) == SOCKET_CLOSED)
+    {
+        tcbPtr->destIP = srvaddr->addr.s_addr;
+        tcbPtr->destPort = srvaddr->port;
+        if(tcbPtr->localPort == 0)
+        {
+            // use a "random" port for the local one
+            tcbPtr->localPort = nextAvailablePort++;
+        }
+
+        tcbPtr->fsmState = CLOSED;
+        tcbPtr->socketState = SOCKET_IN_PROGRESS;
+        tcbPtr->localSeqno = nextSequenceNumber;
+        tcbPtr->connectionEvent = ACTIVE_OPEN;
+
+        currentTCB = tcbPtr;
+        ret = TCP_FiniteStateMachine();
+    }
+
+    return ret;
+}
+
+
+error_msg TCP_Close(tcpTCB_t *tcbPtr)   //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
+
+    logMsg(LOG_EV_TCP_CLOSE, LOG_INFO);
+
+    if (TCB_Check(tcbPtr) == SUCCESS)    //jira: CAE_MCU8-5647
+    {
+        tcbPtr->connectionEvent = CLOSE;
+        
+
+        tcbPtr->txBufState = NO_BUFF;
+#ifndef TCP_TX_IN_APP_RAM
+        TCP_TxBlockRelease(tcbPtr);
+#endif
+        tcbPtr->rxBufState = NO_BUFF;
+        tcbPtr->txBufferPtr = NULL;
+        tcbPtr->txBufferStart = NULL;
+        tcbPtr->rxBufferPtr = NULL;
+        tcbPtr->rxBufferStart = NULL;
+        tcbPtr->rxHandler = NULL;
+        tcbPtr->bytesToSend = 0;
+        tcbPtr->bytesSent = 0;
+        TCP_SegmentsClear(tcbPtr);
+        tcbPtr->payloadSave = false;
+
+        // likely to change this to a needs TX time queue
+        currentTCB = tcbPtr;
+        ret = TCP_FiniteStateMachine();
+    }
+    return ret;
+}
+
+
+error_msg TCP_Send(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t dataLen)    //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;    //jira: CAE_MCU8-5647
+
+    if (TCP_SocketPoll(tcbPtr) == SOCKET_CONNECTED)
+    {
+        if (tcbPtr->txBufState == NO_BUFF)
+        {
+            if (data != NULL)
+            {
+#ifndef TCP_TX_IN_APP_RAM
+                // the segments are sent from the copy, data only serves as
+                // the base of txBufferPtr from here on
+                tcbPtr->txBlock = (dataLen > 0) ? SRAM_Alloc(dataLen) : SRAM_NO_BLOCK;
+                if (tcbPtr->txBlock != SRAM_NO_BLOCK)
+                {
+                    SRAM_Write(tcbPtr->txBlock, 0, data, dataLen);
+                    tcbPtr->txSumLength = 0;
+                }
+#endif
+                tcbPtr->txBufferStart = data;
+                tcbPtr->txBufferPtr = tcbPtr->txBufferStart;
+                tcbPtr->bytesToSend = dataLen;
+                tcbPtr->txBufState = TX_BUFF_IN_USE;
+                tcbPtr->bytesSent = dataLen;
+                // everything sent before was acknowledged
+                tcbPtr->localLastAck = tcbPtr->localSeqno - 1;
+                tcbPtr->rttSeqno = tcbPtr->localSeqno;
+                tcbPtr->rttTiming = false;
+
+                tcbPtr->timeout = tcbPtr->rto;
+                tcbPtr->timeoutReloadValue = tcbPtr->rto;
+                tcbPtr->timeoutsCount = TCP_MAX_RETRIES;
+                tcbPtr->rtoWaited = 0;
+
+                tcbPtr->flags = TCP_ACK_FLAG;
+
+                TCP_SegmentsClear(tcbPtr);
+                TCP_SndData(tcbPtr);
+                ret = SUCCESS;    //jira: CAE_MCU8-5647
+            }
+        }
+    }
+    return ret;
+}
+
+
+error_msg TCP_SendDone(tcpTCB_t *tcbPtr)    //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;      //jira: CAE_MCU8-5647
+
+    if(TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
+    {
+        if (tcbPtr->txBufState == NO_BUFF)
+        {
+            ret = SUCCESS;   //jira: CAE_MCU8-5647
+        }
+    }
+    return ret;
+}
+
+bool TCP_SendCopied(tcpTCB_t *tcbPtr)
+{
+#ifndef TCP_TX_IN_APP_RAM
+    return (TCB_Check(tcbPtr) == SUCCESS) && (tcbPtr->txBufState == TX_BUFF_IN_USE)
+           && (tcbPtr->txBlock != SRAM_NO_BLOCK);
+#else
+    return false;
+#endif
+}
+
+error_msg TCP_InsertRxBuffer(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t data_len)     //jira: CAE_MCU8-5647
+{
+    error_msg ret = ERROR;     //jira: CAE_MCU8-5647
+
+    if (TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
+    {
+        if (tcbPtr->rxBufState == NO_BUFF)
+        {
+            if (data != NULL)
+            {
+                tcbPtr->rxBufferStart = data;
+                tcbPtr->rxBufferPtr = tcbPtr->rxBufferStart;
+                tcbPtr->localWnd = data_len;  // update the available receive windows
+                tcbPtr->rxBufState = RX_BUFF_IN_USE;
+                // a delayed ACK tells the remote about the new window on the
+                // next pass, unless data sent before carries it
+                if (tcbPtr->ackPending != 0)
+                {
+                    tcbPtr->ackDue = timer1Periods;
+                }
+                ret = SUCCESS;    //jira: CAE_MCU8-5647
+            }
+        }
+    }
+    return ret;
+}
+
+
+error_msg TCP_InsertRxHandler(tcpTCB_t *tcbPtr, tcpRxHandler_t handler)
+{
+    error_msg ret = ERROR;
+
+    if (TCB_Check(tcbPtr) == SUCCESS)
+    {
+        if ((tcbPtr->rxBufState == NO_BUFF) && (handler != NULL))
+        {
+            tcbPtr->rxHandler = handler;
+            // the segments wait in the Ethernet RX buffer, not in PIC RAM
+            tcbPtr->localWnd = TCP_RX_HANDLER_WINDOW;
+            tcbPtr->rxBufState = RX_HANDLER_IN_USE;
+            ret = SUCCESS;
+        }
+    }
+    return ret;
+}
+
+uint16_t TCP_RxRead(void *data, uint16_t len)
+{
+    if (len > rcvPayloadLeft)
+    {
+        len = rcvPayloadLeft;
+    }
+    len = ETH_ReadBlock(data, len);
+    rcvPayloadLeft = rcvPayloadLeft - len;
+    return len;
+}
+
+uint16_t TCP_RxPeek(void *data, uint16_t len)
+{
+    uint16_t rdptr = ETH_GetReadPtr();
+
+    if (len > rcvPayloadLeft)
+    {
+        len = rcvPayloadLeft;
+    }
+    len = ETH_ReadBlock(data, len);
+    // put the bytes back
+    ETH_SetReadPtr(rdptr);
+    ETH_SetRxByteCount(len);
+    return len;
+}
+
+uint16_t TCP_RxDump(uint16_t len)
+{
+    if (len > rcvPayloadLeft)
+    {
+        len = rcvPayloadLeft;
+    }
+    ETH_Dump(len);
+    rcvPayloadLeft = rcvPayloadLeft - len;
+    return len;
+}
+
+int16_t TCP_GetReceivedData(tcpTCB_t *tcbPtr)
+{
+    int16_t ret = 0;
+
+    if (TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
+    {
+        if (tcbPtr->rxBufState == RX_BUFF_IN_USE)
+        {
+            ret = tcbPtr->rxBufferPtr - tcbPtr->rxBufferStart;
+
+            if (ret != 0)
+            {
+                tcbPtr->localWnd = 0;
+                tcbPtr->rxBufState = NO_BUFF;
+            }
+        }
+    }
+    return ret;
+}
+
+int16_t TCP_GetRxLength(tcpTCB_t *tcbPtr)
+{
+    int16_t ret = 0;
+
+    if (TCB_Check(tcbPtr) == SUCCESS)     //jira: CAE_MCU8-5647
+    {
+        if (tcbPtr->rxBufState == RX_BUFF_IN_USE)
+        {
+            ret = tcbPtr->rxBufferPtr - tcbPtr->rxBufferStart;
+        }
+    }
+    return ret;
+}
+
+void TCP_Update(void)
+{
+    tcpTCB_t *tcbPtr;
+    tcbPtr = NULL;
+    int count = 0;
+
+    tcpTicks++;
+
+    // update sequence number and local port number in order to be different
+    // for each new connection
+    nextSequenceNumber++;
+
+    // keep local port number in the general port range
+    nextAvailablePort = nextAvailablePort + 1;
+    if (nextAvailablePort < LOCAL_TCP_PORT_START_NUMBER)
+    {
+        nextAvailablePort = LOCAL_TCP_PORT_START_NUMBER;
+    }
+    //TO DO also local seq number should be "random"
+
+    tcbPtr = tcbList;
+    while((tcbPtr != NULL) && (count < tcbListSize))
+    {
+        if (tcbPtr->timeout > 0)
+        {
+            logMsg(LOG_EV_TCP_TIMEOUT, LOG_INFO);
+            tcbPtr->timeout = tcbPtr->timeout - 1;
+
+            if (tcbPtr->timeout == 0)
+            {
+                // MAKE sure we don't overwrite anything else
+                if (tcbPtr->connectionEvent == NOP)
+                {
+                    int retries = TCP_MAX_RETRIES - tcbPtr->timeoutsCount; // Jira: CAE_MCU8-5772
+                    uint32_t backoff;
+                    if(retries < 0){
+                        retries = 0;
+                    }
+                    backoff = (uint32_t)tcbPtr->timeoutReloadValue << retries;
+                    tcbPtr->timeout = (backoff < TCP_RTO_MAX) ? (uint16_t)backoff : TCP_RTO_MAX;
+                    //if not zero
+                    if (tcbPtr->timeoutsCount != 0)
+                        tcbPtr->timeoutsCount = tcbPtr->timeoutsCount - 1u;  //jira: CAE_MCU8-5647
+                    tcbPtr->connectionEvent = TIMEOUT;
+                    currentTCB = tcbPtr;
+                    TCP_FiniteStateMachine();
+                }
+            }
+        }
+        tcbPtr = tcbPtr->nextTCB;
+        count ++;
+    }
+}
+
+void TCP_SendPending(void)
+{
+    tcpTCB_t *tcbPtr;
+    int count = 0;
+
+    tcbPtr = tcbList;
+    // an ACK still finds room in the control area of the TX buffer when
+    // data segments fill the rest
+    while((tcbPtr != NULL) && (count < tcbListSize) && ETH_TxReady(sizeof(ipv4Header_t) + sizeof(tcpHeader_t)))
+    {
+        // a closed window is left to the timeout to probe
+        if (((tcbPtr->fsmState == ESTABLISHED) || (tcbPtr->fsmState == CLOSE_WAIT))
+            && (tcbPtr->bytesToSend != 0) && (tcbPtr->remoteWnd > TCP_BytesInFlight(tcbPtr))
+            && ETH_TxReady(ETH_MTU))
+        {
+            TCP_SndData(tcbPtr);
+        }
+        // no data came to carry the ACK in time
+        if ((tcbPtr->ackPending != 0) && ((int8_t)(timer1Periods - tcbPtr->ackDue) >= 0))
+        {
+            TCP_AckNow(tcbPtr);
+        }
+        tcbPtr = tcbPtr->nextTCB;
+        count++;
+    }
+}
+
+/** Send again from the oldest byte that was not acknowledged.
+ *  Everything before localLastAck + 1 was acknowledged, TCP_Send() starts
+ *  the count at the first byte of the buffer.  One segment goes out, the
+ *  ACK for it lets the rest follow.
+ *
+ * @return
+ *      the TCP_Snd() result
+ */
+static error_msg TCP_TimoutRetransmit(void)	//jira: CAE_MCU8-6056
+{
+    uint16_t notAckBytes;
+
+    netStats.tcpRetransmits++;
+    // the bytes up to localSeqno are not timed any more, and the time-out
+    // stays backed off until a segment sent once is acknowledged
+    if ((int32_t)(currentTCB->localSeqno - currentTCB->rttSeqno) > 0)
+    {
+        currentTCB->rttSeqno = currentTCB->localSeqno;
+    }
+    currentTCB->rttTiming = false;
+    currentTCB->rtoWaited = currentTCB->rtoWaited + currentTCB->rto;
+    currentTCB->rto = (currentTCB->rto < (TCP_RTO_MAX / 2u)) ? (currentTCB->rto << 1) : TCP_RTO_MAX;
+    currentTCB->timeout = currentTCB->rto;
+    currentTCB->timeoutReloadValue = currentTCB->rto;
+    notAckBytes = currentTCB->localSeqno - (currentTCB->localLastAck + 1);
+    currentTCB->txBufferPtr = currentTCB->txBufferPtr - notAckBytes;
+    currentTCB->bytesToSend = currentTCB->bytesToSend + notAckBytes;
+    currentTCB->bytesSent = currentTCB->bytesToSend;
+    currentTCB->localSeqno = currentTCB->localSeqno - notAckBytes;
+    TCP_SegmentsClear(currentTCB);
+    return TCP_Snd(currentTCB);
 }
\ No newline at end of file
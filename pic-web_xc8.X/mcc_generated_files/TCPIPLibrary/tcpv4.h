@@ -1,414 +1,612 @@
-/**
-  Transmission Control Protocol (TCP) v4 Header File
-	
-  @Company:
-    Microchip Technology Inc.
-
-  @File Name:
-    tcpv4.h
-
-  @Summary:
-    Header file for the TCPv4.c
-
-  @Description:
-    This header file provides the API for the TCPv4 protocol.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-#ifndef TCPV4_H
-#define	TCPV4_H
-
-/**
-  Section: Included Files
-*/
-#include <stdbool.h>
-#include "tcpip_types.h"
-
-#define TCP_FIN_FLAG 0x01U
-#define TCP_SYN_FLAG 0x02U
-#define TCP_RST_FLAG 0x04U
-#define TCP_PSH_FLAG 0x08U
-#define TCP_ACK_FLAG 0x10U
-#define TCP_URG_FLAG 0x20U
-#define TCP_ECE_FLAG 0x40U
-#define TCP_CWR_FLAG 0x80U
-
-/**
-  Section: Enumeration Definition
-*/
-
-typedef enum
-{
-     CLOSED = 0,    // make it easy for initialization
-     LISTEN, SYN_SENT, SYN_RECEIVED, ESTABLISHED, FIN_WAIT_1, FIN_WAIT_2, CLOSE_WAIT, CLOSING, LAST_ACK, TIME_WAIT,
-}tcp_fsm_states_t;
-
-typedef enum
-{
-     CLOSE = 0,    // make it easy for initialization
-     ACTIVE_OPEN, PASIVE_OPEN, RCV_SYN, RCV_ACK, RCV_SYNACK, RCV_FIN, RCV_FINACK, RX_PACKET, RCV_RST, RCV_RSTACK,
-     RCV_PSHACK, TIMEOUT,
-     NOP // dummy state, I will remove it later
-}tcpEvent_t;
-
-// add socket states to be used in the application
-typedef enum
-{
-    NOT_A_SOCKET = 0,           // This is not a socket
-    SOCKET_CLOSED,              // Socket closed
-    SOCKET_IN_PROGRESS,         // The TCP listen or initiate a connection
-    SOCKET_CONNECTED,           // The TCP is in established state user can send/receive data
-    SOCKET_CLOSING              // The user initiate the closing procedure for this socket
-} socketState_t;
-
-typedef struct
-{
-    uint32_t localIP;
-    uint16_t localPort;
-    uint32_t remoteIP;
-    uint16_t remotePort;
-}tcpSocket_t;
-
-typedef enum
-{
-    NO_BUFF = 0,
-    RX_BUFF_IN_USE,
-    TX_BUFF_IN_USE
-}tcpBufferState_t;
-
-typedef struct
-{
-    uint16_t localPort;             // this is the local port
-
-    uint32_t destIP;
-    uint16_t destPort;
-
-    uint32_t remoteSeqno;
-    uint32_t remoteAck;             // last ack packet sent to remote
-
-    uint32_t localSeqno;
-    uint32_t localLastAck;          // last ack number received
-
-    uint16_t remoteWnd;             // sender window
-    uint16_t localWnd;              // receiver window
-    
-    uint16_t mss;
-
-    uint8_t *rxBufferStart;
-    uint8_t *rxBufferPtr;           // pointer to write inside the rx buffer
-    tcpBufferState_t rxBufState;
-
-    uint8_t *txBufferStart;
-    uint8_t *txBufferPtr;
-    uint16_t bytesToSend;
-    tcpBufferState_t txBufState;
-    uint16_t bytesSent;
-    bool payloadSave;
-
-    tcp_fsm_states_t fsmState;      // connection state
-    tcpEvent_t connectionEvent;
-
-    // Linked List Pointers
-    void *nextTCB;                  // downstream list pointer
-    void *prevTCB;                  // upstream list pointer
-
-    uint16_t timeout;               // retransmission time-out in seconds
-    uint16_t timeoutReloadValue;
-    uint8_t timeoutsCount;          // number of retransmissions
-    uint8_t flags;                  // save the flags to be used for timeouts
-
-    socketState_t socketState;     // socket state to be easy
-}tcpTCB_t;
-
-typedef enum
-{
-TCP_EOP = 0u,        // length = 0   End of Option List,[RFC793]
-TCP_NOP = 1u,        // length = 0   No-Operation,[RFC793]
-TCP_MSS = 2u,        // length = 4   Maximum Segment Size,[RFC793]
-
-// this options are not implemented
-#ifdef ALL_TCP_HEADER_OPTIONS
-TCP_WIN_SCALE = 3,  // length = 3   Window Scale,[RFC7323]
-TCP_SACK = 4,       // length = 2   SACK Permitted,[RFC2018]
-
-5                   // length = N   SACK,[RFC2018]
-6                   // length = 6   Echo (obsoleted by option 8),[RFC1072][RFC6247]
-7                   // length = 6   Echo Reply (obsoleted by option 8),[RFC1072][RFC6247]
-8                   // length = 10  Timestamps,[RFC7323]
-9                   // length = 2   Partial Order Connection Permitted (obsolete),[RFC1693][RFC6247]
-10                  // length = 3   Partial Order Service Profile (obsolete),[RFC1693][RFC6247]
-11                  // length = 0   CC (obsolete),[RFC1644][RFC6247]
-12                  // length = 0   CC.NEW (obsolete),[RFC1644][RFC6247]
-13                  // length = 0   CC.ECHO (obsolete),[RFC1644][RFC6247]
-14                  // length = 3   TCP Alternate Checksum Request (obsolete),[RFC1146][RFC6247]
-15                  // length = N   TCP Alternate Checksum Data (obsolete),[RFC1146][RFC6247]
-16                  // length = 0   Skeeter,[Stev_Knowles]
-17                  // length = 0   Bubba,[Stev_Knowles]
-18                  // length = 3   Trailer Checksum Option,[Subbu_Subramaniam][Monroe_Bridges]
-19                  // length = 18  MD5 Signature Option (obsoleted by option 29),[RFC2385]
-20                  // length = 0   SCPS Capabilities,[Keith_Scott]
-21                  // length = 0   Selective Negative Acknowledgements,[Keith_Scott]
-22                  // length = 0   Record Boundaries,[Keith_Scott]
-23                  // length = 0   Corruption experienced,[Keith_Scott]
-24                  // length = 0   SNAP,[Vladimir_Sukonnik]
-25                  // length = 0   Unassigned (released 2000-12-18),
-26                  // length = 0   TCP Compression Filter,[Steve_Bellovin]
-27                  // length = 8   Quick-Start Response,[RFC4782]
-28                  // length = 4   "User Timeout Option (also, other known unauthorized use) [***][1]",[RFC5482]
-29                  // length = 0   TCP Authentication Option (TCP-AO),[RFC5925]
-30                  // length = N   Multipath TCP (MPTCP),[RFC6824]
-31                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-32                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-33                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-34-75               // length = 0   Reserved,
-69                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-70                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-71-75               // length = 0   Reserved,
-76                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-77                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-78                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
-79-252              // length = 0   Reserved,
-253                 // length = N   "RFC3692-style Experiment 1 (also improperly used for shipping products) [*]",[RFC4727]
-254                 // length = N   "RFC3692-style Experiment 2 (also improperly used for shipping products) [*]",[RFC4727]"
-#endif
-}tcp_options_t;
-
-
-/**
-  Section: TCP Public Interface Functions
- */
-
-
-/*Initialize TCP structures
- * This functions initializes some internal TCP stack variables
- * 
- * @param None
- * 
- * @param return
- *      Nothing
- * 
- */
-void TCP_Init(void);
-
-
-/** Initialize the TCB and add it to the list of TCB pointers.
- * Put the socket in the CLOSED state.
- *
- * The user is responsible to manage allocation and releasing of the memory.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @return
- *      -1 if there was any problems
- * @return
- *       0 if the insertion was successful.
- */
-error_msg TCP_SocketInit(tcpTCB_t *tcb_ptr);   //jira: CAE_MCU8-5647
-
-
-/** Remove the socket pointer from the TCP Stack, actually the pointer will be
- * removed from the list of TCB pointers. After calling this function the user
- * can reuse the memory.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @return
- *      -1 if there was any problems
- * @return
- *       0 if the removing was successful.
- */
-error_msg TCP_SocketRemove(tcpTCB_t *tcb_ptr);
-
-
-/** The function will provide an interface to read the status of the socket.
- *  This function will also check if the pointer is already into the TCB list 
- *  (this means that the socket is "in use"). If the socket is into the TCB list
- * it will return the status for the socket.
- * 
- * @param tcb_ptr 
- *      pointer to socket/TCB structure
- *
- * @return
- *      the socket state
- */
-socketState_t TCP_SocketPoll(tcpTCB_t *tcbPtr);
-
-
-/** Assign a port number to the specified socket.
- * This is used for configure the local port of a socket.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @param port
- *      port number to be used as a local port. 
- * 
- * @return
- *      true - The port was initialized successfully
- * @return
- *      false - The initialization fails 
- */
-error_msg TCP_Bind(tcpTCB_t *tcbPtr, uint16_t port);    //jira: CAE_MCU8-5647
-
-
-/** Listen for connections on a socket.
- *  It marks the socket as a passive socket, that is, as a socket that 
- *  will be used to accept incoming connection requests.
- *  
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @param port
- *      port number used as a local port to listen on. 
- * 
- * @return
- *      true - The server was started successfully
- * @return
- *      false - The starting of the server fails
- */
-error_msg TCP_Listen(tcpTCB_t *tcbPtr);    //jira: CAE_MCU8-5647
-
-
-/** Start the client for a particular socket.
- *  
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @param port
- *      port number used as a local port to listen on. 
- * 
- * @return
- *      true - The server was started successfully
- * @return
- *      false - The starting of the server fails
- */
-error_msg TCP_Connect(tcpTCB_t *tcbPtr, sockaddr_in4_t *srvaddr);    //jira: CAE_MCU8-5647
-
-
-/** Close the TCP connection.
- * This will initiate the Closing sequence for the TCP connection.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @return
- *      true - The Close procedure was started successfully
- * @return
- *      false - The Close procedure fails
- */
-error_msg TCP_Close(tcpTCB_t *tcbPtr);     //jira: CAE_MCU8-5647
-
-
-/** Send a buffer to a remote machine using a TCP connection.
- *  The function will add the buffer to the socket and the payload will be
- *  send as soon as possible.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @return
- *      true - The buffer was added to the socket/TCB successfully
- * @return
- *      false - Adding the buffer to the socket fails
- */
-error_msg TCP_Send(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t dataLen);    //jira: CAE_MCU8-5647
-
-
-/** Check if the TX buffer was send.
- *  This means that the data was received correctly by the remote machine and 
- *  the TX buffer memory can be reused by the application.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- * 
- * @return
- *      true - The buffer was transmitted successfully
- * @return
- *      false - Buffer transmission fails or wasn't sent yet.
- */
-error_msg TCP_SendDone(tcpTCB_t *tcbPtr);    //jira: CAE_MCU8-5647
-
-
-/** Will add the RX buffer to the socket.
- *
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- *
- * @param data
- *      Pointer to the data buffer
- *
- * @param data_len
- *      Size of the buffer
- *
- * @return
- *      true - The buffer was  passed to socket successfully
- * @return
- *      false - passing of the buffer to the socket failed.
- */
-error_msg TCP_InsertRxBuffer(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t dataLen);    //jira: CAE_MCU8-5647
-
-
-/** This function will read the available data from the socket.
- *  The function will provide to the user also the start address of the 
- *  received buffer.
- * 
- * @param tcb_ptr
- *      pointer to the socket/TCB structure 
- * 
- * @return
- *      Number of received bytes in the buffer
- *      
- */
-int16_t TCP_GetReceivedData(tcpTCB_t *tcbPtr);
-
-
-/** This function will check and return the number of available bytes received
- *  on a socket.
- *
- * @param tcb_ptr
- *      pointer to the socket/TCB structure
- *
- * @return
- *      Number of received bytes in the buffer
- *
- */
-int16_t TCP_GetRxLength(tcpTCB_t *tcbPtr);
-
-
-/** This function needs to be called periodically in order to handle the
- *  TCP stack timeouts for each available socket.
- *
- * @param
- *      None
- *
- * @return
- *      None
- */
-void TCP_Update(void);
-
-#endif  /* TCPV4_H */
-
+/**
+  Transmission Control Protocol (TCP) v4 Header File
+	
+  @Company:
+    Microchip Technology Inc.
+
+  @File Name:
+    tcpv4.h
+
+  @Summary:
+    Header file for the TCPv4.c
+
+  @Description:
+    This header file provides the API for the TCPv4 protocol.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+#ifndef TCPV4_H
+#define	TCPV4_H
+
+/**
+  Section: Included Files
+*/
+#include <stdbool.h>
+#include "tcpip_types.h"
+#include "sram_heap.h"
+
+#define TCP_FIN_FLAG 0x01U
+#define TCP_SYN_FLAG 0x02U
+#define TCP_RST_FLAG 0x04U
+#define TCP_PSH_FLAG 0x08U
+#define TCP_ACK_FLAG 0x10U
+#define TCP_URG_FLAG 0x20U
+#define TCP_ECE_FLAG 0x40U
+#define TCP_CWR_FLAG 0x80U
+
+/**
+  Section: Enumeration Definition
+*/
+
+typedef enum
+{
+     CLOSED = 0,    // make it easy for initialization
+     LISTEN, SYN_SENT, SYN_RECEIVED, ESTABLISHED, FIN_WAIT_1, FIN_WAIT_2, CLOSE_WAIT, CLOSING, LAST_ACK, TIME_WAIT,
+}tcp_fsm_states_t;
+
+typedef enum
+{
+     CLOSE = 0,    // make it easy for initialization
+     ACTIVE_OPEN, PASIVE_OPEN, RCV_SYN, RCV_ACK, RCV_SYNACK, RCV_FIN, RCV_FINACK, RX_PACKET, RCV_RST, RCV_RSTACK,
+     RCV_PSHACK, TIMEOUT,
+     NOP // dummy state, I will remove it later
+}tcpEvent_t;
+
+// add socket states to be used in the application
+typedef enum
+{
+    NOT_A_SOCKET = 0,           // This is not a socket
+    SOCKET_CLOSED,              // Socket closed
+    SOCKET_IN_PROGRESS,         // The TCP listen or initiate a connection
+    SOCKET_CONNECTED,           // The TCP is in established state user can send/receive data
+    SOCKET_CLOSING              // The user initiate the closing procedure for this socket
+} socketState_t;
+
+typedef struct
+{
+    uint32_t localIP;
+    uint16_t localPort;
+    uint32_t remoteIP;
+    uint16_t remotePort;
+}tcpSocket_t;
+
+typedef enum
+{
+    NO_BUFF = 0,
+    RX_BUFF_IN_USE,
+    TX_BUFF_IN_USE,
+    RX_HANDLER_IN_USE
+}tcpBufferState_t;
+
+// Receive handler of a socket, called with the number of payload bytes of
+// the segment that can be read in place with TCP_RxRead/TCP_RxPeek/TCP_RxDump
+typedef void (*tcpRxHandler_t)(uint16_t length);
+
+typedef struct
+{
+    uint16_t localPort;             // this is the local port
+
+    uint32_t destIP;
+    uint16_t destPort;
+
+    uint32_t remoteSeqno;
+    uint32_t remoteAck;             // last ack packet sent to remote
+
+    uint32_t localSeqno;
+    uint32_t localLastAck;          // last ack number received
+
+    uint16_t remoteWnd;             // sender window
+    uint16_t localWnd;              // receiver window
+    
+    uint16_t mss;
+
+    uint8_t *rxBufferStart;
+    uint8_t *rxBufferPtr;           // pointer to write inside the rx buffer
+    tcpBufferState_t rxBufState;
+    tcpRxHandler_t rxHandler;       // reads the payload in place instead of the rx buffer
+
+    uint8_t *txBufferStart;
+    uint8_t *txBufferPtr;
+    uint16_t bytesToSend;
+    tcpBufferState_t txBufState;
+    uint16_t bytesSent;
+    uint8_t segHead;                // oldest segment in flight
+    uint8_t segCount;               // segments sent and not acknowledged
+    uint16_t segLength[TCP_MAX_SEGMENTS_IN_FLIGHT];  // their payload, from localLastAck + 1 on
+#ifndef TCP_TX_IN_APP_RAM
+    sramBlock_t txBlock;            // copy of the tx buffer, SRAM_NO_BLOCK if the data is sent in place
+    uint16_t txSumOffset;           // payload of the last segment sent and its sum, reused when
+    uint16_t txSumLength;           // the same bytes are sent again
+    uint16_t txSum;
+#endif
+    bool payloadSave;
+
+    tcp_fsm_states_t fsmState;      // connection state
+    tcpEvent_t connectionEvent;
+
+    // Linked List Pointers
+    void *nextTCB;                  // downstream list pointer
+    void *prevTCB;                  // upstream list pointer
+    void *nextHash;                 // next TCB in the same lookup bucket
+    uint8_t hashBucket;             // lookup bucket of destIP, destPort and localPort
+    void *listener;                 // tcpListener_t that owns the socket until it is accepted
+
+    uint16_t timeout;               // retransmission time-out in TMR1 periods
+    uint16_t timeoutReloadValue;
+    uint8_t timeoutsCount;          // number of retransmissions
+    uint16_t srtt;                  // smoothed round trip time in 1/8 TMR1 periods, 0 before the first one
+    uint16_t rttVar;                // its mean deviation in 1/4 TMR1 periods
+    uint16_t rto;                   // time-out of the data in flight, TMR1 periods
+    uint32_t rttSeqno;              // end of the segment timed, or the first byte not sent before
+    uint16_t rttStart;              // TCP_Update() count when the segment timed was sent
+    bool rttTiming;                 // a round trip is being timed
+    uint16_t rtoWaited;             // TMR1 periods the data in flight waited in time-outs, up to TCP_RTO_MAX_MS
+    uint8_t flags;                  // save the flags to be used for timeouts
+    uint8_t ackPending;             // segments received and not acknowledged yet
+    uint8_t ackDue;                 // timer1Periods when their ACK goes out
+
+    socketState_t socketState;     // socket state to be easy
+}tcpTCB_t;
+
+typedef struct
+{
+    uint16_t localPort;
+    tcpTCB_t *pool;                 // child sockets, owned by the listener until accepted
+    uint8_t poolSize;
+    uint8_t *rxBuffers;             // a receive buffer per child, back to back
+    uint16_t rxBufferSize;
+    uint8_t backlog;                // children in the handshake or waiting to be accepted, at most
+    uint8_t queueHead;
+    uint8_t queueCount;
+    tcpTCB_t *queue[TCP_LISTEN_BACKLOG_MAX];    // connected children in the order they connected
+} tcpListener_t;
+
+typedef struct
+{
+    uint32_t lookups;               // received segments looked up
+    uint32_t compares;              // TCBs compared while looking them up
+} tcpLookupStats_t;
+
+extern tcpLookupStats_t tcpLookupStats;
+
+typedef enum
+{
+TCP_EOP = 0u,        // length = 0   End of Option List,[RFC793]
+TCP_NOP = 1u,        // length = 0   No-Operation,[RFC793]
+TCP_MSS = 2u,        // length = 4   Maximum Segment Size,[RFC793]
+
+// this options are not implemented
+#ifdef ALL_TCP_HEADER_OPTIONS
+TCP_WIN_SCALE = 3,  // length = 3   Window Scale,[RFC7323]
+TCP_SACK = 4,       // length = 2   SACK Permitted,[RFC2018]
+
+5                   // length = N   SACK,[RFC2018]
+6                   // length = 6   Echo (obsoleted by option 8),[RFC1072][RFC6247]
+7                   // length = 6   Echo Reply (obsoleted by option 8),[RFC1072][RFC6247]
+8                   // length = 10  Timestamps,[RFC7323]
+9                   // length = 2   Partial Order Connection Permitted (obsolete),[RFC1693][RFC6247]
+10                  // length = 3   Partial Order Service Profile (obsolete),[RFC1693][RFC6247]
+11                  // length = 0   CC (obsolete),[RFC1644][RFC6247]
+12                  // length = 0   CC.NEW (obsolete),[RFC1644][RFC6247]
+13                  // length = 0   CC.ECHO (obsolete),[RFC1644][RFC6247]
+14                  // length = 3   TCP Alternate Checksum Request (obsolete),[RFC1146][RFC6247]
+15                  // length = N   TCP Alternate Checksum Data (obsolete),[RFC1146][RFC6247]
+16                  // length = 0   Skeeter,[Stev_Knowles]
+17                  // length = 0   Bubba,[Stev_Knowles]
+18                  // length = 3   Trailer Checksum Option,[Subbu_Subramaniam][Monroe_Bridges]
+19                  // length = 18  MD5 Signature Option (obsoleted by option 29),[RFC2385]
+20                  // length = 0   SCPS Capabilities,[Keith_Scott]
+21                  // length = 0   Selective Negative Acknowledgements,[Keith_Scott]
+22                  // length = 0   Record Boundaries,[Keith_Scott]
+23                  // length = 0   Corruption experienced,[Keith_Scott]
+24                  // length = 0   SNAP,[Vladimir_Sukonnik]
+25                  // length = 0   Unassigned (released 2000-12-18),
+26                  // length = 0   TCP Compression Filter,[Steve_Bellovin]
+27                  // length = 8   Quick-Start Response,[RFC4782]
+28                  // length = 4   "User Timeout Option (also, other known unauthorized use) [***][1]",[RFC5482]
+29                  // length = 0   TCP Authentication Option (TCP-AO),[RFC5925]
+30                  // length = N   Multipath TCP (MPTCP),[RFC6824]
+31                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+32                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+33                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+34-75               // length = 0   Reserved,
+69                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+70                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+71-75               // length = 0   Reserved,
+76                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+77                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+78                  // length = 0   Reserved (known unauthorized use without proper IANA assignment) [**],
+79-252              // length = 0   Reserved,
+253                 // length = N   "RFC3692-style Experiment 1 (also improperly used for shipping products) [*]",[RFC4727]
+254                 // length = N   "RFC3692-style Experiment 2 (also improperly used for shipping products) [*]",[RFC4727]"
+#endif
+}tcp_options_t;
+
+
+/**
+  Section: TCP Public Interface Functions
+ */
+
+
+/*Initialize TCP structures
+ * This functions initializes some internal TCP stack variables
+ * 
+ * @param None
+ * 
+ * @param return
+ *      Nothing
+ * 
+ */
+void TCP_Init(void);
+
+
+/** Initialize the TCB and add it to the list of TCB pointers.
+ * Put the socket in the CLOSED state.
+ *
+ * The user is responsible to manage allocation and releasing of the memory.
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      -1 if there was any problems
+ * @return
+ *       0 if the insertion was successful.
+ */
+error_msg TCP_SocketInit(tcpTCB_t *tcb_ptr);   //jira: CAE_MCU8-5647
+
+
+/** Remove the socket pointer from the TCP Stack, actually the pointer will be
+ * removed from the list of TCB pointers. After calling this function the user
+ * can reuse the memory.
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      -1 if there was any problems
+ * @return
+ *       0 if the removing was successful.
+ */
+error_msg TCP_SocketRemove(tcpTCB_t *tcb_ptr);
+
+
+/** The function will provide an interface to read the status of the socket.
+ *  This function will also check if the pointer is already into the TCB list 
+ *  (this means that the socket is "in use"). If the socket is into the TCB list
+ * it will return the status for the socket.
+ * 
+ * @param tcb_ptr 
+ *      pointer to socket/TCB structure
+ *
+ * @return
+ *      the socket state
+ */
+socketState_t TCP_SocketPoll(tcpTCB_t *tcbPtr);
+
+
+/** Assign a port number to the specified socket.
+ * This is used for configure the local port of a socket.
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @param port
+ *      port number to be used as a local port. 
+ * 
+ * @return
+ *      true - The port was initialized successfully
+ * @return
+ *      false - The initialization fails 
+ */
+error_msg TCP_Bind(tcpTCB_t *tcbPtr, uint16_t port);    //jira: CAE_MCU8-5647
+
+
+/** Listen for connections on a socket.
+ *  It marks the socket as a passive socket, that is, as a socket that 
+ *  will be used to accept incoming connection requests.
+ *  
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @param port
+ *      port number used as a local port to listen on. 
+ * 
+ * @return
+ *      true - The server was started successfully
+ * @return
+ *      false - The starting of the server fails
+ */
+error_msg TCP_Listen(tcpTCB_t *tcbPtr);    //jira: CAE_MCU8-5647
+
+
+/** Listen for connections on a port with a pool of sockets.
+ *  Up to backlog sockets of the pool listen at once; a connection that
+ *  completes the handshake waits in the accept queue for TCP_Accept(), and
+ *  the next free socket of the pool takes its place.  The application owns
+ *  the accepted sockets until it removes them with TCP_SocketRemove(), the
+ *  listener then takes them back.
+ *
+ *  The user is responsible to manage allocation and releasing of the memory.
+ *
+ * @param listener
+ *      pointer to the listener structure
+ *
+ * @param port
+ *      port number used as a local port to listen on
+ *
+ * @param pool
+ *      poolSize sockets for the connections
+ *
+ * @param poolSize
+ *      number of sockets in the pool
+ *
+ * @param rxBuffers
+ *      poolSize receive buffers of rxBufferSize bytes, back to back, inserted
+ *      in the sockets as they start listening
+ *
+ * @param rxBufferSize
+ *      size of each receive buffer
+ *
+ * @param backlog
+ *      connections in the handshake or waiting to be accepted, at most
+ *      TCP_LISTEN_BACKLOG_MAX
+ *
+ * @return
+ *      SUCCESS - The listener was started
+ * @return
+ *      ERROR - A parameter was not valid
+ */
+error_msg TCP_ListenerInit(tcpListener_t *listener, uint16_t port, tcpTCB_t *pool, uint8_t poolSize,
+                           uint8_t *rxBuffers, uint16_t rxBufferSize, uint8_t backlog);
+
+
+/** Take the next connection of the accept queue.
+ *  This function needs to be called periodically, it also puts the sockets
+ *  the application has removed back to listening.
+ *
+ * @param listener
+ *      pointer to the listener structure
+ *
+ * @return
+ *      pointer to the connected socket/TCB structure, NULL if no connection waits
+ */
+tcpTCB_t *TCP_Accept(tcpListener_t *listener);
+
+
+/** Start the client for a particular socket.
+ *  
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @param port
+ *      port number used as a local port to listen on. 
+ * 
+ * @return
+ *      true - The server was started successfully
+ * @return
+ *      false - The starting of the server fails
+ */
+error_msg TCP_Connect(tcpTCB_t *tcbPtr, sockaddr_in4_t *srvaddr);    //jira: CAE_MCU8-5647
+
+
+/** Close the TCP connection.
+ * This will initiate the Closing sequence for the TCP connection.
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      true - The Close procedure was started successfully
+ * @return
+ *      false - The Close procedure fails
+ */
+error_msg TCP_Close(tcpTCB_t *tcbPtr);     //jira: CAE_MCU8-5647
+
+
+/** Send a buffer to a remote machine using a TCP connection.
+ *  The function will add the buffer to the socket and the payload will be
+ *  send as soon as possible, up to TCP_MAX_SEGMENTS_IN_FLIGHT segments
+ *  before the first one is acknowledged.
+ *  Unless TCP_TX_IN_APP_RAM is defined the data is copied into the SRAM heap
+ *  when a free block can hold it.  Check TCP_SendCopied() before reusing the
+ *  buffer, otherwise it is sent from and must be kept until TCP_SendDone().
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      true - The buffer was added to the socket/TCB successfully
+ * @return
+ *      false - Adding the buffer to the socket fails
+ */
+error_msg TCP_Send(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t dataLen);    //jira: CAE_MCU8-5647
+
+
+/** Check if the TX buffer was send.
+ *  This means that the data was received correctly by the remote machine and 
+ *  the TX buffer memory can be reused by the application.
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      true - The buffer was transmitted successfully
+ * @return
+ *      false - Buffer transmission fails or wasn't sent yet.
+ */
+error_msg TCP_SendDone(tcpTCB_t *tcbPtr);    //jira: CAE_MCU8-5647
+
+
+/** Check if the TX buffer was copied.
+ *  The data of the last TCP_Send() is sent from a copy in the SRAM heap, so
+ *  the application may reuse its buffer before TCP_SendDone().
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ * 
+ * @return
+ *      true - The data is sent from the SRAM heap
+ * @return
+ *      false - The data is sent from the application buffer, or was sent
+ */
+bool TCP_SendCopied(tcpTCB_t *tcbPtr);
+
+
+/** Will add the RX buffer to the socket.
+ *
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ *
+ * @param data
+ *      Pointer to the data buffer
+ *
+ * @param data_len
+ *      Size of the buffer
+ *
+ * @return
+ *      true - The buffer was  passed to socket successfully
+ * @return
+ *      false - passing of the buffer to the socket failed.
+ */
+error_msg TCP_InsertRxBuffer(tcpTCB_t *tcbPtr, uint8_t *data, uint16_t dataLen);    //jira: CAE_MCU8-5647
+
+
+/** Will add a receive handler to the socket instead of an RX buffer.
+ *  The handler is called for each received segment while the payload is
+ *  still in the Ethernet RX buffer and consumes it with TCP_RxRead() or
+ *  TCP_RxDump(). Only the consumed bytes are acknowledged, the remote
+ *  sends the rest again. The socket advertises TCP_RX_HANDLER_WINDOW.
+ *
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ *
+ * @param handler
+ *      receive handler
+ *
+ * @return
+ *      true - The handler was passed to socket successfully
+ * @return
+ *      false - passing of the handler to the socket failed.
+ */
+error_msg TCP_InsertRxHandler(tcpTCB_t *tcbPtr, tcpRxHandler_t handler);
+
+
+/** Read and consume payload bytes of the current segment.
+ *  Only valid inside a receive handler.
+ *
+ * @param data
+ *      Pointer to the destination
+ *
+ * @param len
+ *      Number of bytes to read
+ *
+ * @return
+ *      Number of bytes read
+ */
+uint16_t TCP_RxRead(void *data, uint16_t len);
+
+
+/** Read payload bytes of the current segment without consuming them.
+ *  Only valid inside a receive handler.
+ *
+ * @param data
+ *      Pointer to the destination
+ *
+ * @param len
+ *      Number of bytes to read
+ *
+ * @return
+ *      Number of bytes read
+ */
+uint16_t TCP_RxPeek(void *data, uint16_t len);
+
+
+/** Consume payload bytes of the current segment without reading them.
+ *  Only valid inside a receive handler.
+ *
+ * @param len
+ *      Number of bytes to consume
+ *
+ * @return
+ *      Number of bytes consumed
+ */
+uint16_t TCP_RxDump(uint16_t len);
+
+
+/** This function will read the available data from the socket.
+ *  The function will provide to the user also the start address of the 
+ *  received buffer.
+ * 
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure 
+ * 
+ * @return
+ *      Number of received bytes in the buffer
+ *      
+ */
+int16_t TCP_GetReceivedData(tcpTCB_t *tcbPtr);
+
+
+/** This function will check and return the number of available bytes received
+ *  on a socket.
+ *
+ * @param tcb_ptr
+ *      pointer to the socket/TCB structure
+ *
+ * @return
+ *      Number of received bytes in the buffer
+ *
+ */
+int16_t TCP_GetRxLength(tcpTCB_t *tcbPtr);
+
+
+/** This function needs to be called every TMR1 period in order to handle
+ *  the TCP stack timeouts for each available socket.
+ *
+ * @param
+ *      None
+ *
+ * @return
+ *      None
+ */
+void TCP_Update(void);
+
+
+/** This function needs to be called on every pass of the main loop in order
+ *  to send the data that the remote window allows but that did not fit in
+ *  the TX buffer when the last ACK arrived, and the delayed ACKs that no
+ *  data carried within TCP_DELAYED_ACK_MS.
+ *
+ * @param
+ *      None
+ *
+ * @return
+ *      None
+ */
+void TCP_SendPending(void);
+
+#endif  /* TCPV4_H */
+
@@ -1,67 +1,91 @@
-/**
-  UDP protocol v4 implementation
-	
-  Company:
-    Microchip Technology Inc.
-
-  File Name:
-    udpv4_port_handler_table.c
-
-  Summary:
-     This is the implementation of UDP version 4 protocol
-
-  Description:
-    This source file provides the implementation of the API for the UDP v4 protocol.
-
- */
-
-/*
-
-©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
-and any derivatives exclusively with Microchip products. 
-  
-THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
-IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
-NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
-INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
-IN ANY APPLICATION. 
-
-IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
-OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
-TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
-OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
-TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
-THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
-
-MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
-
-*/
-
-#include <stdio.h>
-#include "tcpip_config.h"
-#include "udpv4_port_handler_table.h"
-
-const udp_handler_t UDP_CallBackTable[] = \
-{    
-};
-
-// ***************** Leave the stuff below this line alone *********************
-
-udp_table_iterator_t udp_table_getIterator(void)
-{
-    return (udp_table_iterator_t) UDP_CallBackTable;
-}
-
-udp_table_iterator_t udp_table_nextEntry(udp_table_iterator_t i)
-{
-    i ++;
-    if(i < UDP_CallBackTable + sizeof(UDP_CallBackTable))
-    {
-        return (udp_table_iterator_t) i;
-    }
-    else
-        return (udp_table_iterator_t) NULL;
-}
-
-
-
+/**
+  UDP protocol v4 implementation
+	
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    udpv4_port_handler_table.c
+
+  Summary:
+     This is the implementation of UDP version 4 protocol
+
+  Description:
+    This source file provides the implementation of the API for the UDP v4 protocol.
+
+ */
+
+/*
+
+©  [2015] Microchip Technology Inc. and its subsidiaries.  You may use this software 
+and any derivatives exclusively with Microchip products. 
+  
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS".  NO WARRANTIES, WHETHER EXPRESS, 
+IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF 
+NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE, OR ITS 
+INTERACTION WITH MICROCHIP PRODUCTS, COMBINATION WITH ANY OTHER PRODUCTS, OR USE 
+IN ANY APPLICATION. 
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL 
+OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED 
+TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY 
+OR THE DAMAGES ARE FORESEEABLE.  TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S 
+TOTAL LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED 
+THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+
+MICROCHIP PROVIDES THIS SOFTWARE CONDITIONALLY UPON YOUR ACCEPTANCE OF THESE TERMS. 
+
+*/
+
+#include <stdio.h>
+#include "tcpip_config.h"
+#include "udpv4_port_handler_table.h"
+#include "net_stats.h"
+
+const udp_handler_t UDP_CallBackTable[] = \
+{    
+    {NET_STATS_PORT, NET_StatsReceive, true},   // served by the stack, queried by unicast
+};
+
+// ***************** Leave the stuff below this line alone *********************
+
+#define UDP_TABLE_SIZE (sizeof(UDP_CallBackTable) / sizeof(udp_handler_t))
+
+udp_table_iterator_t udp_table_getIterator(void)
+{
+    if(UDP_TABLE_SIZE == 0)
+    {
+        return (udp_table_iterator_t) NULL;
+    }
+    return (udp_table_iterator_t) UDP_CallBackTable;
+}
+
+udp_table_iterator_t udp_table_nextEntry(udp_table_iterator_t i)
+{
+    i ++;
+    if(i < UDP_CallBackTable + UDP_TABLE_SIZE)
+    {
+        return (udp_table_iterator_t) i;
+    }
+    else
+        return (udp_table_iterator_t) NULL;
+}
+
+// true if a port in the table takes broadcast datagrams
+bool udp_table_takesBroadcasts(void)
+{
+    udp_table_iterator_t i = udp_table_getIterator();
+
+    while(i != NULL)
+    {
+        if(!i->unicastOnly)
+        {
+            return true;
+        }
+        i = udp_table_nextEntry(i);
+    }
+    return false;
+}
+
+
+
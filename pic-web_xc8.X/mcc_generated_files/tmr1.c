@@ -1,185 +1,248 @@
-/**
-  TMR1 Generated Driver File
-
-  @Company
-    Microchip Technology Inc.
-
-  @File Name
-    tmr1.c
-
-  @Summary
-    This is the generated driver implementation file for the TMR1 driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
-
-  @Description
-    This source file provides APIs for TMR1.
-    Generation Information :
-        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
-        Device            :  PIC18F67J60
-        Driver Version    :  2.01
-    The generated drivers are tested against the following:
-        Compiler          :  XC8 2.31 and above
-        MPLAB 	          :  MPLAB X 5.45
-*/
-
-/*
-    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
-    
-    Subject to your compliance with these terms, you may use Microchip software and any 
-    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
-    license terms applicable to your use of third party software (including open source software) that 
-    may accompany Microchip software.
-    
-    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
-    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
-    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
-    FOR A PARTICULAR PURPOSE.
-    
-    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
-    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
-    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
-    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
-    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
-    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
-    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
-    SOFTWARE.
-*/
-
-/**
-  Section: Included Files
-*/
-
-#include <xc.h>
-#include "tmr1.h"
-
-/**
-  Section: Global Variable Definitions
-*/
-volatile uint16_t timer1ReloadVal;
-void (*TMR1_InterruptHandler)(void);
-
-/**
-  Section: TMR1 APIs
-*/
-
-void TMR1_Initialize(void)
-{
-    //Set the Timer to the options selected in the GUI
-	
-	// TMR1H 1; 
-		TMR1H = 0x01;
-	
-	// TMR1L 176; 
-		TMR1L = 0xB0;
-
-    // Load the TMR value to reload variable
-    timer1ReloadVal=TMR1;
-
-    // Clearing IF flag before enabling the interrupt.
-    PIR1bits.TMR1IF = 0;
-
-    // Enabling TMR1 interrupt.
-    PIE1bits.TMR1IE = 1;
-
-    // Set Default Interrupt Handler
-    TMR1_SetInterruptHandler(TMR1_DefaultInterruptHandler);
-
-    // T1CKPS 1:8; T1OSCEN disabled; TMR1CS FOSC/4; nT1SYNC synchronize; TMR1ON enabled; RD16 disabled; 
-    T1CON = 0x31;
-}
-
-void TMR1_StartTimer(void)
-{
-    // Start the Timer by writing to TMRxON bit
-    T1CONbits.TMR1ON = 1;
-}
-
-void TMR1_StopTimer(void)
-{
-    // Stop the Timer by writing to TMRxON bit
-    T1CONbits.TMR1ON = 0;
-}
-
-uint16_t TMR1_ReadTimer(void)
-{
-    uint16_t readVal;
-    uint8_t readValHigh;
-    uint8_t readValLow;
-	
-    T1CONbits.RD16 = 1;
-	
-    readValLow = TMR1L;
-    readValHigh = TMR1H;
-    
-    readVal = ((uint16_t)readValHigh << 8) | readValLow;
-
-    return readVal;
-}
-
-void TMR1_WriteTimer(uint16_t timerVal)
-{
-    if (T1CONbits.nT1SYNC == 1)
-    {
-        // Stop the Timer by writing to TMRxON bit
-        T1CONbits.TMR1ON = 0;
-
-        // Write to the Timer1 register
-        TMR1H = (uint8_t)(timerVal >> 8);
-        TMR1L = (uint8_t)timerVal;
-
-        // Start the Timer after writing to the register
-        T1CONbits.TMR1ON =1;
-    }
-    else
-    {
-        // Write to the Timer1 register
-        TMR1H = (uint8_t)(timerVal >> 8);
-        TMR1L = (uint8_t)timerVal;
-    }
-}
-
-void TMR1_Reload(void)
-{
-    TMR1_WriteTimer(timer1ReloadVal);
-}
-
-void TMR1_ISR(void)
-{
-    static volatile uint16_t CountCallBack = 0;
-
-    // Clear the TMR1 interrupt flag
-    PIR1bits.TMR1IF = 0;    
-    TMR1_WriteTimer(timer1ReloadVal);
-
-    // callback function - called every 20th pass
-    if (++CountCallBack >= TMR1_INTERRUPT_TICKER_FACTOR)
-    {
-        // ticker function call
-        TMR1_CallBack();
-
-        // reset ticker counter
-        CountCallBack = 0;
-    }
-}
-
-void TMR1_CallBack(void)
-{
-    // Add your custom callback code here
-
-    if(TMR1_InterruptHandler)
-    {
-        TMR1_InterruptHandler();
-    }
-}
-
-void TMR1_SetInterruptHandler(void (* InterruptHandler)(void)){
-    TMR1_InterruptHandler = InterruptHandler;
-}
-
-void TMR1_DefaultInterruptHandler(void){
-    // add your TMR1 interrupt custom code
-    // or set custom function using TMR1_SetInterruptHandler()
-}
-
-/**
- End of File
-*/
+/**
+  TMR1 Generated Driver File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    tmr1.c
+
+  @Summary
+    This is the generated driver implementation file for the TMR1 driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This source file provides APIs for TMR1.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F67J60
+        Driver Version    :  2.01
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB 	          :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include "tmr1.h"
+
+/**
+  Section: Global Variable Definitions
+*/
+volatile uint16_t timer1ReloadVal;
+volatile uint8_t timer1Periods;
+void (*TMR1_InterruptHandler)(void);
+
+/**
+  Section: TMR1 APIs
+*/
+
+void TMR1_Initialize(void)
+{
+    //Set the Timer to the options selected in the GUI
+	
+	// TMR1H 1; 
+		TMR1H = 0x01;
+	
+	// TMR1L 176; 
+		TMR1L = 0xB0;
+
+    // Load the TMR value to reload variable
+    timer1ReloadVal=TMR1;
+
+    // Clearing IF flag before enabling the interrupt.
+    PIR1bits.TMR1IF = 0;
+
+    // Enabling TMR1 interrupt.
+    PIE1bits.TMR1IE = 1;
+
+    // Set Default Interrupt Handler
+    TMR1_SetInterruptHandler(TMR1_DefaultInterruptHandler);
+
+    // T1CKPS 1:8; T1OSCEN disabled; TMR1CS FOSC/4; nT1SYNC synchronize; TMR1ON enabled; RD16 disabled; 
+    T1CON = 0x31;
+}
+
+void TMR1_StartTimer(void)
+{
+    // Start the Timer by writing to TMRxON bit
+    T1CONbits.TMR1ON = 1;
+}
+
+void TMR1_StopTimer(void)
+{
+    // Stop the Timer by writing to TMRxON bit
+    T1CONbits.TMR1ON = 0;
+}
+
+uint16_t TMR1_ReadTimer(void)
+{
+    uint16_t readVal;
+    uint8_t readValHigh;
+    uint8_t readValLow;
+	
+    T1CONbits.RD16 = 1;
+	
+    readValLow = TMR1L;
+    readValHigh = TMR1H;
+    
+    readVal = ((uint16_t)readValHigh << 8) | readValLow;
+
+    return readVal;
+}
+
+void TMR1_WriteTimer(uint16_t timerVal)
+{
+    if (T1CONbits.nT1SYNC == 1)
+    {
+        // Stop the Timer by writing to TMRxON bit
+        T1CONbits.TMR1ON = 0;
+
+        // Write to the Timer1 register
+        TMR1H = (uint8_t)(timerVal >> 8);
+        TMR1L = (uint8_t)timerVal;
+
+        // Start the Timer after writing to the register
+        T1CONbits.TMR1ON =1;
+    }
+    else
+    {
+        // Write to the Timer1 register
+        TMR1H = (uint8_t)(timerVal >> 8);
+        TMR1L = (uint8_t)timerVal;
+    }
+}
+
+void TMR1_Reload(void)
+{
+    TMR1_WriteTimer(timer1ReloadVal);
+}
+
+uint16_t TMR1_ElapsedTicks(uint16_t start)
+{
+    uint16_t now = TMR1_ReadTimer();
+
+    if(now >= start)
+    {
+        return now - start;
+    }
+    // the timer overflowed, it counts on from 0 until the interrupt reloads it
+    if(now < timer1ReloadVal)
+    {
+        return (uint16_t)(0u - start) + now;
+    }
+    return (uint16_t)(0u - start) + (now - timer1ReloadVal);
+}
+
+void TMR1_ReadStamp(tmr1Stamp_t *stamp)
+{
+    uint8_t periods;
+    uint16_t now;
+
+    // read again if the interrupt counted a period in between
+    do
+    {
+        periods = timer1Periods;
+        now = TMR1_ReadTimer();
+    } while(periods != timer1Periods);
+
+    if(now < timer1ReloadVal)
+    {
+        // the timer overflowed, the interrupt has not reloaded it yet
+        stamp->periods = periods + 1u;
+        stamp->ticks = now;
+    }
+    else
+    {
+        stamp->periods = periods;
+        stamp->ticks = now - timer1ReloadVal;
+    }
+}
+
+uint16_t TMR1_ElapsedSince(const tmr1Stamp_t *stamp)
+{
+    tmr1Stamp_t now;
+    int32_t elapsed;
+
+    TMR1_ReadStamp(&now);
+    elapsed = (int32_t)(uint8_t)(now.periods - stamp->periods) * (uint16_t)(0u - timer1ReloadVal)
+              + (int32_t)now.ticks - (int32_t)stamp->ticks;
+    if(elapsed < 0)
+    {
+        // ticks counted past the overflow are lost when the interrupt reloads
+        return 0;
+    }
+    if(elapsed > 0xFFFF)
+    {
+        return 0xFFFF;
+    }
+    return (uint16_t)elapsed;
+}
+
+void TMR1_ISR(void)
+{
+    static volatile uint16_t CountCallBack = 0;
+
+    // Clear the TMR1 interrupt flag
+    PIR1bits.TMR1IF = 0;    
+    TMR1_WriteTimer(timer1ReloadVal);
+    timer1Periods++;
+
+    // callback function - called every 20th pass
+    if (++CountCallBack >= TMR1_INTERRUPT_TICKER_FACTOR)
+    {
+        // ticker function call
+        TMR1_CallBack();
+
+        // reset ticker counter
+        CountCallBack = 0;
+    }
+}
+
+void TMR1_CallBack(void)
+{
+    // Add your custom callback code here
+
+    if(TMR1_InterruptHandler)
+    {
+        TMR1_InterruptHandler();
+    }
+}
+
+void TMR1_SetInterruptHandler(void (* InterruptHandler)(void)){
+    TMR1_InterruptHandler = InterruptHandler;
+}
+
+void TMR1_DefaultInterruptHandler(void){
+    // add your TMR1 interrupt custom code
+    // or set custom function using TMR1_SetInterruptHandler()
+}
+
+/**
+ End of File
+*/
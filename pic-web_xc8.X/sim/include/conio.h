@@ -0,0 +1,10 @@
+/**
+  Host stand-in for the XC8 console header
+*/
+
+#ifndef SIM_CONIO_H
+#define SIM_CONIO_H
+
+void putch(char c);
+
+#endif // SIM_CONIO_H
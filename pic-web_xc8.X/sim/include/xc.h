@@ -0,0 +1,467 @@
+/**
+  Host stand-in for the XC8 device header
+
+  Summary:
+    Lets the firmware sources compile with a host C compiler.
+
+  Description:
+    Every special function register used by the project is mapped onto a
+    register file owned by the J60 model (sim/j60_model.c).  Each register
+    access goes through J60_Sfr(), which lets the model advance its clock,
+    react to the previous register write (DMAST, TXRTS, PKTDEC, MIIRD ...)
+    and dispatch the interrupt routine, much like the silicon would between
+    two instructions.
+
+    Only the registers the project touches are described here, with the bit
+    layout of the PIC18F97J60 family data sheet.
+*/
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include <stdint.h>
+
+#define __interrupt(...)
+#define __at(address)
+#define asm(instruction)    J60_Asm(instruction)
+#define NOP()               J60_Nop()
+#define RESET()             J60_SystemReset()
+#define CLRWDT()
+#define di()                (INTCONbits.GIE = 0)
+#define ei()                (INTCONbits.GIE = 1)
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned :2;
+        unsigned RXEN:1;
+        unsigned TXRTS:1;
+        unsigned CSUMEN:1;
+        unsigned DMAST:1;
+        unsigned RXRST:1;
+        unsigned TXRST:1;
+    } bits;
+} sfrECON1_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned :5;
+        unsigned ETHEN:1;
+        unsigned PKTDEC:1;
+        unsigned AUTOINC:1;
+    } bits;
+} sfrECON2_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned PHYRDY:1;
+        unsigned TXABRT:1;
+        unsigned RXBUSY:1;
+        unsigned :3;
+        unsigned BUFER:1;
+        unsigned :1;
+    } bits;
+} sfrESTAT_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned RXERIE:1;
+        unsigned TXERIE:1;
+        unsigned :1;
+        unsigned TXIE:1;
+        unsigned LINKIE:1;
+        unsigned DMAIE:1;
+        unsigned PKTIE:1;
+        unsigned :1;
+    } bits;
+} sfrEIE_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned RXERIF:1;
+        unsigned TXERIF:1;
+        unsigned :1;
+        unsigned TXIF:1;
+        unsigned LINKIF:1;
+        unsigned DMAIF:1;
+        unsigned PKTIF:1;
+        unsigned :1;
+    } bits;
+} sfrEIR_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned BCEN:1;
+        unsigned MCEN:1;
+        unsigned HTEN:1;
+        unsigned MPEN:1;
+        unsigned PMEN:1;
+        unsigned CRCEN:1;
+        unsigned ANDOR:1;
+        unsigned UCEN:1;
+    } bits;
+} sfrERXFCON_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned FCEN:2;
+        unsigned FULDPXS:1;
+        unsigned :5;
+    } bits;
+} sfrEFLOCON_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned MIIRD:1;
+        unsigned MIISCAN:1;
+        unsigned :6;
+    } bits;
+} sfrMICMD_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned BUSY:1;
+        unsigned SCAN:1;
+        unsigned NVALID:1;
+        unsigned :5;
+    } bits;
+} sfrMISTAT_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned RBIF:1;
+        unsigned INT0IF:1;
+        unsigned TMR0IF:1;
+        unsigned RBIE:1;
+        unsigned INT0IE:1;
+        unsigned TMR0IE:1;
+        unsigned PEIE:1;
+        unsigned GIE:1;
+    };
+    struct
+    {
+        unsigned :6;
+        unsigned GIEL:1;
+        unsigned GIEH:1;
+    };
+} sfrINTCON_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned TMR1IF:1;
+        unsigned TMR2IF:1;
+        unsigned CCP1IF:1;
+        unsigned SSP1IF:1;
+        unsigned TX1IF:1;
+        unsigned RC1IF:1;
+        unsigned ADIF:1;
+        unsigned PSPIF:1;
+    } bits;
+} sfrPIR1_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned TMR1IE:1;
+        unsigned TMR2IE:1;
+        unsigned CCP1IE:1;
+        unsigned SSP1IE:1;
+        unsigned TX1IE:1;
+        unsigned RC1IE:1;
+        unsigned ADIE:1;
+        unsigned PSPIE:1;
+    } bits;
+} sfrPIE1_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned CCP2IF:1;
+        unsigned TMR3IF:1;
+        unsigned :1;
+        unsigned BCL1IF:1;
+        unsigned :1;
+        unsigned ETHIF:1;
+        unsigned :1;
+        unsigned OSCFIF:1;
+    } bits;
+} sfrPIR2_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned CCP2IE:1;
+        unsigned TMR3IE:1;
+        unsigned :1;
+        unsigned BCL1IE:1;
+        unsigned :1;
+        unsigned ETHIE:1;
+        unsigned :1;
+        unsigned OSCFIE:1;
+    } bits;
+} sfrPIE2_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned TMR1ON:1;
+        unsigned TMR1CS:1;
+        unsigned nT1SYNC:1;
+        unsigned T1OSCEN:1;
+        unsigned T1CKPS:2;
+        unsigned T1RUN:1;
+        unsigned RD16:1;
+    } bits;
+} sfrT1CON_t;
+
+typedef union
+{
+    uint16_t w;
+    struct
+    {
+        uint8_t l;
+        uint8_t h;
+    } b;
+} sfr16_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned :7;
+        unsigned IPEN:1;
+    } bits;
+} sfrRCON_t;
+
+typedef union
+{
+    uint8_t v;
+    struct
+    {
+        unsigned PCFG:4;
+        unsigned VCFG:2;
+        unsigned :2;
+    } bits;
+} sfrADCON1_t;
+
+typedef struct
+{
+    // Ethernet control and status
+    sfrECON1_t      econ1;
+    sfrECON2_t      econ2;
+    sfrESTAT_t      estat;
+    sfrEIE_t        eie;
+    sfrEIR_t        eir;
+    uint8_t         epktcnt;
+    sfrERXFCON_t    erxfcon;
+    sfrEFLOCON_t    eflocon;
+    uint16_t        epaus;
+
+    // Ethernet buffer pointers
+    uint16_t        erdpt;
+    uint16_t        ewrpt;
+    uint16_t        etxst;
+    uint16_t        etxnd;
+    uint16_t        erxst;
+    uint16_t        erxnd;
+    uint16_t        erxrdpt;
+    uint16_t        erxwrpt;
+    uint16_t        edmast;
+    uint16_t        edmand;
+    uint16_t        edmadst;
+    uint16_t        edmacs;
+
+    // Receive filters
+    uint8_t         eht[8];
+    uint8_t         epmm[8];
+    uint16_t        epmcs;
+    uint16_t        epmo;
+
+    // MAC and MII
+    uint8_t         macon1;
+    uint8_t         macon3;
+    uint8_t         macon4;
+    uint8_t         mabbipg;
+    uint16_t        maipg;
+    uint16_t        mamxfl;
+    uint8_t         maadr[6];
+    uint8_t         miregadr;
+    uint16_t        miwr;
+    uint16_t        mird;
+    sfrMICMD_t      micmd;
+    sfrMISTAT_t     mistat;
+
+    // Core
+    sfrINTCON_t     intcon;
+    sfrRCON_t       rcon;
+    sfrPIR1_t       pir1;
+    sfrPIE1_t       pie1;
+    sfrPIR2_t       pir2;
+    sfrPIE2_t       pie2;
+    sfrT1CON_t      t1con;
+    sfr16_t         tmr1;
+    uint8_t         tmr1hBuffer;    // TMR1H as seen in 16-bit mode
+    uint8_t         osccon;
+    uint8_t         osctune;
+    sfrADCON1_t     adcon1;
+    uint8_t         lat[7];
+    uint8_t         tris[7];
+} j60Sfr_t;
+
+j60Sfr_t *J60_Sfr(void);
+uint16_t *J60_MiiWritePort(void);
+uint8_t *J60_Tmr1Low(void);
+uint8_t *J60_Tmr1High(void);
+uint8_t J60_EdataRead(void);
+void J60_EdataWrite(uint8_t data);
+void J60_Nop(void);
+void J60_Asm(const char *instruction);
+void J60_SystemReset(void);
+
+#define ECON1           (J60_Sfr()->econ1.v)
+#define ECON1bits       (J60_Sfr()->econ1.bits)
+#define ECON2           (J60_Sfr()->econ2.v)
+#define ECON2bits       (J60_Sfr()->econ2.bits)
+#define ESTAT           (J60_Sfr()->estat.v)
+#define ESTATbits       (J60_Sfr()->estat.bits)
+#define EIE             (J60_Sfr()->eie.v)
+#define EIEbits         (J60_Sfr()->eie.bits)
+#define EIR             (J60_Sfr()->eir.v)
+#define EIRbits         (J60_Sfr()->eir.bits)
+#define EPKTCNT         (J60_Sfr()->epktcnt)
+#define ERXFCON         (J60_Sfr()->erxfcon.v)
+#define ERXFCONbits     (J60_Sfr()->erxfcon.bits)
+#define EFLOCON         (J60_Sfr()->eflocon.v)
+#define EFLOCONbits     (J60_Sfr()->eflocon.bits)
+#define EPAUS           (J60_Sfr()->epaus)
+
+#define ERDPT           (J60_Sfr()->erdpt)
+#define EWRPT           (J60_Sfr()->ewrpt)
+#define ETXST           (J60_Sfr()->etxst)
+#define ETXND           (J60_Sfr()->etxnd)
+#define ERXST           (J60_Sfr()->erxst)
+#define ERXND           (J60_Sfr()->erxnd)
+#define ERXRDPT         (J60_Sfr()->erxrdpt)
+#define ERXWRPT         (J60_Sfr()->erxwrpt)
+#define EDMAST          (J60_Sfr()->edmast)
+#define EDMAND          (J60_Sfr()->edmand)
+#define EDMADST         (J60_Sfr()->edmadst)
+#define EDMACS          (J60_Sfr()->edmacs)
+
+#define EHT0            (J60_Sfr()->eht[0])
+#define EHT1            (J60_Sfr()->eht[1])
+#define EHT2            (J60_Sfr()->eht[2])
+#define EHT3            (J60_Sfr()->eht[3])
+#define EHT4            (J60_Sfr()->eht[4])
+#define EHT5            (J60_Sfr()->eht[5])
+#define EHT6            (J60_Sfr()->eht[6])
+#define EHT7            (J60_Sfr()->eht[7])
+#define EPMM0           (J60_Sfr()->epmm[0])
+#define EPMM1           (J60_Sfr()->epmm[1])
+#define EPMM2           (J60_Sfr()->epmm[2])
+#define EPMM3           (J60_Sfr()->epmm[3])
+#define EPMM4           (J60_Sfr()->epmm[4])
+#define EPMM5           (J60_Sfr()->epmm[5])
+#define EPMM6           (J60_Sfr()->epmm[6])
+#define EPMM7           (J60_Sfr()->epmm[7])
+#define EPMCS           (J60_Sfr()->epmcs)
+#define EPMO            (J60_Sfr()->epmo)
+
+#define MACON1          (J60_Sfr()->macon1)
+#define MACON3          (J60_Sfr()->macon3)
+#define MACON4          (J60_Sfr()->macon4)
+#define MABBIPG         (J60_Sfr()->mabbipg)
+#define MAIPG           (J60_Sfr()->maipg)
+#define MAMXFL          (J60_Sfr()->mamxfl)
+#define MAADR1          (J60_Sfr()->maadr[0])
+#define MAADR2          (J60_Sfr()->maadr[1])
+#define MAADR3          (J60_Sfr()->maadr[2])
+#define MAADR4          (J60_Sfr()->maadr[3])
+#define MAADR5          (J60_Sfr()->maadr[4])
+#define MAADR6          (J60_Sfr()->maadr[5])
+#define MIREGADR        (J60_Sfr()->miregadr)
+#define MIWR            (*J60_MiiWritePort())
+#define MIRD            (J60_Sfr()->mird)
+#define MICMD           (J60_Sfr()->micmd.v)
+#define MICMDbits       (J60_Sfr()->micmd.bits)
+#define MISTAT          (J60_Sfr()->mistat.v)
+#define MISTATbits      (J60_Sfr()->mistat.bits)
+
+#define INTCON          (J60_Sfr()->intcon.v)
+#define INTCONbits      (J60_Sfr()->intcon)
+#define RCONbits        (J60_Sfr()->rcon.bits)
+#define PIR1            (J60_Sfr()->pir1.v)
+#define PIR1bits        (J60_Sfr()->pir1.bits)
+#define PIE1            (J60_Sfr()->pie1.v)
+#define PIE1bits        (J60_Sfr()->pie1.bits)
+#define PIR2            (J60_Sfr()->pir2.v)
+#define PIR2bits        (J60_Sfr()->pir2.bits)
+#define PIE2            (J60_Sfr()->pie2.v)
+#define PIE2bits        (J60_Sfr()->pie2.bits)
+#define T1CON           (J60_Sfr()->t1con.v)
+#define T1CONbits       (J60_Sfr()->t1con.bits)
+#define TMR1            (J60_Sfr()->tmr1.w)
+#define TMR1L           (*J60_Tmr1Low())
+#define TMR1H           (*J60_Tmr1High())
+#define OSCCON          (J60_Sfr()->osccon)
+#define OSCTUNE         (J60_Sfr()->osctune)
+#define ADCON1bits      (J60_Sfr()->adcon1.bits)
+#define RXRST           (ECON1bits.RXRST)
+
+#define LATA            (J60_Sfr()->lat[0])
+#define LATB            (J60_Sfr()->lat[1])
+#define LATC            (J60_Sfr()->lat[2])
+#define LATD            (J60_Sfr()->lat[3])
+#define LATE            (J60_Sfr()->lat[4])
+#define LATF            (J60_Sfr()->lat[5])
+#define LATG            (J60_Sfr()->lat[6])
+#define TRISA           (J60_Sfr()->tris[0])
+#define TRISB           (J60_Sfr()->tris[1])
+#define TRISC           (J60_Sfr()->tris[2])
+#define TRISD           (J60_Sfr()->tris[3])
+#define TRISE           (J60_Sfr()->tris[4])
+#define TRISF           (J60_Sfr()->tris[5])
+#define TRISG           (J60_Sfr()->tris[6])
+
+#endif // SIM_XC_H
@@ -0,0 +1,893 @@
+/**
+  PIC18F97J60 Ethernet module model
+
+  Summary:
+    Implementation of the host model declared in j60_model.h.
+
+  Description:
+    J60_Step() is the heart of the model.  It runs before every register or
+    EDATA access and before every NOP, so whatever the firmware wrote with the
+    previous access (DMAST, TXRTS, PKTDEC, MIIRD, a new TMR1 value ...) takes
+    effect one instruction later, and long running operations (DMA, frame
+    transmission, frames arriving from the wire) complete when the cycle
+    counter reaches their end time.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "j60_model.h"
+
+#define SRAM_MASK               (J60_SRAM_SIZE - 1u)
+#define WIRE_QUEUE_SIZE         64u
+#define WIRE_MAX_FRAME          1536u
+#define TX_STATUS_VECTOR_SIZE   7u
+#define ISR_LATENCY_TCY         12u     // vectoring plus context save/restore
+
+// PHY registers
+#define PHY_PHSTAT1             0x01u
+#define PHY_PHSTAT2             0x11u
+#define PHY_PHIE                0x12u
+#define PHY_PHIR                0x13u
+#define PHSTAT1_LLSTAT          0x0004u
+#define PHSTAT2_LSTAT           0x0400u
+#define PHIE_PLNKIE             0x0010u
+#define PHIR_PLNKIF             0x0010u
+
+typedef struct
+{
+    uint64_t when;
+    uint16_t length;
+    uint8_t  data[WIRE_MAX_FRAME];
+} wireFrame_t;
+
+static j60Sfr_t j60Sfr;
+static uint8_t sram[J60_SRAM_SIZE];
+static uint16_t phy[32];
+static j60ModelStats_t stats;
+static wireFrame_t wire[WIRE_QUEUE_SIZE];
+static uint16_t wireCount;
+
+static struct
+{
+    uint64_t cycles;
+
+    sfrECON1_t econ1Seen;
+    uint16_t erxstSeen;
+    bool miwrPending;
+    bool miirdSeen;
+
+    uint16_t tmr1Count;
+    uint64_t tmr1Cycles;
+    uint32_t tmr1Prescale;
+    bool tmr1LowAccess;         // TMR1L was accessed in 16-bit mode
+    uint8_t tmr1HighWritten;    // TMR1H buffer before that access latched it
+
+    uint16_t rxWritePtr;
+    uint8_t packetCount;
+
+    bool txBusy;
+    uint64_t txDone;
+    uint16_t txLength;
+    uint8_t txFrame[WIRE_MAX_FRAME];
+
+    bool dmaBusy;
+    uint64_t dmaDone;
+    uint16_t dmaStalls;         // copies left that hang until aborted
+
+    uint8_t fcenSeen;
+    uint64_t pauseRepeat;       // next periodic PAUSE frame while FCEN is 10
+
+    uint64_t wireFreeAt;        // end of the last frame taken off the wire
+    uint64_t pauseFrom;         // the link partner holds frames it had not
+    uint64_t pauseUntil;        // started at pauseFrom until pauseUntil
+
+    bool inIsr;
+    void (*isr)(void);
+    j60TxHandler_t txHandler;
+} model;
+
+static bool J60_InStep;
+
+uint16_t J60_InetChecksum(const uint8_t *data, uint16_t length, uint32_t seed)
+{
+    uint32_t sum = seed;
+
+    while(length > 1)
+    {
+        sum += ((uint16_t)data[0] << 8) | data[1];
+        data += 2;
+        length -= 2;
+    }
+    if(length)
+    {
+        sum += (uint16_t)data[0] << 8;
+    }
+    while(sum >> 16)
+    {
+        sum = (sum & 0xFFFFu) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
+uint32_t J60_Crc32(const uint8_t *data, uint16_t length)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    uint8_t bit;
+
+    while(length--)
+    {
+        crc ^= *data++;
+        for(bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1u) ? 0xEDB88320u : 0u);
+        }
+    }
+    return ~crc;
+}
+
+static uint16_t J60_RxNext(uint16_t ptr)
+{
+    if(ptr == j60Sfr.erxnd)
+    {
+        return j60Sfr.erxst;
+    }
+    return (uint16_t)((ptr + 1u) & SRAM_MASK);
+}
+
+static uint16_t J60_RxSize(void)
+{
+    return (uint16_t)(j60Sfr.erxnd - j60Sfr.erxst + 1u);
+}
+
+static uint16_t J60_RxFree(void)
+{
+    uint16_t size = J60_RxSize();
+
+    return (uint16_t)((j60Sfr.erxrdpt + size - model.rxWritePtr) % size);
+}
+
+uint16_t J60_RxBufferUsed(void)
+{
+    return (uint16_t)(J60_RxSize() - 1u - J60_RxFree());
+}
+
+/*
+ * Walk the DMA source range the way the module does: a range that ends
+ * before it starts is inside the receive buffer and wraps at ERXND.
+ */
+static uint16_t J60_DmaLength(void)
+{
+    if(j60Sfr.edmand >= j60Sfr.edmast)
+    {
+        return (uint16_t)(j60Sfr.edmand - j60Sfr.edmast + 1u);
+    }
+    return (uint16_t)((j60Sfr.erxnd - j60Sfr.edmast + 1u) + (j60Sfr.edmand - j60Sfr.erxst + 1u));
+}
+
+static void J60_DmaComplete(void)
+{
+    uint16_t length = J60_DmaLength();
+    uint16_t src = j60Sfr.edmast;
+    uint16_t dst = j60Sfr.edmadst;
+    uint32_t sum = 0;
+    uint16_t i;
+
+    if(j60Sfr.econ1.bits.CSUMEN)
+    {
+        for(i = 0; i < length; i++)
+        {
+            sum += (i & 1u) ? sram[src] : ((uint16_t)sram[src] << 8);
+            src = (src == j60Sfr.erxnd && j60Sfr.edmand < j60Sfr.edmast) ? j60Sfr.erxst : (uint16_t)((src + 1u) & SRAM_MASK);
+        }
+        while(sum >> 16)
+        {
+            sum = (sum & 0xFFFFu) + (sum >> 16);
+        }
+        j60Sfr.edmacs = (uint16_t)~sum;
+        stats.dmaChecksums++;
+        stats.dmaChecksumBytes += length;
+    }
+    else
+    {
+        for(i = 0; i < length; i++)
+        {
+            sram[dst] = sram[src];
+            dst = (uint16_t)((dst + 1u) & SRAM_MASK);
+            src = (src == j60Sfr.erxnd && j60Sfr.edmand < j60Sfr.edmast) ? j60Sfr.erxst : (uint16_t)((src + 1u) & SRAM_MASK);
+        }
+        stats.dmaCopies++;
+        stats.dmaCopyBytes += length;
+    }
+    model.dmaBusy = false;
+    j60Sfr.econ1.bits.DMAST = 0;
+    model.econ1Seen.bits.DMAST = 0;
+    j60Sfr.eir.bits.DMAIF = 1;
+}
+
+static void J60_TxStart(void)
+{
+    uint16_t ptr = (uint16_t)(j60Sfr.etxst + 1u);   // skip the per packet control byte
+    uint16_t length = (uint16_t)(j60Sfr.etxnd - j60Sfr.etxst);
+    uint16_t i;
+
+    if(length > WIRE_MAX_FRAME - 4u)
+    {
+        length = WIRE_MAX_FRAME - 4u;
+    }
+    for(i = 0; i < length; i++)
+    {
+        model.txFrame[i] = sram[(ptr + i) & SRAM_MASK];
+    }
+    while(length < 60u)     // MACON3 pads short frames
+    {
+        model.txFrame[length++] = 0;
+    }
+    model.txLength = length;
+    model.txBusy = true;
+    // preamble/SFD, FCS and the inter packet gap at 0.8 us per byte
+    model.txDone = model.cycles + ((uint64_t)(length + 8u + 4u + 12u) * 25u) / 3u;
+}
+
+static void J60_TxComplete(void)
+{
+    uint16_t tsv = (uint16_t)(j60Sfr.etxnd + 1u);
+    uint8_t vector[TX_STATUS_VECTOR_SIZE] = {0};
+    uint8_t i;
+
+    vector[0] = (uint8_t)model.txLength;
+    vector[1] = (uint8_t)(model.txLength >> 8);
+    vector[2] = 0x80;       // transmit done
+    if(model.txFrame[0] & 0x01u)
+    {
+        vector[2] |= (model.txFrame[0] == 0xFFu) ? 0x20u : 0x10u;
+    }
+    for(i = 0; i < TX_STATUS_VECTOR_SIZE; i++)
+    {
+        sram[(tsv + i) & SRAM_MASK] = vector[i];
+    }
+
+    model.txBusy = false;
+    j60Sfr.econ1.bits.TXRTS = 0;
+    model.econ1Seen.bits.TXRTS = 0;
+    j60Sfr.eir.bits.TXIF = 1;
+    stats.txFrames++;
+    stats.txBytes += model.txLength;
+    if(model.txHandler)
+    {
+        model.txHandler(model.txFrame, model.txLength, model.cycles);
+    }
+}
+
+// the window may run into the FCS, so a minimum size frame can be matched
+// from offset 0
+static bool J60_PatternMatch(const uint8_t *frame, uint16_t length)
+{
+    uint8_t window[64];
+    uint8_t count = 0;
+    uint8_t i;
+    uint16_t at;
+    uint32_t fcs = J60_Crc32(frame, length);
+
+    if((uint32_t)j60Sfr.epmo + 64u > length + 4u)
+    {
+        return false;
+    }
+    for(i = 0; i < 64u; i++)
+    {
+        if(j60Sfr.epmm[i >> 3] & (1u << (i & 7u)))
+        {
+            at = (uint16_t)(j60Sfr.epmo + i);
+            window[count++] = (at < length) ? frame[at] : (uint8_t)(fcs >> (8u * (at - length)));
+        }
+    }
+    return J60_InetChecksum(window, count, 0) == j60Sfr.epmcs;
+}
+
+static bool J60_HashMatch(const uint8_t *frame)
+{
+    uint8_t pointer = (uint8_t)((J60_Crc32(frame, 6) >> 23) & 0x3Fu);
+
+    return (j60Sfr.eht[pointer >> 3] & (1u << (pointer & 7u))) != 0;
+}
+
+static bool J60_MagicPacket(const uint8_t *frame, uint16_t length)
+{
+    uint16_t i, j;
+    uint8_t sync;
+
+    for(i = 14; i + 102u <= length; i++)
+    {
+        for(sync = 0; sync < 6u && frame[i + sync] == 0xFFu; sync++);
+        if(sync < 6u)
+        {
+            continue;
+        }
+        for(j = 0; j < 96u && frame[i + 6u + j] == j60Sfr.maadr[j % 6u]; j++);
+        if(j == 96u)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool J60_FilterAccept(const uint8_t *frame, uint16_t length)
+{
+    sfrERXFCON_t fc = j60Sfr.erxfcon;
+    bool broadcast = memcmp(frame, "\xFF\xFF\xFF\xFF\xFF\xFF", 6) == 0;
+    bool multicast = (frame[0] & 0x01u) && !broadcast;
+    bool unicast = memcmp(frame, j60Sfr.maadr, 6) == 0;
+    bool any = false;
+    bool all = true;
+    bool match;
+
+    if((fc.v & 0x9Fu) == 0)     // no filter enabled: promiscuous
+    {
+        return true;
+    }
+#define J60_FILTER(enable, test)  if(enable) { match = (test); any |= match; all &= match; }
+    J60_FILTER(fc.bits.UCEN, unicast);
+    J60_FILTER(fc.bits.BCEN, broadcast);
+    J60_FILTER(fc.bits.MCEN, multicast);
+    J60_FILTER(fc.bits.HTEN, J60_HashMatch(frame));
+    J60_FILTER(fc.bits.PMEN, J60_PatternMatch(frame, length));
+    J60_FILTER(fc.bits.MPEN, (unicast || broadcast) && J60_MagicPacket(frame, length));
+#undef J60_FILTER
+    return fc.bits.ANDOR ? all : any;
+}
+
+static void J60_ReceiveFrame(const uint8_t *frame, uint16_t length)
+{
+    uint16_t total = (uint16_t)(length + 4u);           // frame plus FCS
+    uint16_t needed = (uint16_t)((6u + total + 1u) & ~1u);
+    uint16_t ptr = model.rxWritePtr;
+    uint16_t next;
+    uint32_t fcs;
+    uint8_t header[6];
+    uint16_t i;
+
+    if(!j60Sfr.econ2.bits.ETHEN || !j60Sfr.econ1.bits.RXEN)
+    {
+        return;
+    }
+    if(!J60_FilterAccept(frame, length))
+    {
+        stats.rxFiltered++;
+        return;
+    }
+    if(needed > J60_RxFree() || model.packetCount == 0xFFu)
+    {
+        stats.rxOverflows++;
+        j60Sfr.eir.bits.RXERIF = 1;
+        return;
+    }
+
+    next = ptr;
+    for(i = 0; i < needed; i++)
+    {
+        next = J60_RxNext(next);
+    }
+
+    header[0] = (uint8_t)next;
+    header[1] = (uint8_t)(next >> 8);
+    header[2] = (uint8_t)total;
+    header[3] = (uint8_t)(total >> 8);
+    header[4] = 0x80;       // received OK
+    header[5] = 0;
+    if(frame[0] & 0x01u)
+    {
+        header[5] |= (frame[0] == 0xFFu) ? 0x02u : 0x01u;
+    }
+    if(frame[12] == 0x88u && frame[13] == 0x08u)
+    {
+        header[5] |= (frame[14] == 0x00u && frame[15] == 0x01u) ? 0x0Cu : 0x04u;
+    }
+
+    for(i = 0; i < 6u; i++)
+    {
+        sram[ptr] = header[i];
+        ptr = J60_RxNext(ptr);
+    }
+    for(i = 0; i < length; i++)
+    {
+        sram[ptr] = frame[i];
+        ptr = J60_RxNext(ptr);
+    }
+    fcs = J60_Crc32(frame, length);
+    for(i = 0; i < 4u; i++)
+    {
+        sram[ptr] = (uint8_t)(fcs >> (8u * i));
+        ptr = J60_RxNext(ptr);
+    }
+
+    model.rxWritePtr = next;
+    model.packetCount++;
+    stats.rxFrames++;
+}
+
+static uint16_t J60_PhyRead(uint8_t reg)
+{
+    uint16_t value = phy[reg & 0x1Fu];
+
+    if((reg & 0x1Fu) == PHY_PHIR)
+    {
+        phy[PHY_PHIR] = 0;
+        j60Sfr.eir.bits.LINKIF = 0;
+    }
+    return value;
+}
+
+static uint64_t J60_WireTime(uint16_t length)
+{
+    // preamble, FCS and inter frame gap included, 0.8 us a byte
+    return ((uint64_t)((length < 60u ? 60u : length) + 24u) * 25u) / 3u;
+}
+
+static uint64_t J60_PauseTime(uint16_t quanta)
+{
+    // a pause quantum is 512 bit times, 51.2 us at 10 Mb/s
+    return ((uint64_t)quanta * 512u * 25u) / 24u;
+}
+
+// the MAC generates the PAUSE frame itself, it does not use the TX buffer
+static void J60_SendPause(uint16_t quanta)
+{
+    uint8_t frame[60] = {0x01, 0x80, 0xC2, 0x00, 0x00, 0x01};
+
+    memcpy(&frame[6], j60Sfr.maadr, 6);
+    frame[12] = 0x88;       // MAC control
+    frame[13] = 0x08;
+    frame[15] = 0x01;       // PAUSE
+    frame[16] = (uint8_t)(quanta >> 8);
+    frame[17] = (uint8_t)quanta;
+    stats.pauseFrames++;
+    if(model.txHandler)
+    {
+        model.txHandler(frame, sizeof(frame), model.cycles + J60_WireTime(sizeof(frame)));
+    }
+}
+
+// EFLOCON FCEN: 01 sends one PAUSE with the EPAUS time, 10 keeps sending them
+// (every half pause time here) and 11 sends a zero time PAUSE; 01 and 11 turn
+// flow control off again
+static void J60_RunFlowControl(void)
+{
+    uint8_t fcen = j60Sfr.eflocon.bits.FCEN;
+
+    if(fcen != model.fcenSeen)
+    {
+        switch(fcen)
+        {
+            case 1u:
+                J60_SendPause(j60Sfr.epaus);
+                j60Sfr.eflocon.bits.FCEN = 0;
+                break;
+            case 2u:
+                J60_SendPause(j60Sfr.epaus);
+                model.pauseRepeat = model.cycles + J60_PauseTime(j60Sfr.epaus) / 2u;
+                break;
+            case 3u:
+                J60_SendPause(0);
+                j60Sfr.eflocon.bits.FCEN = 0;
+                break;
+            default:
+                break;
+        }
+        model.fcenSeen = j60Sfr.eflocon.bits.FCEN;
+    }
+    else if(fcen == 2u && model.cycles >= model.pauseRepeat)
+    {
+        J60_SendPause(j60Sfr.epaus);
+        model.pauseRepeat = model.cycles + J60_PauseTime(j60Sfr.epaus) / 2u;
+    }
+}
+
+static void J60_CheckWrites(void)
+{
+    sfrECON1_t now = j60Sfr.econ1;
+
+    if(now.bits.TXRST)
+    {
+        model.txBusy = false;
+        j60Sfr.econ1.bits.TXRTS = 0;
+        now.bits.TXRTS = 0;
+    }
+    if(now.v & 0x40u)  // RXRST, spelled as a mask since xc.h also defines RXRST as a bit
+    {
+        model.rxWritePtr = j60Sfr.erxst;
+    }
+    if(now.bits.DMAST && !model.econ1Seen.bits.DMAST && !model.dmaBusy)
+    {
+        model.dmaBusy = true;
+        model.dmaDone = model.cycles + J60_DmaLength();
+        if(!now.bits.CSUMEN && model.dmaStalls)
+        {
+            model.dmaStalls--;
+            model.dmaDone = UINT64_MAX;     // only an abort ends it
+        }
+    }
+    else if(!now.bits.DMAST && model.dmaBusy)
+    {
+        model.dmaBusy = false;      // aborted by software
+    }
+    if(now.bits.TXRTS && !model.econ1Seen.bits.TXRTS && !model.txBusy)
+    {
+        J60_TxStart();
+    }
+    else if(!now.bits.TXRTS && model.txBusy)
+    {
+        model.txBusy = false;       // aborted by software
+    }
+    model.econ1Seen = j60Sfr.econ1;
+
+    if(j60Sfr.econ2.bits.PKTDEC)
+    {
+        if(model.packetCount)
+        {
+            model.packetCount--;
+        }
+        j60Sfr.econ2.bits.PKTDEC = 0;
+    }
+
+    if(j60Sfr.erxst != model.erxstSeen)
+    {
+        model.erxstSeen = j60Sfr.erxst;
+        model.rxWritePtr = j60Sfr.erxst;
+    }
+
+    if(model.miwrPending)
+    {
+        model.miwrPending = false;
+        if((j60Sfr.miregadr & 0x1Fu) != PHY_PHIR && (j60Sfr.miregadr & 0x1Fu) != PHY_PHSTAT1 && (j60Sfr.miregadr & 0x1Fu) != PHY_PHSTAT2)
+        {
+            phy[j60Sfr.miregadr & 0x1Fu] = j60Sfr.miwr;
+        }
+    }
+    if(j60Sfr.micmd.bits.MIIRD && !model.miirdSeen)
+    {
+        j60Sfr.mird = J60_PhyRead(j60Sfr.miregadr);
+    }
+    model.miirdSeen = j60Sfr.micmd.bits.MIIRD;
+
+    if(j60Sfr.tmr1.w != model.tmr1Count)
+    {
+        // in 16-bit mode a TMR1L write takes the high byte from the buffer
+        if(model.tmr1LowAccess)
+        {
+            j60Sfr.tmr1.b.h = model.tmr1HighWritten;
+        }
+        model.tmr1Count = j60Sfr.tmr1.w;
+    }
+    model.tmr1LowAccess = false;
+}
+
+static void J60_RunTimer1(void)
+{
+    uint64_t elapsed = model.cycles - model.tmr1Cycles;
+    uint32_t prescale;
+    uint64_t ticks;
+
+    model.tmr1Cycles = model.cycles;
+    if(!j60Sfr.t1con.bits.TMR1ON)
+    {
+        return;
+    }
+    prescale = 1u << j60Sfr.t1con.bits.T1CKPS;
+    elapsed += model.tmr1Prescale;
+    ticks = elapsed / prescale;
+    model.tmr1Prescale = (uint32_t)(elapsed % prescale);
+    if(ticks + model.tmr1Count > 0xFFFFu)
+    {
+        j60Sfr.pir1.bits.TMR1IF = 1;
+    }
+    model.tmr1Count = (uint16_t)(model.tmr1Count + ticks);
+    j60Sfr.tmr1.w = model.tmr1Count;
+}
+
+// arrival of the first frame on the wire: one the link partner had not started
+// when a PAUSE reached it waits for the pause to end, the frames held behind it
+// follow back to back
+static uint64_t J60_WireArrival(void)
+{
+    uint64_t time = J60_WireTime(wire[0].length);
+    uint64_t start = wire[0].when - time;
+
+    if(start < model.wireFreeAt)
+    {
+        start = model.wireFreeAt;
+    }
+    if(start >= model.pauseFrom && start < model.pauseUntil)
+    {
+        start = model.pauseUntil;
+    }
+    return start + time;
+}
+
+static void J60_RunWire(void)
+{
+    uint64_t arrival;
+    uint16_t i;
+
+    while(wireCount && (arrival = J60_WireArrival()) <= model.cycles)
+    {
+        model.wireFreeAt = arrival;
+        J60_ReceiveFrame(wire[0].data, wire[0].length);
+        for(i = 1; i < wireCount; i++)
+        {
+            wire[i - 1] = wire[i];
+        }
+        wireCount--;
+    }
+}
+
+static void J60_Dispatch(void)
+{
+    bool pending;
+
+    if(model.inIsr || model.isr == NULL || !j60Sfr.intcon.GIE || !j60Sfr.intcon.PEIE)
+    {
+        return;
+    }
+    pending = (j60Sfr.pie1.bits.TMR1IE && j60Sfr.pir1.bits.TMR1IF) ||
+              (j60Sfr.pie2.bits.ETHIE && j60Sfr.pir2.bits.ETHIF);
+    if(!pending)
+    {
+        return;
+    }
+    model.inIsr = true;
+    stats.interrupts++;
+    model.cycles += ISR_LATENCY_TCY;
+    j60Sfr.intcon.GIE = 0;
+    model.isr();
+    j60Sfr.intcon.GIE = 1;
+    model.inIsr = false;
+}
+
+void J60_Step(void)
+{
+    if(J60_InStep)
+    {
+        return;
+    }
+    J60_InStep = true;
+
+    J60_CheckWrites();
+    J60_RunFlowControl();
+    J60_RunTimer1();
+    if(model.dmaBusy && model.cycles >= model.dmaDone)
+    {
+        J60_DmaComplete();
+    }
+    if(model.txBusy && model.cycles >= model.txDone)
+    {
+        J60_TxComplete();
+    }
+    J60_RunWire();
+
+    j60Sfr.epktcnt = model.packetCount;
+    j60Sfr.erxwrpt = model.rxWritePtr;
+    j60Sfr.eir.bits.PKTIF = model.packetCount != 0;
+    j60Sfr.estat.bits.PHYRDY = j60Sfr.econ2.bits.ETHEN;
+    j60Sfr.estat.bits.RXBUSY = 0;
+    j60Sfr.mistat.bits.BUSY = 0;
+    j60Sfr.pir2.bits.ETHIF = (j60Sfr.eir.v & j60Sfr.eie.v & 0x7Bu) != 0;
+
+    J60_InStep = false;
+    J60_Dispatch();
+}
+
+j60Sfr_t *J60_Sfr(void)
+{
+    model.cycles++;
+    stats.sfrAccesses++;
+    J60_Step();
+    return &j60Sfr;
+}
+
+// With RD16 set, reading TMR1L latches TMR1H into a buffer that TMR1H reads
+// back, so the two byte reads see one timer value, and TMR1H writes go to
+// the buffer until TMR1L is written.  Without RD16 both bytes are direct.
+uint8_t *J60_Tmr1Low(void)
+{
+    J60_Sfr();
+    if(j60Sfr.t1con.bits.RD16)
+    {
+        model.tmr1LowAccess = true;
+        model.tmr1HighWritten = j60Sfr.tmr1hBuffer;
+        j60Sfr.tmr1hBuffer = j60Sfr.tmr1.b.h;
+    }
+    return &j60Sfr.tmr1.b.l;
+}
+
+uint8_t *J60_Tmr1High(void)
+{
+    J60_Sfr();
+    return j60Sfr.t1con.bits.RD16 ? &j60Sfr.tmr1hBuffer : &j60Sfr.tmr1.b.h;
+}
+
+uint16_t *J60_MiiWritePort(void)
+{
+    J60_Sfr();
+    model.miwrPending = true;
+    return &j60Sfr.miwr;
+}
+
+uint8_t J60_EdataRead(void)
+{
+    uint8_t data;
+    uint16_t ptr;
+
+    model.cycles += 2;
+    stats.edataReads++;
+    J60_Step();
+    ptr = j60Sfr.erdpt & SRAM_MASK;
+    data = sram[ptr];
+    if(j60Sfr.econ2.bits.AUTOINC)
+    {
+        j60Sfr.erdpt = (ptr == j60Sfr.erxnd) ? j60Sfr.erxst : (uint16_t)((ptr + 1u) & SRAM_MASK);
+    }
+    return data;
+}
+
+void J60_EdataWrite(uint8_t data)
+{
+    uint16_t ptr;
+
+    model.cycles += 2;
+    stats.edataWrites++;
+    J60_Step();
+    ptr = j60Sfr.ewrpt & SRAM_MASK;
+    sram[ptr] = data;
+    if(j60Sfr.econ2.bits.AUTOINC)
+    {
+        j60Sfr.ewrpt = (uint16_t)((ptr + 1u) & SRAM_MASK);
+    }
+}
+
+void J60_Nop(void)
+{
+    model.cycles++;
+    stats.nops++;
+    J60_Step();
+}
+
+void J60_Asm(const char *instruction)
+{
+    if(strcmp(instruction, "nop") == 0)
+    {
+        J60_Nop();
+        return;
+    }
+    fprintf(stderr, "j60 model: unsupported inline assembly \"%s\"\n", instruction);
+    exit(2);
+}
+
+void J60_SystemReset(void)
+{
+    fprintf(stderr, "j60 model: firmware called RESET() at Tcy %llu\n", (unsigned long long)model.cycles);
+    exit(3);
+}
+
+void J60_ModelReset(void)
+{
+    memset(&j60Sfr, 0, sizeof(j60Sfr));
+    memset(sram, 0, sizeof(sram));
+    memset(phy, 0, sizeof(phy));
+    memset(&model, 0, sizeof(model));
+    memset(&stats, 0, sizeof(stats));
+    wireCount = 0;
+
+    // power on values the driver depends on
+    j60Sfr.econ2.bits.AUTOINC = 1;
+    j60Sfr.erxst = 0x0000;
+    j60Sfr.erxnd = 0x1FFF;
+    j60Sfr.erxfcon.v = 0xA1;
+    j60Sfr.eflocon.bits.FULDPXS = 1;
+    phy[PHY_PHSTAT1] = PHSTAT1_LLSTAT;
+    phy[PHY_PHSTAT2] = PHSTAT2_LSTAT;
+}
+
+void J60_SetTxHandler(j60TxHandler_t handler)
+{
+    model.txHandler = handler;
+}
+
+void J60_SetInterruptHandler(void (*isr)(void))
+{
+    model.isr = isr;
+}
+
+uint64_t J60_Cycles(void)
+{
+    return model.cycles;
+}
+
+void J60_Advance(uint32_t tcy)
+{
+    model.cycles += tcy;
+    J60_Step();
+}
+
+void J60_WireDeliver(const uint8_t *frame, uint16_t length, uint64_t tcy)
+{
+    uint16_t i;
+
+    if(wireCount == WIRE_QUEUE_SIZE || length > WIRE_MAX_FRAME)
+    {
+        fprintf(stderr, "j60 model: wire queue overflow, frame dropped\n");
+        return;
+    }
+    // keep the queue ordered by arrival time
+    for(i = wireCount; i > 0 && wire[i - 1].when > tcy; i--)
+    {
+        wire[i] = wire[i - 1];
+    }
+    wire[i].when = tcy;
+    wire[i].length = length;
+    memcpy(wire[i].data, frame, length);
+    wireCount++;
+}
+
+uint16_t J60_WirePending(void)
+{
+    return wireCount;
+}
+
+uint64_t J60_WireNextArrival(void)
+{
+    return wireCount ? J60_WireArrival() : UINT64_MAX;
+}
+
+void J60_WirePause(uint64_t tcy, uint16_t quanta)
+{
+    if(model.pauseUntil <= tcy)
+    {
+        model.pauseFrom = tcy;
+    }
+    model.pauseUntil = tcy + J60_PauseTime(quanta);
+}
+
+void J60_SetLink(bool up)
+{
+    if(up)
+    {
+        phy[PHY_PHSTAT1] |= PHSTAT1_LLSTAT;
+        phy[PHY_PHSTAT2] |= PHSTAT2_LSTAT;
+    }
+    else
+    {
+        phy[PHY_PHSTAT1] &= (uint16_t)~PHSTAT1_LLSTAT;
+        phy[PHY_PHSTAT2] &= (uint16_t)~PHSTAT2_LSTAT;
+    }
+    phy[PHY_PHIR] |= PHIR_PLNKIF;
+    if(phy[PHY_PHIE] & PHIE_PLNKIE)
+    {
+        j60Sfr.eir.bits.LINKIF = 1;
+    }
+}
+
+void J60_StallDmaCopies(uint16_t copies)
+{
+    model.dmaStalls = copies;
+}
+
+uint8_t *J60_Sram(void)
+{
+    return sram;
+}
+
+const j60ModelStats_t *J60_Stats(void)
+{
+    return &stats;
+}
+
+void J60_StatsClear(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+uint64_t J60_StatsTcy(const j60ModelStats_t *s)
+{
+    return s->sfrAccesses + 2u * (s->edataReads + s->edataWrites) + s->nops;
+}
@@ -0,0 +1,83 @@
+/**
+  PIC18F97J60 Ethernet module model
+
+  Summary:
+    Software model of the J60 MAC used to run the TCP/IP Lite stack on a host.
+
+  Description:
+    The model owns the 8 KB Ethernet SRAM and the register file behind the
+    xc.h stand-in.  It implements the parts of the module the driver relies
+    on: ERDPT/EWRPT auto-increment with receive buffer wrap, the receive
+    buffer ring with next packet pointers and status vectors, the receive
+    filters, DMA copy and checksum, transmission with status vectors and
+    TXIF, PAUSE frames for EFLOCON, the MII/PHY registers and Timer1.
+
+    Time is counted in instruction cycles (Tcy, Fosc/4).  The model charges
+    1 Tcy per register access, 2 Tcy per EDATA access (movff) and 1 Tcy per
+    NOP; everything else the CPU does is invisible to it and can be charged
+    with J60_Advance().  Frames on the wire take 0.8 us per byte.
+*/
+
+#ifndef J60_MODEL_H
+#define J60_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <xc.h>
+
+#define J60_SRAM_SIZE           8192u
+#define J60_FCY                 10416667ul      // 41.667 MHz / 4
+#define J60_TCY_PER_MS          (J60_FCY / 1000ul)
+#define J60_TCY_PER_US_X100     1042ul          // Tcy per 100 us
+
+typedef struct
+{
+    uint64_t sfrAccesses;
+    uint64_t edataReads;
+    uint64_t edataWrites;
+    uint64_t nops;
+    uint64_t dmaCopies;
+    uint64_t dmaCopyBytes;
+    uint64_t dmaChecksums;
+    uint64_t dmaChecksumBytes;
+    uint64_t rxFrames;          // frames written into the receive buffer
+    uint64_t rxFiltered;        // frames rejected by ERXFCON
+    uint64_t rxOverflows;       // frames dropped for lack of receive buffer space
+    uint64_t txFrames;
+    uint64_t txBytes;
+    uint64_t pauseFrames;       // PAUSE frames sent for EFLOCON
+    uint64_t interrupts;
+} j60ModelStats_t;
+
+typedef void (*j60TxHandler_t)(const uint8_t *frame, uint16_t length, uint64_t when);
+
+void J60_ModelReset(void);
+void J60_SetTxHandler(j60TxHandler_t handler);
+void J60_SetInterruptHandler(void (*isr)(void));
+
+uint64_t J60_Cycles(void);
+void J60_Advance(uint32_t tcy);
+void J60_Step(void);
+
+// queue a frame on the wire, it is offered to the receive filters at tcy
+void J60_WireDeliver(const uint8_t *frame, uint16_t length, uint64_t tcy);
+uint16_t J60_WirePending(void);
+uint64_t J60_WireNextArrival(void);
+// the link partner got a PAUSE frame at tcy, a zero time ends the pause
+void J60_WirePause(uint64_t tcy, uint16_t quanta);
+
+void J60_SetLink(bool up);
+void J60_StallDmaCopies(uint16_t copies);  // the next DMA copies never finish
+uint16_t J60_RxBufferUsed(void);
+
+uint8_t *J60_Sram(void);
+const j60ModelStats_t *J60_Stats(void);
+void J60_StatsClear(void);
+
+// estimated CPU cost of the modelled accesses
+uint64_t J60_StatsTcy(const j60ModelStats_t *s);
+
+uint16_t J60_InetChecksum(const uint8_t *data, uint16_t length, uint32_t seed);
+uint32_t J60_Crc32(const uint8_t *data, uint16_t length);
+
+#endif // J60_MODEL_H
@@ -0,0 +1,75 @@
+/**
+  Host decoder of the binary log
+
+  Summary:
+    Turns the datagrams of the firmware's log ring back into text.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "log_decode.h"
+#include "../mcc_generated_files/TCPIPLibrary/log_events.h"
+#include "../mcc_generated_files/TCPIPLibrary/log_ring.h"
+
+static const char *const eventText[] = { LOG_EVENT_LIST(LOG_EVENT_TEXT) };
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return ((uint32_t)get16(p) << 16) | get16(p + 2);
+}
+
+size_t LOG_Decode(const uint8_t *data, size_t length, FILE *out)
+{
+    const uint8_t *record;
+    uint8_t count;
+    uint16_t lost;
+    uint32_t now;
+    time_t seconds;
+    struct tm tm;
+    size_t size;
+    uint8_t i;
+
+    if(length < LOG_RING_HEADER_SIZE || data[0] != LOG_RING_VERSION)
+    {
+        return 0;
+    }
+    count = data[1];
+    lost = get16(data + 2);
+    now = get32(data + 4);
+    size = LOG_RING_HEADER_SIZE + (size_t)count * LOG_RING_RECORD_SIZE;
+    if(length < size)
+    {
+        return 0;
+    }
+
+    if(lost)
+    {
+        fprintf(out, "(%u records lost)\n", lost);
+    }
+    for(i = 0; i < count; i++)
+    {
+        record = data + LOG_RING_HEADER_SIZE + (size_t)i * LOG_RING_RECORD_SIZE;
+
+        // the record has the low 16 bits of the time, it was stored before the drain
+        seconds = (time_t)(now - (uint16_t)((uint16_t)now - get16(record + 2)));
+        gmtime_r(&seconds, &tm);
+        fprintf(out, "<%u>1 %d-%.2d-%.2dT%.2d:%.2d:%.2dZ ", record[1], tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                tm.tm_hour, tm.tm_min, tm.tm_sec);
+        if(record[0] < LOG_EV_LAST)
+        {
+            fprintf(out, eventText[record[0]], get16(record + 4), get16(record + 6));
+        }
+        else
+        {
+            fprintf(out, "event %u (%u, %u)", record[0], get16(record + 4), get16(record + 6));
+        }
+        fputc('\n', out);
+    }
+    return size;
+}
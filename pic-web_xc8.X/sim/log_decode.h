@@ -0,0 +1,25 @@
+/**
+  Host decoder of the binary log
+
+  Summary:
+    Turns the datagrams of the firmware's log ring back into text.
+
+  Description:
+    The event texts come from the same list the firmware takes its event
+    IDs from (log_events.h), so a decoder built from the same tree prints
+    what the firmware meant.  The datagram format is described in
+    log_ring.h.
+*/
+
+#ifndef LOG_DECODE_H
+#define LOG_DECODE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// write one syslog style line per record of the datagram at data to out,
+// returns the bytes the datagram took or 0 if data holds no valid datagram
+size_t LOG_Decode(const uint8_t *data, size_t length, FILE *out);
+
+#endif
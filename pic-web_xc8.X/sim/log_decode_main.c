@@ -0,0 +1,58 @@
+/**
+  Host decoder of the binary log
+
+  Summary:
+    Prints the log datagrams read from a file or stdin.
+
+  Description:
+    The input is the payload of the datagrams to LOG_RING_PORT written back
+    to back, as e.g. `socat -u UDP-RECV:5140 STDOUT | log-decode` gives it.
+
+    Usage: log-decode [file]
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "log_decode.h"
+#include "../mcc_generated_files/TCPIPLibrary/log_ring.h"
+
+#define LOG_DECODE_BUFFER   4096u
+
+int main(int argc, char **argv)
+{
+    static uint8_t buffer[LOG_DECODE_BUFFER];
+    FILE *in = stdin;
+    size_t length = 0;
+    size_t used;
+    size_t n;
+
+    if(argc > 1 && (in = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    while((n = fread(buffer + length, 1, sizeof(buffer) - length, in)) > 0)
+    {
+        length += n;
+        while((used = LOG_Decode(buffer, length, stdout)) > 0)
+        {
+            length -= used;
+            memmove(buffer, buffer + used, length);
+        }
+        fflush(stdout);
+
+        // a full buffer that does not start with a datagram never will
+        if(length == sizeof(buffer) || (length > 0 && buffer[0] != LOG_RING_VERSION))
+        {
+            fprintf(stderr, "log-decode: not a log datagram\n");
+            return 1;
+        }
+    }
+    if(length)
+    {
+        fprintf(stderr, "log-decode: %u bytes left over\n", (unsigned)length);
+    }
+    return length ? 1 : 0;
+}
@@ -0,0 +1,2131 @@
+/**
+  Host simulation of the PIC-WEB firmware
+
+  Summary:
+    Boots the unmodified stack on the J60 model and runs traffic scenarios.
+
+  Description:
+    The firmware main loop (Network_Manage() and DEMO_TCP_EchoServer()) runs
+    exactly as in main.c while the simulated peer (sim_net.c) talks to it.
+    Every scenario checks the answers it gets and reports the modelled cost
+    per operation, so the program doubles as a regression test and as the
+    baseline for performance work:
+
+      Tcy/op    modelled CPU cycles spent on register, EDATA and NOP
+                accesses per operation, minus the cost of the idle main loop
+      rd/op     EDATA reads per operation
+      wr/op     EDATA writes per operation
+      dma/op    bytes moved or summed by the DMA engine per operation
+      sim ms    simulated time the scenario took
+
+    Usage: pic-web-sim [scenario ...]     (no argument runs all of them)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "j60_model.h"
+#include "sim_net.h"
+#include "sim_main.h"
+#include "../mcc_generated_files/mcc.h"
+#include "../tcp_server_demo.h"
+#include "../mcc_generated_files/TCPIPLibrary/tcpv4.h"
+#include "../mcc_generated_files/TCPIPLibrary/ethernet_driver.h"
+#include "../mcc_generated_files/TCPIPLibrary/udpv4.h"
+#include "../mcc_generated_files/TCPIPLibrary/network.h"
+#include "../mcc_generated_files/TCPIPLibrary/tcpip_config.h"
+#include "../mcc_generated_files/TCPIPLibrary/sram_heap.h"
+#include "../mcc_generated_files/TCPIPLibrary/mac_address.h"
+#include "../mcc_generated_files/TCPIPLibrary/log.h"
+#include "../mcc_generated_files/TCPIPLibrary/log_ring.h"
+#include "../mcc_generated_files/TCPIPLibrary/log_syslog.h"
+#include "../mcc_generated_files/TCPIPLibrary/ip_database.h"
+#include "../mcc_generated_files/TCPIPLibrary/net_stats.h"
+#include "../mcc_generated_files/TCPIPLibrary/net_profile.h"
+#include "../mcc_generated_files/TCPIPLibrary/net_loop.h"
+#include "log_decode.h"
+
+// interrupt_manager.c defines it as the device interrupt vector, no header declares it
+void INTERRUPT_InterruptManager(void);
+extern tcpTCB_t *tcbList;          // tcpv4.c, walked to compare the lookup with the list
+
+#define SIM_LOOP_TCY        400u    // C code of one main loop pass the model cannot see
+#define SIM_BULK_PORT       19u     // device side source for the tcp-bulk scenario
+#define SIM_BULK_BLOCK      512u    // a large heap block, TCP_Send() copies it
+#define SIM_LOSSY_BLOCKS    8u      // tcp-bulk blocks sent over a lossy link
+#define SIM_WINDOW_BLOCK    5840u   // four full size segments, sent from the application buffer
+#define SIM_WINDOW_BLOCKS   5u      // per run, two runs fill most of the peer's receive buffer
+#define SIM_DELAYED_ACK_MS  200u    // the longest a Windows or Linux peer holds back an ACK
+#define SIM_DEMUX_SOCKETS   16u     // most echo sockets sharing port 7 in the tcp-demux scenario
+#define SIM_DEMUX_MESSAGES  8u      // echoed per connection and run
+#define SIM_ACCEPT_PORT     23u     // device side echo of the tcp-accept scenario
+#define SIM_ACCEPT_CLIENTS  4u      // connecting at once, as many as the pool
+#define SIM_SINK_PORT       9u      // device side sink that reads the payload in place
+#define SIM_RTO_MESSAGES    400u    // echoed over a lossy link in the tcp-rto scenario
+#define SIM_RTO_LOSS        20u     // per mille of the frames from the device lost
+#define SIM_OUTAGE_MS       10000u  // link down in the middle of a transfer in the tcp-outage scenario
+#define SIM_BLOCK_MAX       1460u   // largest block of the block scenario
+#define SIM_BLOCK_REPEAT    16u
+#define SIM_HEAP_BYTES      512u    // block size of the heap scenario measurements
+#define SIM_BURST_PORT      9000u   // UDP port of the tx-burst datagrams
+#define SIM_BURST_COUNT     240u
+#define SIM_BURST_PINGS     16u     // pings answered while the burst fills the TX buffer
+#define SIM_CONTROL_PING    700u    // short ping behind two full size datagrams
+#define SIM_LOG_EVENTS      8u
+#define SIM_SYSLOG_BURST    40u     // messages logged back to back, twice the token bucket
+#define SIM_STATS_PORT      40000u  // peer side port of the statistics queries
+#define SIM_STATS_PINGS     8u
+#define SIM_SLOW_APP_TCY    30000u  // application pass of the loop scenario over NET_LOOP_TICK_BUDGET
+#define SIM_SLOW_APP_EVERY  10u
+#define SIM_SLOW_APP_PASSES 200u
+#define SIM_LONG_APP_TCY    800000u // application pass longer than the TMR1 period
+
+typedef struct
+{
+    const char *name;
+    bool (*run)(void);
+} simScenario_t;
+
+static simApp_t simApps[8];
+static uint8_t simAppCount;
+static uint64_t simLoops;
+static uint64_t idleTcyPerLoopX100;
+static bool simVerbose;
+
+static tcpTCB_t bulkTCB;
+static uint8_t bulkRx[SIM_BULK_BLOCK];
+static uint8_t bulkTx[SIM_WINDOW_BLOCK];
+static uint16_t bulkBlockLength;
+static uint16_t bulkBlocksLeft;
+static uint32_t bulkOffset;
+static uint32_t bulkRxOffset;
+static bool bulkRxIntact;
+
+static tcpTCB_t demuxTCB[SIM_DEMUX_SOCKETS - 1u];   // next to the one of the echo server
+static uint8_t demuxRx[SIM_DEMUX_SOCKETS - 1u][20];
+static uint8_t demuxTx[SIM_DEMUX_SOCKETS - 1u][20];
+static uint8_t demuxCount;
+
+static tcpListener_t acceptListener;
+static tcpTCB_t acceptTCB[SIM_ACCEPT_CLIENTS];
+static uint8_t acceptRx[SIM_ACCEPT_CLIENTS][20];
+static uint8_t acceptTx[SIM_ACCEPT_CLIENTS][20];
+static bool acceptTaken[SIM_ACCEPT_CLIENTS];
+
+static tcpTCB_t sinkTCB;
+static uint32_t sinkOffset;
+static bool sinkIntact;
+static uint16_t sinkLimit;          // most bytes the sink consumes of a segment, 0 = all
+
+static uint16_t burstSent;
+static uint16_t burstReceived;
+static bool burstIntact;
+static uint8_t burstPerPass;        // datagrams queued per main loop pass, 0 = as many as fit
+static uint16_t orderPorts[8];      // destination ports in the order the datagrams arrived
+static uint8_t orderCount;
+static bool orderPingAhead;         // the control ping was answered before the second datagram
+
+static uint8_t logData[2048];       // log datagrams received, back to back
+static size_t logLength;
+static uint16_t logDatagrams;
+
+static uint16_t syslogDatagrams;
+static uint16_t syslogLines;
+static uint16_t syslogSuppressed;   // sum of the "messages suppressed" lines
+static uint16_t syslogSummaries;
+
+void putch(char c)
+{
+    putchar(c);
+}
+
+void SIM_AddApp(simApp_t app)
+{
+    if(simAppCount < sizeof(simApps) / sizeof(simApps[0]))
+    {
+        simApps[simAppCount++] = app;
+    }
+}
+
+void SIM_Loop(void)
+{
+    uint8_t i;
+
+    Network_Manage();
+    J60_Advance(SIM_LOOP_TCY);
+    NET_LoopStage(NET_LOOP_NETWORK);
+    DEMO_TCP_EchoServer();
+    for(i = 0; i < simAppCount; i++)
+    {
+        simApps[i]();
+    }
+    NET_LoopStage(NET_LOOP_APP);
+    NET_LoopEnd();
+    SIM_NetPoll();
+    simLoops++;
+}
+
+void SIM_RunMs(uint32_t ms)
+{
+    uint64_t end = J60_Cycles() + SIM_UsToTcy((uint64_t)ms * 1000u);
+
+    while(J60_Cycles() < end)
+    {
+        SIM_Loop();
+    }
+}
+
+void SIM_MeasureStart(simMeasure_t *m)
+{
+    m->stats = *J60_Stats();
+    m->cycles = J60_Cycles();
+    m->loops = simLoops;
+    m->net = *SIM_NetStats();
+}
+
+void SIM_MeasureReport(const simMeasure_t *m, const char *label, uint32_t operations)
+{
+    const j60ModelStats_t *now = J60_Stats();
+    j60ModelStats_t d;
+    uint64_t busy;
+    uint64_t idle;
+
+    if(operations == 0)
+    {
+        operations = 1;
+    }
+    d.sfrAccesses = now->sfrAccesses - m->stats.sfrAccesses;
+    d.edataReads = now->edataReads - m->stats.edataReads;
+    d.edataWrites = now->edataWrites - m->stats.edataWrites;
+    d.nops = now->nops - m->stats.nops;
+    busy = J60_StatsTcy(&d);
+    idle = ((simLoops - m->loops) * idleTcyPerLoopX100) / 100u;
+    busy = (busy > idle) ? busy - idle : 0;
+
+    printf("  %-24s %6u %9llu %9llu %9llu %9llu %7llu %9.1f\n",
+           label,
+           (unsigned)operations,
+           (unsigned long long)(busy / operations),
+           (unsigned long long)(d.edataReads / operations),
+           (unsigned long long)(d.edataWrites / operations),
+           (unsigned long long)((now->dmaCopyBytes + now->dmaChecksumBytes - m->stats.dmaCopyBytes - m->stats.dmaChecksumBytes) / operations),
+           (unsigned long long)(SIM_NetStats()->framesFromDevice - m->net.framesFromDevice),
+           (double)SIM_TcyToUs(J60_Cycles() - m->cycles) / 1000.0);
+}
+
+void SIM_ReportHeader(const char *title)
+{
+    printf("%s\n", title);
+    printf("  %-24s %6s %9s %9s %9s %9s %7s %9s\n", "operation", "ops", "Tcy/op", "rd/op", "wr/op", "dma/op", "frames", "sim ms");
+}
+
+bool SIM_Check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("  FAIL: %s\n", what);
+    }
+    else if(simVerbose)
+    {
+        printf("  ok: %s\n", what);
+    }
+    return condition;
+}
+
+void SIM_Boot(void)
+{
+    simMeasure_t m;
+    uint64_t loops;
+
+    simAppCount = 0;
+    J60_ModelReset();
+    SIM_NetInit();
+    J60_SetInterruptHandler(INTERRUPT_InterruptManager);
+
+    // same start up as main()
+    SYSTEM_Initialize();
+    INTERRUPT_GlobalInterruptEnable();
+    INTERRUPT_PeripheralInterruptEnable();
+
+    // let the echo server open its socket and learn the peer's MAC address,
+    // then calibrate the idle loop
+    SIM_RunMs(10);
+    SIM_ArpRequest();
+    SIM_RUN_UNTIL(SIM_ArpReplied(), 50);
+    SIM_MeasureStart(&m);
+    loops = simLoops;
+    SIM_RunMs(20);
+    {
+        const j60ModelStats_t *now = J60_Stats();
+        j60ModelStats_t d;
+
+        d.sfrAccesses = now->sfrAccesses - m.stats.sfrAccesses;
+        d.edataReads = now->edataReads - m.stats.edataReads;
+        d.edataWrites = now->edataWrites - m.stats.edataWrites;
+        d.nops = now->nops - m.stats.nops;
+        idleTcyPerLoopX100 = (J60_StatsTcy(&d) * 100u) / (simLoops - loops);
+    }
+}
+
+/*
+ * Scenarios
+ */
+
+static bool SIM_ScenarioArp(void)
+{
+    simMeasure_t m;
+    bool ok = true;
+    uint16_t i;
+    uint64_t rxFrames;
+    uint64_t rxFiltered;
+
+    SIM_Boot();
+    SIM_ReportHeader("arp");
+    SIM_MeasureStart(&m);
+    for(i = 0; i < 16u && ok; i++)
+    {
+        SIM_ArpRequest();
+        SIM_RUN_UNTIL(SIM_ArpReplied(), 50);
+        ok &= SIM_Check(SIM_ArpReplied(), "device answers ARP requests for its address");
+    }
+    SIM_MeasureReport(&m, "arp request/reply", i);
+
+    // broadcasts and multicasts for other hosts are dropped by the MAC
+    rxFrames = J60_Stats()->rxFrames;
+    rxFiltered = J60_Stats()->rxFiltered;
+    SIM_MeasureStart(&m);
+    for(i = 0; i < 16u; i++)
+    {
+        SIM_LanNoise();
+        SIM_RunMs(1);
+    }
+    SIM_MeasureReport(&m, "lan noise", 4u * i);
+    ok &= SIM_Check(J60_Stats()->rxFiltered - rxFiltered == 4u * i, "LAN noise dropped by the receive filter");
+    ok &= SIM_Check(J60_Stats()->rxFrames == rxFrames, "no LAN noise reaches the RX buffer");
+    SIM_ArpRequest();
+    SIM_RUN_UNTIL(SIM_ArpReplied(), 50);
+    ok &= SIM_Check(SIM_ArpReplied(), "device answers ARP requests through the receive filter");
+    return ok;
+}
+
+static bool SIM_PingSeries(const char *label, uint16_t count, uint16_t payload)
+{
+    simMeasure_t m;
+    bool ok = true;
+    uint16_t i;
+
+    SIM_MeasureStart(&m);
+    for(i = 0; i < count && ok; i++)
+    {
+        SIM_Ping(i, payload);
+        SIM_RUN_UNTIL(SIM_PingReplied(i), 50);
+        ok &= SIM_Check(SIM_PingReplied(i), "ping answered with a valid echo reply");
+    }
+    SIM_MeasureReport(&m, label, i);
+    return ok;
+}
+
+// count pings sent back to back, as fast as the wire takes them
+static bool SIM_PingFlood(const char *label, uint16_t first, uint16_t count, uint16_t payload)
+{
+    simMeasure_t m;
+    uint16_t i;
+    uint16_t replied = 0;
+
+    SIM_MeasureStart(&m);
+    for(i = 0; i < count; i++)
+    {
+        SIM_Ping(first + i, payload);
+    }
+    SIM_RUN_UNTIL(SIM_PingReplied(first + count - 1u) && J60_WirePending() == 0, 500);
+    SIM_RunMs(5);
+    for(i = 0; i < count; i++)
+    {
+        replied += SIM_PingReplied(first + i);
+    }
+    SIM_MeasureReport(&m, label, replied);
+    // the TX buffer holds two full size frames, a reply that finds both in
+    // use is dropped
+    return SIM_Check(replied >= count - count / 16u, "ping flood answered");
+}
+
+// firmware side application that keeps the main loop busy for 2 ms a pass
+static void SIM_BusyApp(void)
+{
+    J60_Advance(SIM_UsToTcy(2000));
+}
+
+static uint8_t SIM_BulkByte(uint32_t offset)
+{
+    return (uint8_t)(offset * 31u + (offset >> 8));
+}
+
+// firmware side application: sends bulkBlocksLeft blocks to whoever connects
+// and checks whatever it receives against the same pattern
+static void SIM_BulkSource(void)
+{
+    uint16_t i;
+    int16_t rxLen;
+
+    switch(TCP_SocketPoll(&bulkTCB))
+    {
+        case NOT_A_SOCKET:
+            TCP_SocketInit(&bulkTCB);
+            break;
+        case SOCKET_CLOSED:
+            TCP_Bind(&bulkTCB, SIM_BULK_PORT);
+            TCP_InsertRxBuffer(&bulkTCB, bulkRx, sizeof(bulkRx));
+            TCP_Listen(&bulkTCB);
+            break;
+        case SOCKET_CONNECTED:
+            if(TCP_GetRxLength(&bulkTCB) > 0)
+            {
+                rxLen = TCP_GetReceivedData(&bulkTCB);
+                for(i = 0; i < (uint16_t)rxLen; i++)
+                {
+                    bulkRxIntact &= bulkRx[i] == SIM_BulkByte(bulkRxOffset + i);
+                }
+                bulkRxOffset += (uint16_t)rxLen;
+                TCP_InsertRxBuffer(&bulkTCB, bulkRx, sizeof(bulkRx));
+            }
+            if(bulkBlocksLeft && TCP_SendDone(&bulkTCB))
+            {
+                for(i = 0; i < bulkBlockLength; i++)
+                {
+                    bulkTx[i] = SIM_BulkByte(bulkOffset + i);
+                }
+                if(TCP_Send(&bulkTCB, bulkTx, bulkBlockLength) == SUCCESS)
+                {
+                    if(TCP_SendCopied(&bulkTCB))
+                    {
+                        memset(bulkTx, 0, sizeof(bulkTx)); // the stack sends from its copy
+                    }
+                    bulkOffset += bulkBlockLength;
+                    bulkBlocksLeft--;
+                }
+            }
+            break;
+        case SOCKET_CLOSING:
+            TCP_SocketRemove(&bulkTCB);
+            break;
+        default:
+            break;
+    }
+}
+
+// receive handler of the sink, checks the payload in small pieces straight
+// out of the Ethernet RX buffer
+static void SIM_SinkReceive(uint16_t length)
+{
+    uint8_t piece[64];
+    uint16_t n;
+    uint16_t i;
+
+    if(sinkLimit && length > sinkLimit)
+    {
+        length = sinkLimit;
+    }
+    if(TCP_RxPeek(piece, 1) == 1)
+    {
+        sinkIntact &= piece[0] == SIM_BulkByte(sinkOffset);
+    }
+    while(length)
+    {
+        n = TCP_RxRead(piece, length < sizeof(piece) ? length : (uint16_t)sizeof(piece));
+        if(n == 0)
+        {
+            break;
+        }
+        for(i = 0; i < n; i++)
+        {
+            sinkIntact &= piece[i] == SIM_BulkByte(sinkOffset + i);
+        }
+        sinkOffset += n;
+        length -= n;
+    }
+}
+
+// firmware side application: discard server without a socket RX buffer
+static void SIM_BulkSink(void)
+{
+    switch(TCP_SocketPoll(&sinkTCB))
+    {
+        case NOT_A_SOCKET:
+            TCP_SocketInit(&sinkTCB);
+            break;
+        case SOCKET_CLOSED:
+            TCP_Bind(&sinkTCB, SIM_SINK_PORT);
+            TCP_InsertRxHandler(&sinkTCB, SIM_SinkReceive);
+            TCP_Listen(&sinkTCB);
+            break;
+        case SOCKET_CLOSING:
+            TCP_SocketRemove(&sinkTCB);
+            break;
+        default:
+            break;
+    }
+}
+
+// datagram sizes of the tx-burst scenario, mixed so the TX ring wraps at
+// different places
+static uint16_t SIM_BurstLength(uint16_t sequence)
+{
+    static const uint16_t lengths[] = {1472, 200, 60, 300, 120, 40, 700, 90};
+
+    return lengths[sequence % (sizeof(lengths) / sizeof(lengths[0]))];
+}
+
+// firmware side application: queues as many datagrams as the TX buffer takes
+// on every main loop pass
+static void SIM_BurstSource(void)
+{
+    uint16_t i;
+    uint16_t length;
+    uint8_t queued = 0;
+
+    while(burstSent < SIM_BURST_COUNT && (burstPerPass == 0 || queued++ < burstPerPass) &&
+          UDP_Start(SIM_PEER_IP, SIM_BURST_PORT, SIM_BURST_PORT) == SUCCESS)
+    {
+        length = SIM_BurstLength(burstSent);
+        UDP_Write16(burstSent);
+        for(i = 2; i < length; i++)
+        {
+            UDP_Write8(SIM_BulkByte((uint32_t)burstSent * 7u + i));
+        }
+        UDP_Send();
+        burstSent++;
+    }
+}
+
+static void SIM_BurstSink(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length)
+{
+    uint16_t sequence;
+    uint16_t i;
+
+    if(dstPort != SIM_BURST_PORT || length < 2)
+    {
+        return;
+    }
+    sequence = (uint16_t)((data[0] << 8) | data[1]);
+    burstIntact &= sequence == burstReceived && length == SIM_BurstLength(sequence);
+    for(i = 2; i < length; i++)
+    {
+        burstIntact &= data[i] == SIM_BulkByte((uint32_t)sequence * 7u + i);
+    }
+    burstReceived++;
+}
+
+static bool SIM_ScenarioPing(void)
+{
+    bool ok = true;
+    uint16_t drops;
+#if !defined(ETH_NO_FLOW_CONTROL) && !defined(J60_USE_HALF_DUPLEX)
+    uint16_t overflows;
+    uint16_t starts;
+    uint64_t pauses;
+#endif
+
+    SIM_Boot();
+    SIM_ReportHeader("ping");
+    ok &= SIM_PingSeries("echo 56 bytes", 64, 56);
+    ok &= SIM_PingSeries("echo 512 bytes", 32, 512);
+    ok &= SIM_PingSeries("echo 1472 bytes", 16, 1472);
+    ok &= SIM_PingFlood("flood 1472 bytes", 100, 64, 1472);
+
+
+    // a copy that never finishes costs that one reply, not the board
+    drops = ethTxStats.dmaDrops;
+    J60_StallDmaCopies(1);
+    SIM_Ping(200, 1000);
+    SIM_RunMs(50);
+    ok &= SIM_Check(!SIM_PingReplied(200) && ethTxStats.dmaDrops == drops + 1u, "reply with a hung DMA copy dropped");
+    SIM_Ping(201, 1000);
+    SIM_RUN_UNTIL(SIM_PingReplied(201), 50);
+    ok &= SIM_Check(SIM_PingReplied(201), "next ping answered after the DMA timeout");
+
+    // packets arriving while the application holds the main loop wait in the RX ring
+    SIM_AddApp(SIM_BusyApp);
+    ethRxStats.waitingPeak = 0;
+    memset(&networkRxStats, 0, sizeof(networkRxStats));
+    ok &= SIM_PingFlood("flood 56 bytes, busy app", 300, 32, 56);
+    printf("  RX ring peak %u packets waiting, full %u times, %u overflows\n",
+           ethRxStats.waitingPeak, ethRxStats.ringFull, ethRxStats.overflows);
+    printf("  RX batches: %lu frames in %lu calls, peak %u, stopped by control %u bulk %u ticks %u tx %u\n",
+           (unsigned long)networkRxStats.frames, (unsigned long)networkRxStats.batches, networkRxStats.batchPeak,
+           networkRxStats.controlBudgetHits, networkRxStats.bulkBudgetHits,
+           networkRxStats.tickBudgetHits, networkRxStats.txBusyHits);
+    ok &= SIM_Check(ethRxStats.waitingPeak > 1, "packets queued in the RX ring while the loop was busy");
+#ifndef NETWORK_SINGLE_READ
+    ok &= SIM_Check(networkRxStats.batchPeak > 1, "several frames handled per Network_Manage() call");
+#endif
+
+#if !defined(ETH_NO_FLOW_CONTROL) && !defined(J60_USE_HALF_DUPLEX)
+    // full size frames fill the RX buffer faster than the busy loop reads it,
+    // PAUSE frames hold the peer back instead of letting the buffer overflow
+    overflows = ethRxStats.overflows;
+    starts = ethRxStats.pauses;
+    pauses = SIM_NetStats()->pausesFromDevice;
+    ok &= SIM_PingFlood("flood 1472 B, busy app", 400, 16, 1472);
+    printf("  flow control started %u times, %lu PAUSE frames, %u overflows\n",
+           ethRxStats.pauses - starts, (unsigned long)(SIM_NetStats()->pausesFromDevice - pauses),
+           ethRxStats.overflows - overflows);
+    ok &= SIM_Check(ethRxStats.pauses != starts && ethRxStats.overflows == overflows, "PAUSE frames kept the RX buffer from overflowing");
+#endif
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+    return ok;
+}
+
+static bool SIM_ScenarioTcpEcho(void)
+{
+    simMeasure_t m;
+    simTcpConn_t *c;
+    char message[20];
+    uint32_t expected = 0;
+    bool ok = true;
+    uint16_t i;
+
+    SIM_Boot();
+    SIM_ReportHeader("tcp-echo");
+
+    SIM_MeasureStart(&m);
+    c = SIM_TcpConnect(7);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    SIM_MeasureReport(&m, "connect", 1);
+    if(!SIM_Check(c->state == SIM_TCP_ESTABLISHED, "connection to port 7 established"))
+    {
+        return false;
+    }
+
+    SIM_MeasureStart(&m);
+    for(i = 0; i < 100u && ok; i++)
+    {
+        snprintf(message, sizeof(message), "echo message %05u", i);
+        SIM_TcpSend(c, message, sizeof(message));
+        expected += sizeof(message);
+        SIM_RUN_UNTIL(c->rxLen >= expected && SIM_TcpUnacked(c) == 0, 200);
+        ok &= SIM_Check(c->rxLen == expected && memcmp(&c->rxData[expected - sizeof(message)], message, sizeof(message)) == 0,
+                        "20 byte message echoed back");
+    }
+    SIM_MeasureReport(&m, "echo 20 bytes", i);
+    // the ACK of each message is delayed and rides on the echo, the log
+    // datagrams of a debug build aside
+    ok &= SIM_Check(SIM_NetStats()->framesFromDevice - m.net.framesFromDevice -
+                    (SIM_NetStats()->udpFromDevice - m.net.udpFromDevice) == i, "one TCP frame out per message");
+    ok &= SIM_Check(c->retransmitsOut == 0, "no retransmissions needed on a clean link");
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+
+    SIM_MeasureStart(&m);
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    SIM_MeasureReport(&m, "close", 1);
+    ok &= SIM_Check(c->finReceived && SIM_TcpUnacked(c) == 0, "connection closed by both sides");
+    SIM_TcpRelease(c);
+    return ok;
+}
+
+static bool SIM_ScenarioTcpBulk(void)
+{
+    simMeasure_t m;
+    simTcpConn_t *c;
+    const uint16_t blocks = 32;
+    uint32_t total = (uint32_t)blocks * SIM_BULK_BLOCK;
+    uint8_t block[SIM_BULK_BLOCK];
+    uint32_t i;
+    bool ok = true;
+
+    memset(&bulkTCB, 0, sizeof(bulkTCB));
+    bulkBlocksLeft = 0;
+    bulkBlockLength = SIM_BULK_BLOCK;
+    bulkOffset = 0;
+    bulkRxOffset = 0;
+    bulkRxIntact = true;
+    memset(&sinkTCB, 0, sizeof(sinkTCB));
+    sinkOffset = 0;
+    sinkIntact = true;
+    sinkLimit = 0;
+    SIM_Boot();
+    SIM_AddApp(SIM_BulkSource);
+    SIM_AddApp(SIM_BulkSink);
+    SIM_ReportHeader("tcp-bulk");
+
+    SIM_RunMs(10);
+    c = SIM_TcpConnect(SIM_BULK_PORT);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    if(!SIM_Check(c->state == SIM_TCP_ESTABLISHED, "connection to the bulk source established"))
+    {
+        return false;
+    }
+
+    SIM_MeasureStart(&m);
+    bulkBlocksLeft = blocks;
+    SIM_RUN_UNTIL(c->rxLen >= total && bulkBlocksLeft == 0, 5000);
+    SIM_MeasureReport(&m, "send 512 bytes", blocks);
+    ok &= SIM_Check(c->rxLen == total, "all blocks received");
+    for(i = 0; i < c->rxLen && ok; i++)
+    {
+        ok &= SIM_Check(c->rxData[i] == SIM_BulkByte(i), "stream received in order and intact");
+    }
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+
+    // segments lost on the way out are sent again after the timeout
+    SIM_NetSetLoss(0, 250);
+    SIM_MeasureStart(&m);
+    bulkBlocksLeft = SIM_LOSSY_BLOCKS;
+    SIM_RUN_UNTIL(c->rxLen >= total + SIM_LOSSY_BLOCKS * SIM_BULK_BLOCK && bulkBlocksLeft == 0, 120000);
+    SIM_MeasureReport(&m, "send 512 B, 25% lost", SIM_LOSSY_BLOCKS);
+    SIM_NetSetLoss(0, 0);
+    ok &= SIM_Check(c->rxLen == total + SIM_LOSSY_BLOCKS * SIM_BULK_BLOCK, "all blocks received despite the losses");
+    for(i = total; i < c->rxLen && ok; i++)
+    {
+        ok &= SIM_Check(c->rxData[i] == SIM_BulkByte(i), "resent stream received in order and intact");
+    }
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums in the resent segments");
+
+    for(i = 0; i < total; i++)
+    {
+        block[i % SIM_BULK_BLOCK] = SIM_BulkByte(i);
+        if((i % SIM_BULK_BLOCK) == SIM_BULK_BLOCK - 1u)
+        {
+            SIM_TcpSend(c, block, SIM_BULK_BLOCK);
+        }
+    }
+    SIM_MeasureStart(&m);
+    SIM_RUN_UNTIL(bulkRxOffset >= total && SIM_TcpUnacked(c) == 0, 5000);
+    SIM_MeasureReport(&m, "receive 512 bytes", blocks);
+    ok &= SIM_Check(bulkRxOffset == total && bulkRxIntact, "device received the stream intact");
+    ok &= SIM_Check(c->retransmitsOut == 0, "no retransmissions needed on a clean link");
+
+    // a damaged segment must be dropped without touching the socket buffer
+    for(i = 0; i < SIM_BULK_BLOCK; i++)
+    {
+        block[i] = SIM_BulkByte(total + i);
+    }
+    SIM_TcpSend(c, block, 100);
+    SIM_NetCorruptTcp(1);
+    SIM_TcpSend(c, &block[100], SIM_BULK_BLOCK - 100u);
+    SIM_RUN_UNTIL(bulkRxOffset >= total + SIM_BULK_BLOCK && SIM_TcpUnacked(c) == 0, 2000);
+    ok &= SIM_Check(bulkRxOffset == total + SIM_BULK_BLOCK && bulkRxIntact && c->retransmitsOut > 0,
+                    "damaged segment dropped, retransmission accepted");
+
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    ok &= SIM_Check(c->finReceived && SIM_TcpUnacked(c) == 0, "connection closed by both sides");
+    SIM_TcpRelease(c);
+
+    // the sink reads the segments in place and advertises a window the
+    // Ethernet RX buffer holds
+    c = SIM_TcpConnect(SIM_SINK_PORT);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    if(!SIM_Check(c->state == SIM_TCP_ESTABLISHED, "connection to the sink established"))
+    {
+        return false;
+    }
+    ok &= SIM_Check(c->deviceWindow == TCP_RX_HANDLER_WINDOW, "sink advertises the RX handler window");
+    for(i = 0; i < total; i++)
+    {
+        block[i % SIM_BULK_BLOCK] = SIM_BulkByte(i);
+        if((i % SIM_BULK_BLOCK) == SIM_BULK_BLOCK - 1u)
+        {
+            SIM_TcpSend(c, block, SIM_BULK_BLOCK);
+        }
+    }
+    SIM_MeasureStart(&m);
+    SIM_RUN_UNTIL(sinkOffset >= total && SIM_TcpUnacked(c) == 0, 5000);
+    SIM_MeasureReport(&m, "receive in place 512 B", blocks);
+    ok &= SIM_Check(sinkOffset == total && sinkIntact, "sink read the stream intact");
+    ok &= SIM_Check(c->retransmitsOut == 0, "no retransmissions needed on a clean link");
+
+    // bytes the handler leaves are not acknowledged and come again
+    sinkLimit = 300;
+    for(i = 0; i < SIM_BULK_BLOCK; i++)
+    {
+        block[i] = SIM_BulkByte(total + i);
+    }
+    SIM_TcpSend(c, block, SIM_BULK_BLOCK);
+    SIM_RUN_UNTIL(sinkOffset >= total + SIM_BULK_BLOCK && SIM_TcpUnacked(c) == 0, 3000);
+    ok &= SIM_Check(sinkOffset == total + SIM_BULK_BLOCK && sinkIntact && c->retransmitsOut > 0,
+                    "unconsumed bytes sent again and read in order");
+
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    ok &= SIM_Check(c->finReceived && SIM_TcpUnacked(c) == 0, "sink connection closed by both sides");
+    SIM_TcpRelease(c);
+    return ok;
+}
+
+// Blocks of several segments sent through the remote window, with and without delayed ACKs
+static bool SIM_ScenarioTcpWindow(void)
+{
+    simMeasure_t m;
+    simTcpConn_t *c;
+    uint32_t delayedAck;
+    uint32_t sent = 0;
+    uint64_t elapsed;
+    uint32_t i;
+    bool ok = true;
+
+    memset(&bulkTCB, 0, sizeof(bulkTCB));
+    bulkBlocksLeft = 0;
+    bulkBlockLength = SIM_WINDOW_BLOCK;
+    bulkOffset = 0;
+    bulkRxOffset = 0;
+    bulkRxIntact = true;
+    SIM_Boot();
+    SIM_AddApp(SIM_BulkSource);
+    SIM_ReportHeader("tcp-window");
+
+    c = SIM_TcpConnect(SIM_BULK_PORT);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    if(!SIM_Check(c->state == SIM_TCP_ESTABLISHED, "connection to the bulk source established"))
+    {
+        return false;
+    }
+
+    // the segments of a block go out without waiting for an ACK each, so a
+    // peer that acknowledges every second segment at once never holds one
+    // back for long
+    for(delayedAck = 0; delayedAck <= SIM_DELAYED_ACK_MS; delayedAck += SIM_DELAYED_ACK_MS)
+    {
+        SIM_NetSetPeerDelayedAck(delayedAck);
+        sent = c->rxLen;
+        SIM_MeasureStart(&m);
+        bulkBlocksLeft = SIM_WINDOW_BLOCKS;
+        SIM_RUN_UNTIL(c->rxLen >= sent + SIM_WINDOW_BLOCKS * SIM_WINDOW_BLOCK && bulkBlocksLeft == 0 &&
+                      TCP_SendDone(&bulkTCB) == SUCCESS, 30000);
+        elapsed = SIM_TcyToUs(J60_Cycles() - m.cycles);
+        SIM_MeasureReport(&m, delayedAck ? "send 5840 B, delayed ACK" : "send 5840 bytes", SIM_WINDOW_BLOCKS);
+        printf("  %lu bytes/s with ACKs delayed up to %u ms\n",
+               (unsigned long)((uint64_t)(c->rxLen - sent) * 1000000u / (elapsed ? elapsed : 1)), (unsigned)delayedAck);
+        ok &= SIM_Check(c->rxLen == sent + SIM_WINDOW_BLOCKS * SIM_WINDOW_BLOCK, "all blocks received");
+        // one segment at a time would wait for a delayed ACK per segment
+        ok &= SIM_Check(elapsed < (uint64_t)SIM_WINDOW_BLOCKS * SIM_DELAYED_ACK_MS * 1000u,
+                        "segments of a block in flight together");
+    }
+    SIM_NetSetPeerDelayedAck(0);
+    for(i = 0; i < c->rxLen && ok; i++)
+    {
+        ok &= SIM_Check(c->rxData[i] == SIM_BulkByte(i), "stream received in order and intact");
+    }
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    ok &= SIM_Check(c->finReceived && SIM_TcpUnacked(c) == 0, "connection closed by both sides");
+    SIM_TcpRelease(c);
+    return ok;
+}
+
+// more echo servers on port 7, the same as DEMO_TCP_EchoServer()
+static void SIM_DemuxEcho(void)
+{
+    uint16_t length;
+    uint8_t i;
+
+    for(i = 0; i < demuxCount; i++)
+    {
+        switch(TCP_SocketPoll(&demuxTCB[i]))
+        {
+            case NOT_A_SOCKET:
+                TCP_SocketInit(&demuxTCB[i]);
+                break;
+            case SOCKET_CLOSED:
+                TCP_Bind(&demuxTCB[i], 7);
+                TCP_InsertRxBuffer(&demuxTCB[i], demuxRx[i], sizeof(demuxRx[i]));
+                TCP_Listen(&demuxTCB[i]);
+                break;
+            case SOCKET_CONNECTED:
+                if(TCP_SendDone(&demuxTCB[i]) && TCP_GetRxLength(&demuxTCB[i]) > 0)
+                {
+                    length = (uint16_t)TCP_GetReceivedData(&demuxTCB[i]);
+                    memcpy(demuxTx[i], demuxRx[i], length);
+                    TCP_InsertRxBuffer(&demuxTCB[i], demuxRx[i], sizeof(demuxRx[i]));
+                    TCP_Send(&demuxTCB[i], demuxTx[i], length);
+                }
+                break;
+            case SOCKET_CLOSING:
+                TCP_SocketRemove(&demuxTCB[i]);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// TCBs a walk of the socket list compares to find the connection
+static uint8_t SIM_DemuxListPosition(const simTcpConn_t *c)
+{
+    tcpTCB_t *tcbPtr = tcbList;
+    uint8_t position = 1;
+
+    while(tcbPtr != NULL && tcbPtr->destPort != c->peerPort)
+    {
+        tcbPtr = tcbPtr->nextTCB;
+        position++;
+    }
+    return position;
+}
+
+static bool SIM_ScenarioTcpDemux(void)
+{
+    static const uint8_t counts[] = {1, 4, SIM_DEMUX_SOCKETS};
+    simMeasure_t m;
+    simTcpConn_t *c[SIM_DEMUX_SOCKETS];
+    tcpLookupStats_t before;
+    char label[32];
+    char message[20];
+    uint32_t expected;
+    uint32_t walk;
+    uint32_t lookups;
+    uint32_t compares;
+    uint8_t run;
+    uint8_t n;
+    uint8_t i;
+    uint8_t k;
+    bool ok = true;
+
+    for(run = 0; run < sizeof(counts) && ok; run++)
+    {
+        n = counts[run];
+        demuxCount = n - 1u;
+        memset(demuxTCB, 0, sizeof(demuxTCB));
+        SIM_Boot();
+        SIM_AddApp(SIM_DemuxEcho);
+        if(run == 0)
+        {
+            SIM_ReportHeader("tcp-demux");
+        }
+        SIM_RunMs(5);
+
+        // every connection to port 7 takes the next listening socket
+        for(i = 0; i < n; i++)
+        {
+            c[i] = SIM_TcpConnect(7);
+            SIM_RUN_UNTIL(c[i]->state == SIM_TCP_ESTABLISHED, 100);
+            ok &= SIM_Check(c[i]->state == SIM_TCP_ESTABLISHED, "connection to a shared port established");
+        }
+        if(!ok)
+        {
+            return false;
+        }
+
+        walk = 0;
+        for(i = 0; i < n; i++)
+        {
+            walk += SIM_DemuxListPosition(c[i]);
+        }
+
+        before = tcpLookupStats;
+        SIM_MeasureStart(&m);
+        for(k = 0; k < SIM_DEMUX_MESSAGES && ok; k++)
+        {
+            for(i = 0; i < n; i++)
+            {
+                snprintf(message, sizeof(message), "conn %02u message %03u", i, k);
+                SIM_TcpSend(c[i], message, sizeof(message));
+            }
+            expected = (uint32_t)(k + 1u) * sizeof(message);
+            for(i = 0; i < n; i++)
+            {
+                SIM_RUN_UNTIL(c[i]->rxLen >= expected && SIM_TcpUnacked(c[i]) == 0, 500);
+                snprintf(message, sizeof(message), "conn %02u message %03u", i, k);
+                ok &= SIM_Check(c[i]->rxLen == expected && memcmp(&c[i]->rxData[expected - sizeof(message)], message, sizeof(message)) == 0,
+                                "message echoed on its own connection");
+            }
+        }
+        lookups = tcpLookupStats.lookups - before.lookups;
+        compares = tcpLookupStats.compares - before.compares;
+        snprintf(label, sizeof(label), "echo, %u socket%s", n, (n == 1u) ? "" : "s");
+        SIM_MeasureReport(&m, label, (uint32_t)n * SIM_DEMUX_MESSAGES);
+        printf("  %.2f TCBs compared per segment, a list walk %.2f\n",
+               (double)compares / (lookups ? lookups : 1), (double)walk / n);
+        ok &= SIM_Check(compares <= 2u * lookups, "segments found within two TCB compares on average");
+
+        for(i = 0; i < n; i++)
+        {
+            SIM_TcpClose(c[i]);
+        }
+        for(i = 0; i < n; i++)
+        {
+            SIM_RUN_UNTIL(c[i]->finReceived && SIM_TcpUnacked(c[i]) == 0, 3000);
+            ok &= SIM_Check(c[i]->finReceived && SIM_TcpUnacked(c[i]) == 0, "connection closed by both sides");
+            SIM_TcpRelease(c[i]);
+        }
+    }
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+    return ok;
+}
+
+// echo what a connected socket received, remove it once it closed
+static bool SIM_EchoSocket(tcpTCB_t *tcb, uint8_t *rx, uint8_t *tx)
+{
+    uint16_t length;
+
+    switch(TCP_SocketPoll(tcb))
+    {
+        case SOCKET_CONNECTED:
+            if(TCP_SendDone(tcb) && TCP_GetRxLength(tcb) > 0)
+            {
+                length = (uint16_t)TCP_GetReceivedData(tcb);
+                memcpy(tx, rx, length);
+                TCP_InsertRxBuffer(tcb, rx, 20);
+                TCP_Send(tcb, tx, length);
+            }
+            break;
+        case SOCKET_CLOSING:
+            TCP_SocketRemove(tcb);
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+// one socket that listens again after each client, like DEMO_TCP_EchoServer() did
+static void SIM_SingleEcho(void)
+{
+    switch(TCP_SocketPoll(&acceptTCB[0]))
+    {
+        case NOT_A_SOCKET:
+            TCP_SocketInit(&acceptTCB[0]);
+            break;
+        case SOCKET_CLOSED:
+            TCP_Bind(&acceptTCB[0], SIM_ACCEPT_PORT);
+            TCP_InsertRxBuffer(&acceptTCB[0], acceptRx[0], sizeof(acceptRx[0]));
+            TCP_Listen(&acceptTCB[0]);
+            break;
+        default:
+            SIM_EchoSocket(&acceptTCB[0], acceptRx[0], acceptTx[0]);
+            break;
+    }
+}
+
+// a listener with a socket per client
+static void SIM_AcceptEcho(void)
+{
+    tcpTCB_t *client;
+    uint8_t i;
+
+    if(acceptListener.pool == NULL)
+    {
+        TCP_ListenerInit(&acceptListener, SIM_ACCEPT_PORT, acceptTCB, SIM_ACCEPT_CLIENTS,
+                         &acceptRx[0][0], sizeof(acceptRx[0]), TCP_LISTEN_BACKLOG_MAX);
+        return;
+    }
+    while((client = TCP_Accept(&acceptListener)) != NULL)
+    {
+        acceptTaken[client - acceptTCB] = true;
+    }
+    for(i = 0; i < SIM_ACCEPT_CLIENTS; i++)
+    {
+        if(acceptTaken[i] && SIM_EchoSocket(&acceptTCB[i], acceptRx[i], acceptTx[i]))
+        {
+            acceptTaken[i] = false;
+        }
+    }
+}
+
+static bool SIM_ScenarioTcpAccept(void)
+{
+    simMeasure_t m;
+    simTcpConn_t *c[SIM_ACCEPT_CLIENTS];
+    bool sent[SIM_ACCEPT_CLIENTS];
+    char message[20];
+    uint64_t connected;
+    uint32_t retries;
+    uint8_t started;
+    uint8_t done;
+    uint8_t run;
+    uint8_t i;
+    bool ok = true;
+
+    for(run = 0; run < 2u; run++)
+    {
+        memset(&acceptListener, 0, sizeof(acceptListener));
+        memset(acceptTCB, 0, sizeof(acceptTCB));
+        memset(acceptTaken, 0, sizeof(acceptTaken));
+        SIM_Boot();
+        SIM_AddApp(run ? SIM_AcceptEcho : SIM_SingleEcho);
+        if(run == 0)
+        {
+            SIM_ReportHeader("tcp-accept");
+        }
+        SIM_RunMs(5);
+
+        // every client connects at once, sends a message and closes after the echo
+        SIM_MeasureStart(&m);
+        for(i = 0; i < SIM_ACCEPT_CLIENTS; i++)
+        {
+            c[i] = SIM_TcpConnect(SIM_ACCEPT_PORT);
+            sent[i] = false;
+        }
+        connected = 0;
+        done = 0;
+        while(done < SIM_ACCEPT_CLIENTS && SIM_TcyToUs(J60_Cycles() - m.cycles) < 10000000u)
+        {
+            SIM_Loop();
+            started = 0;
+            done = 0;
+            for(i = 0; i < SIM_ACCEPT_CLIENTS; i++)
+            {
+                if(!sent[i] && c[i]->state == SIM_TCP_ESTABLISHED)
+                {
+                    snprintf(message, sizeof(message), "client %u message", i);
+                    SIM_TcpSend(c[i], message, sizeof(message));
+                    sent[i] = true;
+                }
+                else if(sent[i] && c[i]->state == SIM_TCP_ESTABLISHED && c[i]->rxLen >= sizeof(message))
+                {
+                    SIM_TcpClose(c[i]);
+                }
+                started += sent[i];
+                if(c[i]->finReceived && SIM_TcpUnacked(c[i]) == 0)
+                {
+                    done++;
+                }
+            }
+            if(connected == 0 && started == SIM_ACCEPT_CLIENTS)
+            {
+                connected = J60_Cycles() - m.cycles;
+            }
+        }
+        SIM_MeasureReport(&m, run ? "4 clients, listener" : "4 clients, one socket", SIM_ACCEPT_CLIENTS);
+        retries = 0;
+        for(i = 0; i < SIM_ACCEPT_CLIENTS; i++)
+        {
+            snprintf(message, sizeof(message), "client %u message", i);
+            ok &= SIM_Check(c[i]->rxLen == sizeof(message) && memcmp(c[i]->rxData, message, sizeof(message)) == 0,
+                            "message echoed to its client");
+            ok &= SIM_Check(c[i]->finReceived && SIM_TcpUnacked(c[i]) == 0, "connection closed by both sides");
+            retries += c[i]->retransmitsOut;
+            SIM_TcpRelease(c[i]);
+        }
+        printf("  all connected after %.1f ms, %lu SYN or data retransmissions\n",
+               (double)SIM_TcyToUs(connected) / 1000.0, (unsigned long)retries);
+        if(run)
+        {
+            // the clients do not wait for each other
+            ok &= SIM_Check(retries == 0, "every client connected without retrying");
+            ok &= SIM_Check(connected != 0 && SIM_TcyToUs(connected) < 10000u, "every client connected within 10 ms");
+        }
+    }
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+    return ok;
+}
+
+static int SIM_CompareUs(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static bool SIM_ScenarioTcpRto(void)
+{
+    static uint32_t latencyUs[SIM_RTO_MESSAGES];
+    simMeasure_t m;
+    simTcpConn_t *c;
+    char message[20];
+    uint32_t expected = 0;
+    uint64_t sentAt;
+    uint16_t retransmits;
+    uint16_t i;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("tcp-rto");
+
+    c = SIM_TcpConnect(7);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    if(!SIM_Check(c->state == SIM_TCP_ESTABLISHED, "connection to port 7 established"))
+    {
+        return false;
+    }
+
+    // the device times the echoes it sends, a lost one comes again after
+    // the time-out computed from them
+    SIM_NetSetLoss(0, SIM_RTO_LOSS);
+    retransmits = netStats.tcpRetransmits;
+    SIM_MeasureStart(&m);
+    for(i = 0; i < SIM_RTO_MESSAGES && ok; i++)
+    {
+        snprintf(message, sizeof(message), "lossy message %05u", i);
+        sentAt = J60_Cycles();
+        SIM_TcpSend(c, message, sizeof(message));
+        expected += sizeof(message);
+        SIM_RUN_UNTIL(c->rxLen >= expected && SIM_TcpUnacked(c) == 0, 5000);
+        latencyUs[i] = (uint32_t)SIM_TcyToUs(J60_Cycles() - sentAt);
+        ok &= SIM_Check(c->rxLen == expected && memcmp(&c->rxData[expected - sizeof(message)], message, sizeof(message)) == 0,
+                        "20 byte message echoed back");
+    }
+    SIM_MeasureReport(&m, "echo 20 B, 2% lost", i);
+    SIM_NetSetLoss(0, 0);
+    retransmits = netStats.tcpRetransmits - retransmits;
+
+    qsort(latencyUs, i, sizeof(latencyUs[0]), SIM_CompareUs);
+    printf("  median %.1f ms, 99th percentile %.1f ms, worst %.1f ms, %u echoes sent again\n",
+           latencyUs[i / 2u] / 1000.0, latencyUs[(i * 99u) / 100u] / 1000.0, latencyUs[i - 1u] / 1000.0, retransmits);
+    ok &= SIM_Check(retransmits > 0, "lost echoes sent again");
+    // the time-out follows the LAN round trip down to TCP_RTO_MIN_MS, a
+    // second loss of the same echo waits twice as long
+    ok &= SIM_Check(latencyUs[(i * 99u) / 100u] < 2u * TCP_RTO_MIN_MS * 1000u,
+                    "99% of the echoes within twice the shortest time-out");
+    ok &= SIM_Check(latencyUs[i - 1u] < TCP_RTO_INITIAL_MS * 1000u,
+                    "worst echo within the time-out used before a round trip is measured");
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    ok &= SIM_Check(c->finReceived && SIM_TcpUnacked(c) == 0, "connection closed by both sides");
+    SIM_TcpRelease(c);
+    return ok;
+}
+
+// The link goes down while blocks are in flight and comes back, the
+// connection backs off and carries on where it stopped
+static bool SIM_ScenarioTcpOutage(void)
+{
+    simTcpConn_t *c;
+    uint64_t restoredAt;
+    uint16_t retransmits;
+    uint32_t total = SIM_WINDOW_BLOCKS * SIM_WINDOW_BLOCK;
+    uint32_t i;
+    bool ok = true;
+
+    memset(&bulkTCB, 0, sizeof(bulkTCB));
+    bulkBlocksLeft = 0;
+    bulkBlockLength = SIM_WINDOW_BLOCK;
+    bulkOffset = 0;
+    bulkRxOffset = 0;
+    bulkRxIntact = true;
+    SIM_Boot();
+    SIM_AddApp(SIM_BulkSource);
+    SIM_ReportHeader("tcp-outage");
+
+    c = SIM_TcpConnect(SIM_BULK_PORT);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    if(!SIM_Check(c->state == SIM_TCP_ESTABLISHED, "connection to the bulk source established"))
+    {
+        return false;
+    }
+
+    retransmits = netStats.tcpRetransmits;
+    bulkBlocksLeft = SIM_WINDOW_BLOCKS;
+    SIM_RUN_UNTIL(c->rxLen > 0, 100);
+    SIM_NetSetLoss(1000, 1000);
+    SIM_RunMs(SIM_OUTAGE_MS);
+    SIM_NetSetLoss(0, 0);
+    restoredAt = J60_Cycles();
+    SIM_RUN_UNTIL(c->rxLen >= total && bulkBlocksLeft == 0 && TCP_SendDone(&bulkTCB) == SUCCESS, 30000);
+    retransmits = netStats.tcpRetransmits - retransmits;
+    printf("  %u ms outage, stream complete %.1f ms after the link came back, %u segments sent again\n",
+           SIM_OUTAGE_MS, (double)SIM_TcyToUs(J60_Cycles() - restoredAt) / 1000.0, retransmits);
+    // the time-outs double from the LAN round trip, a few of them are
+    // over long before the link comes back
+    ok &= SIM_Check(!c->reset && c->state == SIM_TCP_ESTABLISHED, "connection kept through the outage");
+    ok &= SIM_Check(c->rxLen == total, "all blocks received");
+    for(i = 0; i < c->rxLen && ok; i++)
+    {
+        ok &= SIM_Check(c->rxData[i] == SIM_BulkByte(i), "stream received in order and intact");
+    }
+    ok &= SIM_Check(retransmits > 0, "lost segments sent again");
+
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    ok &= SIM_Check(c->finReceived && SIM_TcpUnacked(c) == 0, "connection closed by both sides");
+    SIM_TcpRelease(c);
+    return ok;
+}
+
+// Driver block transfers called directly, on the TX buffer while the stack
+// is idle: ETH_WriteBlock fills it, ETH_ReadBlock(Checksum) reads it back.
+// Only register and EDATA accesses are modelled, the per byte bookkeeping
+// of the loops themselves is not part of Tcy/op.
+static bool SIM_ScenarioBlock(void)
+{
+    static const uint16_t sizes[] = {20, 64, 512, SIM_BLOCK_MAX};
+    static uint8_t out[SIM_BLOCK_MAX];
+    static uint8_t in[SIM_BLOCK_MAX];
+    simMeasure_t m;
+    char label[32];
+    uint16_t n;
+    uint16_t start;
+    uint16_t txCksm = 0;
+    uint16_t rxCksm = 0;
+    uint8_t i;
+    uint8_t r;
+    bool ok = true;
+    bool lengthsOk = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("block");
+
+    for(n = 0; n < SIM_BLOCK_MAX; n++)
+    {
+        out[n] = SIM_BulkByte(n);
+    }
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        n = sizes[i];
+
+        snprintf(label, sizeof(label), "write %u bytes", (unsigned)n);
+        SIM_MeasureStart(&m);
+        for(r = 0; r < SIM_BLOCK_REPEAT; r++)
+        {
+            ETH_TxReset();
+            start = ETH_GetWritePtr();
+            ETH_TxChecksumStart();
+            lengthsOk &= ETH_WriteBlock((const char *)out, n) == n;
+            txCksm = ETH_TxChecksumGet(0);
+        }
+        SIM_MeasureReport(&m, label, SIM_BLOCK_REPEAT);
+
+        snprintf(label, sizeof(label), "read %u bytes", (unsigned)n);
+        memset(in, 0, sizeof(in));
+        SIM_MeasureStart(&m);
+        for(r = 0; r < SIM_BLOCK_REPEAT; r++)
+        {
+            ETH_SetReadPtr(start);
+            ETH_SetStatusVectorByteCount(n);
+            lengthsOk &= ETH_ReadBlock(in, SIM_BLOCK_MAX) == n;
+        }
+        SIM_MeasureReport(&m, label, SIM_BLOCK_REPEAT);
+        ok &= SIM_Check(memcmp(in, out, n) == 0, "block read back as written");
+
+        snprintf(label, sizeof(label), "read+sum %u bytes", (unsigned)n);
+        memset(in, 0, sizeof(in));
+        SIM_MeasureStart(&m);
+        for(r = 0; r < SIM_BLOCK_REPEAT; r++)
+        {
+            ETH_SetReadPtr(start);
+            ETH_SetStatusVectorByteCount(n);
+            ETH_RxChecksumStart(0);
+            // split so that the second block starts on an odd byte
+            lengthsOk &= ETH_ReadBlockChecksum(in, 7) == 7;
+            lengthsOk &= ETH_ReadBlockChecksum(&in[7], SIM_BLOCK_MAX) == n - 7u;
+            rxCksm = ETH_RxChecksumGet();
+        }
+        SIM_MeasureReport(&m, label, SIM_BLOCK_REPEAT);
+        ok &= SIM_Check(memcmp(in, out, n) == 0, "summed block read back as written");
+        ok &= SIM_Check(rxCksm == J60_InetChecksum(out, n, 0), "checksum of the block read");
+        ok &= SIM_Check(txCksm == (uint16_t)((J60_InetChecksum(out, n, 0) << 8) | (J60_InetChecksum(out, n, 0) >> 8)),
+                        "checksum of the block written");
+    }
+    ok &= SIM_Check(lengthsOk, "block functions return the number of bytes moved");
+
+    ETH_TxReset();
+    ETH_SetStatusVectorByteCount(0);
+    return ok;
+}
+
+// Ethernet SRAM heap called directly while the stack is idle: blocks are
+// filled from RAM, the RX buffer (across its wrap) and each other, and one
+// is appended to a TX packet.
+static bool SIM_ScenarioHeap(void)
+{
+    static uint8_t out[SRAM_LARGE_BLOCK_SIZE];
+    static uint8_t in[SRAM_LARGE_BLOCK_SIZE];
+    sramBlock_t blocks[SRAM_SMALL_BLOCKS + SRAM_LARGE_BLOCKS];
+    sramBlock_t large;
+    sramBlock_t small;
+    simMeasure_t m;
+    uint16_t rxEnd;
+    uint16_t start;
+    uint16_t n;
+    uint8_t i;
+    uint8_t r;
+    bool ok = true;
+    bool distinct = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("heap");
+
+    for(n = 0; n < sizeof(out); n++)
+    {
+        out[n] = SIM_BulkByte(n);
+    }
+
+    // every block once, the small ones before any large one
+    for(i = 0; i < SRAM_SMALL_BLOCKS + SRAM_LARGE_BLOCKS; i++)
+    {
+        blocks[i] = SRAM_Alloc(1);
+        distinct &= (blocks[i] != SRAM_NO_BLOCK) && (i == 0 || blocks[i] > blocks[i - 1]);
+    }
+    ok &= SIM_Check(distinct, "every block allocated once");
+    ok &= SIM_Check(SRAM_BlockSize(blocks[SRAM_SMALL_BLOCKS]) == SRAM_LARGE_BLOCK_SIZE,
+                    "small pool used up before the large one");
+    ok &= SIM_Check(blocks[0] == ETH_GetHeapStart() &&
+                    blocks[SRAM_SMALL_BLOCKS + SRAM_LARGE_BLOCKS - 1] + SRAM_LARGE_BLOCK_SIZE == ETH_GetHeapStart() + SRAM_HEAP_SIZE,
+                    "heap fills the gap before the TX buffer");
+    ok &= SIM_Check(SRAM_Alloc(1) == SRAM_NO_BLOCK && sramHeapStats.failures == 1, "full heap refuses");
+    SRAM_Free(blocks[3]);
+    SRAM_Free(blocks[3]);
+    ok &= SIM_Check(SRAM_Alloc(SRAM_SMALL_BLOCK_SIZE) == blocks[3], "freed block reused");
+    for(i = 0; i < SRAM_SMALL_BLOCKS + SRAM_LARGE_BLOCKS; i++)
+    {
+        SRAM_Free(blocks[i]);
+    }
+    ok &= SIM_Check(sramHeapStats.used[0] == 0 && sramHeapStats.used[1] == 0 &&
+                    sramHeapStats.peak[0] == SRAM_SMALL_BLOCKS, "pool counts follow alloc and free");
+
+    large = SRAM_Alloc(SRAM_SMALL_BLOCK_SIZE + 1);
+    small = SRAM_Alloc(1);
+    ok &= SIM_Check(SRAM_BlockSize(large) == SRAM_LARGE_BLOCK_SIZE && SRAM_BlockSize(small) == SRAM_SMALL_BLOCK_SIZE &&
+                    SRAM_Alloc(SRAM_LARGE_BLOCK_SIZE + 1) == SRAM_NO_BLOCK, "size picks the pool");
+    ok &= SIM_Check(SRAM_Write(large, 0, out, sizeof(out) + 1) == sizeof(out), "write clipped to the block");
+
+    SIM_MeasureStart(&m);
+    for(r = 0; r < SIM_BLOCK_REPEAT; r++)
+    {
+        SRAM_Write(large, 0, out, SIM_HEAP_BYTES);
+    }
+    SIM_MeasureReport(&m, "heap write 512 bytes", SIM_BLOCK_REPEAT);
+
+    memset(in, 0, sizeof(in));
+    SIM_MeasureStart(&m);
+    for(r = 0; r < SIM_BLOCK_REPEAT; r++)
+    {
+        SRAM_Read(large, 0, in, SIM_HEAP_BYTES);
+    }
+    SIM_MeasureReport(&m, "heap read 512 bytes", SIM_BLOCK_REPEAT);
+    ok &= SIM_Check(memcmp(in, out, SIM_HEAP_BYTES) == 0, "block read back as written");
+    ok &= SIM_Check(SRAM_Read(large, sizeof(out) - 2, in, 8) == 2, "read clipped to the block");
+
+    SIM_MeasureStart(&m);
+    for(r = 0; r < SIM_BLOCK_REPEAT; r++)
+    {
+        SRAM_Checksum(large, 0, SIM_HEAP_BYTES);
+    }
+    SIM_MeasureReport(&m, "heap sum 512 bytes", SIM_BLOCK_REPEAT);
+    ok &= SIM_Check(SRAM_Checksum(large, 0, SIM_HEAP_BYTES) == (uint16_t)~J60_InetChecksum(out, SIM_HEAP_BYTES, 0) &&
+                    SRAM_Checksum(large, 2, 7) == (uint16_t)~J60_InetChecksum(&out[2], 7, 0), "block summed");
+
+    memset(in, 0, sizeof(in));
+    ok &= SIM_Check(SRAM_Copy(small, large, SIM_HEAP_BYTES) == SRAM_SMALL_BLOCK_SIZE, "copy clipped to the block");
+    SRAM_Read(small, 0, in, SRAM_SMALL_BLOCK_SIZE);
+    ok &= SIM_Check(memcmp(in, out, SRAM_SMALL_BLOCK_SIZE) == 0, "block copied by DMA");
+
+    // received data that wraps at the end of the RX buffer
+    rxEnd = ETH_GetHeapStart() - 1u;
+    ETH_SramWrite(rxEnd - 99u, &out[100], 100);
+    ETH_SramWrite(0, &out[200], 100);
+    ETH_SetReadPtr(rxEnd - 99u);
+    ETH_SetStatusVectorByteCount(150);
+    ok &= SIM_Check(SRAM_CopyFromRx(large, 100, 200) == 150, "RX copy clipped to the packet");
+    ok &= SIM_Check(ETH_GetReadPtr() == rxEnd - 99u && ETH_GetRxByteCount() == 150, "RX copy keeps the read pointer");
+    memset(in, 0, sizeof(in));
+    SRAM_Read(large, 0, in, 250);
+    ok &= SIM_Check(memcmp(in, out, 250) == 0, "RX data copied across the wrap");
+    ETH_SetStatusVectorByteCount(0);
+
+    // appended to a packet, the queued DMA is done before the next heap write
+    ETH_TxReset();
+    ok &= SIM_Check(ETH_WriteStart(&broadcastMAC, 0x88B5, 300) == SUCCESS, "packet started");
+    start = ETH_GetWritePtr();
+    ok &= SIM_Check(SRAM_CopyToTx(large, 12, 300) == 300 && ETH_GetWritePtr() == start + 300u, "block appended to the packet");
+    SRAM_Write(small, 0, out, 1);
+    memset(in, 0, sizeof(in));
+    ETH_SramRead(start, in, 300);
+    ok &= SIM_Check(memcmp(in, &out[12], 300) == 0, "packet holds the block");
+    ETH_TxReset();
+
+    SRAM_Free(large);
+    SRAM_Free(small);
+    return ok;
+}
+
+// back to back UDP datagrams from the device, more than the wire can take,
+// so frames queue up in the TX buffer
+static void SIM_ReportTxClass(const char *name, const ethTxClassStats_t *now, const ethTxClassStats_t *before)
+{
+    uint32_t sent = now->sent - before->sent;
+
+    printf("  %-8s %5lu sent, queue peak %u, latency avg %lu peak %u TMR1 ticks\n", name, (unsigned long)sent,
+           now->queuedPeak, (unsigned long)(sent ? (now->latencyTicks - before->latencyTicks) / sent : 0),
+           now->latencyPeak);
+}
+
+static void SIM_OrderSink(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length)
+{
+    if(orderCount == 1u)
+    {
+        orderPingAhead = SIM_PingReplied(SIM_CONTROL_PING);
+    }
+    if(orderCount < sizeof(orderPorts) / sizeof(orderPorts[0]))
+    {
+        orderPorts[orderCount++] = dstPort;
+    }
+}
+
+static bool SIM_ScenarioTxBurst(void)
+{
+    simMeasure_t m;
+    ethTxStats_t before;
+#ifndef NETWORK_SINGLE_READ
+    uint32_t latency[ETH_TX_CLASSES];
+    uint32_t sent[ETH_TX_CLASSES];
+#endif
+    uint16_t replied = 0;
+    uint16_t controlArea;
+    uint16_t i;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("tx-burst");
+    burstSent = 0;
+    burstReceived = 0;
+    burstIntact = true;
+    before = ethTxStats;
+    SIM_UdpSetHandler(SIM_BurstSink);
+    SIM_MeasureStart(&m);
+    burstPerPass = 0;
+    SIM_AddApp(SIM_BurstSource);
+    SIM_RUN_UNTIL(burstReceived == SIM_BURST_COUNT, 2000);
+    SIM_MeasureReport(&m, "udp datagram", burstReceived);
+    printf("  TX buffer wraps %u, queued bytes not moved %lu\n",
+           (unsigned)(ethTxStats.shiftsAvoided - before.shiftsAvoided),
+           (unsigned long)(ethTxStats.shiftBytesAvoided - before.shiftBytesAvoided));
+    ok &= SIM_Check(burstReceived == SIM_BURST_COUNT, "every datagram of the burst arrived");
+    ok &= SIM_Check(burstIntact, "datagrams arrived in order and intact");
+    ok &= SIM_Check(ethTxStats.shiftsAvoided != before.shiftsAvoided, "TX buffer wrapped with frames queued");
+
+    // a few datagrams a pass leave room for the echo replies, which are
+    // control frames and go out ahead of the datagrams queued before them
+    burstSent = 0;
+    burstReceived = 0;
+    burstPerPass = 3;
+    before = ethTxStats;
+    for(i = 0; i < ETH_TX_CLASSES; i++)
+    {
+        ethTxStats.classes[i].queuedPeak = 0;
+        ethTxStats.classes[i].latencyPeak = 0;
+    }
+    SIM_MeasureStart(&m);
+    for(i = 0; i < SIM_BURST_PINGS; i++)
+    {
+        SIM_Ping(600 + i, 56);
+        SIM_RunMs(3);
+    }
+    SIM_RUN_UNTIL(burstReceived == SIM_BURST_COUNT, 2000);
+    SIM_MeasureReport(&m, "datagram, 3 a pass + ping", burstReceived);
+    SIM_UdpSetHandler(NULL);
+    for(i = 0; i < SIM_BURST_PINGS; i++)
+    {
+        replied += SIM_PingReplied(600 + i);
+    }
+    SIM_ReportTxClass("bulk", &ethTxStats.classes[ETH_TX_BULK], &before.classes[ETH_TX_BULK]);
+    SIM_ReportTxClass("control", &ethTxStats.classes[ETH_TX_CONTROL], &before.classes[ETH_TX_CONTROL]);
+    printf("  %u of %u pings answered during the burst, %u control frames sent ahead of data\n",
+           replied, SIM_BURST_PINGS, (unsigned)(ethTxStats.overtaken - before.overtaken));
+
+    ok &= SIM_Check(burstReceived == SIM_BURST_COUNT && burstIntact, "every datagram arrived in order and intact");
+#ifndef NETWORK_SINGLE_READ
+    for(i = 0; i < ETH_TX_CLASSES; i++)
+    {
+        sent[i] = ethTxStats.classes[i].sent - before.classes[i].sent;
+        latency[i] = ethTxStats.classes[i].latencyTicks - before.classes[i].latencyTicks;
+    }
+    // without the batch TX check a ping that finds the buffer full is dropped
+    ok &= SIM_Check(replied == SIM_BURST_PINGS, "pings answered during the burst");
+    ok &= SIM_Check(sent[ETH_TX_CONTROL] != 0 && latency[ETH_TX_CONTROL] / sent[ETH_TX_CONTROL] < latency[ETH_TX_BULK] / sent[ETH_TX_BULK],
+                    "control frames waited less than bulk frames");
+#endif
+
+    // three datagrams queued at once and a control frame behind them, the
+    // control frame goes out before the datagrams still waiting, once the
+    // replies left from the burst are out of the way
+    SIM_RUN_UNTIL(ETH_TxReady(ETH_MTU) && ethTxStats.classes[ETH_TX_BULK].queued == 0 && ethTxStats.classes[ETH_TX_CONTROL].queued == 0, 50);
+    orderCount = 0;
+    SIM_UdpSetHandler(SIM_OrderSink);
+    for(i = 0; i < 4u; i++)
+    {
+        if(UDP_Start(0xFFFFFFFF, SIM_BURST_PORT, (uint16_t)(SIM_BURST_PORT + i)) == SUCCESS)
+        {
+            if(i < 3u)
+            {
+                UDP_WriteBlock((char *)bulkTx, 300);
+            }
+            else
+            {
+                ETH_SetTxClass(ETH_TX_CONTROL);
+                UDP_Write16(0);
+            }
+            UDP_Send();
+        }
+    }
+    SIM_RUN_UNTIL(orderCount == 4u, 50);
+    SIM_UdpSetHandler(NULL);
+    ok &= SIM_Check(orderCount == 4u && orderPorts[3] != SIM_BURST_PORT + 3u, "control frame sent ahead of queued datagrams");
+
+    // two full size datagrams fill the TX buffer once the frames sent before
+    // are off the wire, a short ping still finds room in the control area
+    // and the reply goes out ahead of the second datagram
+    SIM_RUN_UNTIL(ethTxStats.classes[ETH_TX_BULK].queued == 0 && ethTxStats.classes[ETH_TX_CONTROL].queued == 0 && J60_WirePending() == 0, 50);
+    SIM_RunMs(2);
+    orderCount = 0;
+    orderPingAhead = false;
+    controlArea = ethTxStats.controlArea;
+    SIM_UdpSetHandler(SIM_OrderSink);
+    for(i = 0; i < 2u; i++)
+    {
+        if(UDP_Start(0xFFFFFFFF, SIM_BURST_PORT, (uint16_t)(SIM_BURST_PORT + i)) == SUCCESS)
+        {
+            UDP_WriteBlock((char *)bulkTx, ETH_MTU - sizeof(ipv4Header_t) - sizeof(udpHeader_t));
+            UDP_Send();
+        }
+    }
+    ok &= SIM_Check(!ETH_TxReady(ETH_MTU), "two full size datagrams fill the TX buffer");
+    SIM_Ping(SIM_CONTROL_PING, 16);
+    SIM_RUN_UNTIL(SIM_PingReplied(SIM_CONTROL_PING) && orderCount == 2u, 50);
+    SIM_UdpSetHandler(NULL);
+   
+    printf("  %u control area frames behind full size datagrams\n", (unsigned)(ethTxStats.controlArea - controlArea));
+    ok &= SIM_Check(SIM_PingReplied(SIM_CONTROL_PING) && ethTxStats.controlArea != controlArea, "ping answered from the control area");
+    ok &= SIM_Check(orderCount == 2u && orderPingAhead, "reply sent ahead of the queued datagram");
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == 0, "no bad checksums from the device");
+    return ok;
+}
+
+static void SIM_LogSink(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length)
+{
+    if(dstPort != LOG_RING_PORT || logLength + length > sizeof(logData))
+    {
+        return;
+    }
+    memcpy(logData + logLength, data, length);
+    logLength += length;
+    logDatagrams++;
+}
+
+// decode the log datagrams received so far into text, the caller frees it
+static char *SIM_LogText(uint16_t *lines)
+{
+    char *text = NULL;
+    size_t size = 0;
+    size_t offset = 0;
+    size_t used;
+    FILE *out = open_memstream(&text, &size);
+    char *c;
+
+    while(offset < logLength && (used = LOG_Decode(logData + offset, logLength - offset, out)) > 0)
+    {
+        offset += used;
+    }
+    fclose(out);
+    *lines = 0;
+    for(c = text; *c; c++)
+    {
+        *lines += *c == '\n';
+    }
+    if(simVerbose)
+    {
+        fputs(text, stdout);
+    }
+    logLength = 0;
+    logDatagrams = 0;
+    return text;
+}
+
+// binary log records written straight to the ring, drained by the main loop
+// and decoded back into text on the host
+static bool SIM_ScenarioLog(void)
+{
+    simMeasure_t m;
+    logRingStats_t before;
+    uint16_t lines;
+    uint16_t i;
+    char *text;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("log");
+    logLength = 0;
+    logDatagrams = 0;
+    SIM_UdpSetHandler(SIM_LogSink);
+    SIM_RunMs(5);
+    free(SIM_LogText(&lines));
+
+    before = logRingStats;
+    SIM_MeasureStart(&m);
+    for(i = 0; i < SIM_LOG_EVENTS; i++)
+    {
+        LOG_Event(LOG_EV_NET_8023_TYPE, LOG_KERN, LOG_INFO, (uint16_t)(0x88B5u + i), 0);
+    }
+    SIM_MeasureReport(&m, "log event", SIM_LOG_EVENTS);
+    LOG_Event(LOG_EV_IPV4_ICMP_CHECKSUM, LOG_KERN, LOG_DEBUG, 0xBEEF, 0);
+    ok &= SIM_Check(logRingStats.records - before.records == SIM_LOG_EVENTS, "events below the threshold not stored");
+
+    SIM_MeasureStart(&m);
+    SIM_RUN_UNTIL(logDatagrams != 0, 50);
+    SIM_MeasureReport(&m, "log drain, 8 records", logDatagrams);
+    text = SIM_LogText(&lines);
+    ok &= SIM_Check(lines == SIM_LOG_EVENTS, "one datagram holds the records");
+    ok &= SIM_Check(strstr(text, "802.3 type 0x88B5\n") != NULL && strstr(text, "802.3 type 0x88BC\n") != NULL,
+                    "records decoded with their arguments");
+    ok &= SIM_Check(strncmp(text, "<6>1 2011-01-01T06:00:00Z", 25) == 0, "record time and priority decoded");
+    free(text);
+
+    // more events than the ring holds between two drains
+    before = logRingStats;
+    for(i = 0; i < LOG_RING_RECORDS + 4u; i++)
+    {
+        LOG_Event(LOG_EV_NET_8023_LENGTH, LOG_KERN, LOG_NOTICE, i, 0);
+    }
+    SIM_RUN_UNTIL(logDatagrams != 0, 50);
+    text = SIM_LogText(&lines);
+    ok &= SIM_Check(logRingStats.lost - before.lost == 4u && strstr(text, "(4 records lost)\n") != NULL,
+                    "records lost to a full ring reported");
+    ok &= SIM_Check(lines == LOG_RING_RECORDS + 1u, "full ring drained in one datagram");
+    free(text);
+    SIM_UdpSetHandler(NULL);
+    return ok;
+}
+
+static void SIM_SyslogSink(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length)
+{
+    char text[1500];
+    char *line;
+    unsigned count;
+
+    if(dstPort != DESTPORT_SYSLOG || length >= sizeof(text))
+    {
+        return;
+    }
+    memcpy(text, data, length);
+    text[length] = '\0';
+    syslogDatagrams++;
+    for(line = text; line && *line; line = strchr(line, '\n'))
+    {
+        line += *line == '\n';
+        if(*line == '<')
+        {
+            syslogLines++;
+            if(sscanf(strchr(line, '[') + 1, "%u messages suppressed", &count) == 1)
+            {
+                syslogSuppressed += (uint16_t)count;
+                syslogSummaries++;
+            }
+        }
+    }
+}
+
+// a burst of syslog messages to a unicast collector, more than the token
+// bucket lets through
+static bool SIM_ScenarioSyslog(void)
+{
+    simMeasure_t m;
+    logSyslogStats_t before;
+    simNetStats_t net;
+    char text[32];
+    uint32_t sent;
+    uint16_t dropped;
+    uint16_t i;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("syslog");
+    ipdb_setSyslog(SIM_PEER_IP);
+    syslogDatagrams = 0;
+    syslogLines = 0;
+    syslogSuppressed = 0;
+    syslogSummaries = 0;
+    SIM_UdpSetHandler(SIM_SyslogSink);
+    before = logSyslogStats;
+    net = *SIM_NetStats();
+
+    SIM_MeasureStart(&m);
+    for(i = 0; i < SIM_SYSLOG_BURST; i++)
+    {
+        sprintf(text, "burst message %u", i);
+        logMessage(text, LOG_DAEMON, LOG_ERROR, LOG_DEST_ETHERNET);
+        SIM_Loop();
+    }
+    SIM_RUN_UNTIL(syslogSuppressed != 0 && syslogSuppressed == (uint16_t)(logSyslogStats.suppressed - before.suppressed), 3000);
+    SIM_RunMs(20);
+    SIM_MeasureReport(&m, "syslog message", SIM_SYSLOG_BURST);
+    sent = logSyslogStats.messages - before.messages;
+    dropped = (uint16_t)(logSyslogStats.suppressed - before.suppressed);
+    printf("  %lu messages and %u suppressed in %u datagrams\n", (unsigned long)sent, dropped, syslogDatagrams);
+
+    // the message that finds the first batch full while the collector's MAC
+    // address is still unknown is dropped as well
+    ok &= SIM_Check(dropped >= SIM_SYSLOG_BURST - SYSLOG_BURST - SYSLOG_RATE && sent + dropped == SIM_SYSLOG_BURST,
+                    "token bucket limits the burst");
+    ok &= SIM_Check(syslogSuppressed == dropped && syslogLines == sent + syslogSummaries, "suppressed messages summarized");
+#ifndef SYSLOG_SINGLE_MESSAGE
+    ok &= SIM_Check(syslogDatagrams * 4u <= syslogLines, "messages batched into datagrams");
+#endif
+    ok &= SIM_Check(SIM_NetStats()->udpBroadcastsFromDevice == net.udpBroadcastsFromDevice, "sent to the collector, not broadcast");
+    ok &= SIM_Check(SIM_NetStats()->badChecksumsFromDevice == net.badChecksumsFromDevice, "no bad checksums from the device");
+    SIM_UdpSetHandler(NULL);
+    ipdb_setSyslog(0);
+    return ok;
+}
+
+static uint8_t statsReply[256];
+static uint16_t statsLength;
+static uint64_t statsBroadcasts;    // broadcasts from the device when the reply came in
+
+static void SIM_StatsSink(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length)
+{
+    if(srcPort != NET_STATS_PORT || dstPort != SIM_STATS_PORT || length > sizeof(statsReply))
+    {
+        return;
+    }
+    memcpy(statsReply, data, length);
+    statsLength = length;
+    statsBroadcasts = SIM_NetStats()->udpBroadcastsFromDevice;
+}
+
+static uint32_t SIM_StatsField(uint16_t offset, uint8_t size)
+{
+    uint32_t value = 0;
+
+    while(size--)
+    {
+        value = (value << 8) | statsReply[offset++];
+    }
+    return value;
+}
+
+// offsets of the counters in the reply, see net_stats.h
+#define SIM_STATS_RX(type)      (14u + 4u * (type))
+#define SIM_STATS_TX(type)      (14u + 4u * (NET_STATS_TYPES + (type)))
+#define SIM_STATS_DROPS(code)   (14u + 8u * NET_STATS_TYPES + 2u * (code))
+
+static bool SIM_StatsQuery(uint8_t command)
+{
+    statsLength = 0;
+    SIM_UdpSend(SIM_STATS_PORT, NET_STATS_PORT, &command, 1);
+    SIM_RUN_UNTIL(statsLength != 0, 50);
+    return statsLength != 0;
+}
+
+static bool SIM_ScenarioStats(void)
+{
+    simMeasure_t m;
+    uint64_t broadcasts;
+    uint8_t noise = 0;
+    uint16_t i;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("stats");
+    SIM_UdpSetHandler(SIM_StatsSink);
+
+    // the reset is answered with the counters it clears
+    ok &= SIM_Check(SIM_StatsQuery(NET_STATS_RESET), "reset query answered");
+    ok &= SIM_Check(statsReply[0] == NET_STATS_VERSION && statsReply[1] == NET_STATS_TYPES &&
+                    statsReply[2] == NET_STATS_ERRORS && statsReply[3] == NET_STATS_FLAG_RESET &&
+                    statsLength == SIM_STATS_DROPS(NET_STATS_ERRORS), "reply header");
+    ok &= SIM_Check(SIM_StatsField(SIM_STATS_RX(NET_STATS_ARP), 4) != 0 && netStats.rxFrames[NET_STATS_ARP] == 0,
+                    "counters cleared by the reset");
+
+    // with ENABLE_NETWORK_DEBUG the log ring datagrams go out as well, they
+    // are broadcast and leave in order with the replies
+    broadcasts = statsBroadcasts;
+    for(i = 0; i < SIM_STATS_PINGS; i++)
+    {
+        SIM_Ping(i, 56);
+        SIM_RUN_UNTIL(SIM_PingReplied(i), 50);
+    }
+    SIM_UdpSend(SIM_STATS_PORT, 9999, &noise, 1);   // nobody listens there
+    SIM_RunMs(5);
+
+    SIM_MeasureStart(&m);
+    ok &= SIM_Check(SIM_StatsQuery(NET_STATS_SNAPSHOT), "snapshot query answered");
+    SIM_MeasureReport(&m, "stats query", 1);
+    printf("  in: arp %lu ipv4 %lu, out: arp %lu ipv4 %lu, %lu port drops, %u TCBs\n",
+           (unsigned long)SIM_StatsField(SIM_STATS_RX(NET_STATS_ARP), 4),
+           (unsigned long)SIM_StatsField(SIM_STATS_RX(NET_STATS_IPV4), 4),
+           (unsigned long)SIM_StatsField(SIM_STATS_TX(NET_STATS_ARP), 4),
+           (unsigned long)SIM_StatsField(SIM_STATS_TX(NET_STATS_IPV4), 4),
+           (unsigned long)SIM_StatsField(SIM_STATS_DROPS(PORT_NOT_AVAILABLE), 2),
+           (unsigned)SIM_StatsField(4, 2));
+    ok &= SIM_Check(statsReply[3] == 0, "snapshot leaves the counters");
+    // the pings, the datagram to the closed port and the query itself
+    ok &= SIM_Check(SIM_StatsField(SIM_STATS_RX(NET_STATS_IPV4), 4) == SIM_STATS_PINGS + 2u, "IPv4 frames in counted");
+    // the replies and the port unreachable message
+    ok &= SIM_Check(SIM_StatsField(SIM_STATS_TX(NET_STATS_IPV4), 4) == SIM_STATS_PINGS + 1u + (statsBroadcasts - broadcasts),
+                    "IPv4 frames out counted");
+    ok &= SIM_Check(SIM_StatsField(SIM_STATS_DROPS(PORT_NOT_AVAILABLE), 2) == 1u, "datagram to a closed port dropped");
+    ok &= SIM_Check(SIM_StatsField(4, 2) == DEMO_ECHO_CLIENTS, "echo server TCBs listening");
+    SIM_UdpSetHandler(NULL);
+    return ok;
+}
+
+// offset of a probe in the profile reply
+#define SIM_PROFILE_PROBE(probe)    (4u + (10u + 2u * NET_PROFILE_BUCKETS) * (probe))
+
+#ifdef ENABLE_NETWORK_PROFILE
+static bool SIM_ProfileReport(void)
+{
+    static const char *names[NET_PROFILE_PROBES] =
+    {
+        "ETH_EventHandler", "Network_Read", "IPV4_Packet", "TCP_Recv",
+        "TCP_FiniteStateMachine", "TCP_Snd", "checksum"
+    };
+    uint32_t count;
+    uint32_t sum;
+    uint16_t offset;
+    uint8_t probe;
+    uint8_t b;
+    bool ok = true;
+
+    ok &= SIM_Check(SIM_StatsQuery(NET_STATS_PROFILE), "profile query answered");
+    ok &= SIM_Check(statsReply[1] == NET_PROFILE_PROBES && statsReply[2] == NET_PROFILE_BUCKETS &&
+                    statsReply[3] == NET_STATS_FLAG_PROFILE && statsLength == SIM_PROFILE_PROBE(NET_PROFILE_PROBES),
+                    "profile reply header");
+    printf("  %-24s %8s %8s %8s  log2 histogram of TMR1 ticks\n", "probe", "calls", "avg Tcy", "peak Tcy");
+    for(probe = 0; probe < NET_PROFILE_PROBES; probe++)
+    {
+        offset = SIM_PROFILE_PROBE(probe);
+        count = SIM_StatsField(offset, 4);
+        printf("  %-24s %8lu %8lu %8lu ", names[probe], (unsigned long)count,
+               (unsigned long)(count ? SIM_StatsField(offset + 4u, 4) * 8u / count : 0),
+               (unsigned long)SIM_StatsField(offset + 8u, 2) * 8u);
+        sum = 0;
+        for(b = 0; b < NET_PROFILE_BUCKETS; b++)
+        {
+            sum += SIM_StatsField(offset + 10u + 2u * b, 2);
+            printf(" %lu", (unsigned long)SIM_StatsField(offset + 10u + 2u * b, 2));
+        }
+        printf("\n");
+        ok &= SIM_Check(count != 0 && sum == count, names[probe]);
+    }
+    return ok;
+}
+#endif
+
+static bool SIM_ScenarioProfile(void)
+{
+    simTcpConn_t *c;
+    char message[20];
+    uint32_t expected = 0;
+    uint16_t i;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("profile");
+    SIM_UdpSetHandler(SIM_StatsSink);
+    ok &= SIM_Check(SIM_StatsQuery(NET_STATS_PROFILE | NET_STATS_RESET), "profile query answered");
+#ifndef ENABLE_NETWORK_PROFILE
+    ok &= SIM_Check(statsReply[3] == NET_STATS_FLAG_RESET && statsLength == SIM_STATS_DROPS(NET_STATS_ERRORS),
+                    "counters sent without ENABLE_NETWORK_PROFILE");
+#endif
+
+    // the echo server and pings run the probes, profiled or not
+    c = SIM_TcpConnect(7);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    for(i = 0; i < 20u; i++)
+    {
+        snprintf(message, sizeof(message), "echo message %05u", i);
+        SIM_TcpSend(c, message, sizeof(message));
+        expected += sizeof(message);
+        SIM_RUN_UNTIL(c->rxLen >= expected && SIM_TcpUnacked(c) == 0, 200);
+    }
+    for(i = 0; i < 8u; i++)
+    {
+        SIM_Ping(i, 512);
+        SIM_RUN_UNTIL(SIM_PingReplied(i), 50);
+    }
+    ok &= SIM_Check(c->rxLen == expected, "traffic echoed");
+#ifdef ENABLE_NETWORK_PROFILE
+    ok &= SIM_ProfileReport();
+#endif
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    SIM_TcpRelease(c);
+    SIM_UdpSetHandler(NULL);
+    return ok;
+}
+
+// offsets of the main loop monitor reply
+#define SIM_LOOP_STAGE(stage)       (15u + 8u * (stage))
+#define SIM_LOOP_BUCKET(bucket)     (15u + 8u * NET_LOOP_STAGES + 2u * (bucket))
+
+static bool slowAppOn;
+static uint16_t slowAppPasses;
+static uint32_t slowAppTcy;
+
+static void SIM_SlowApp(void)
+{
+    static uint8_t pass;
+    uint16_t i;
+
+    if(slowAppOn && ++pass >= SIM_SLOW_APP_EVERY)
+    {
+        pass = 0;
+        // in steps, so the TMR1 interrupt reloads the timer as soon as it
+        // overflows, as it does on the chip
+        for(i = 0; i < slowAppTcy / 100u; i++)
+        {
+            J60_Advance(100);
+        }
+        slowAppPasses++;
+    }
+}
+
+static bool SIM_LoopQuery(uint8_t command)
+{
+    uint32_t sum = 0;
+    uint8_t b;
+    bool ok = true;
+
+    ok &= SIM_Check(SIM_StatsQuery(command | NET_STATS_LOOP), "loop query answered");
+    ok &= SIM_Check(statsReply[1] == NET_LOOP_STAGES && statsReply[2] == NET_LOOP_BUCKETS &&
+                    (statsReply[3] & NET_STATS_FLAG_LOOP) && statsLength == SIM_LOOP_BUCKET(NET_LOOP_BUCKETS),
+                    "loop reply header");
+    for(b = 0; b < NET_LOOP_BUCKETS; b++)
+    {
+        sum += SIM_StatsField(SIM_LOOP_BUCKET(b), 2);
+    }
+    ok &= SIM_Check(sum == SIM_StatsField(4, 4) && SIM_StatsField(8, 2) == NET_LOOP_TICK_BUDGET, "passes in the histogram");
+    return ok;
+}
+
+static bool SIM_ScenarioLoop(void)
+{
+    simMeasure_t m;
+    simTcpConn_t *c;
+    char message[20];
+    uint32_t expected = 0;
+    uint32_t records;
+    uint16_t i;
+    bool ok = true;
+
+    SIM_Boot();
+    SIM_ReportHeader("loop");
+    SIM_UdpSetHandler(SIM_StatsSink);
+    slowAppOn = false;
+    slowAppPasses = 0;
+    SIM_AddApp(SIM_SlowApp);
+    ok &= SIM_LoopQuery(NET_STATS_RESET);
+
+    // the echo server alone stays within the budget
+    c = SIM_TcpConnect(7);
+    SIM_RUN_UNTIL(c->state == SIM_TCP_ESTABLISHED, 100);
+    SIM_MeasureStart(&m);
+    for(i = 0; i < 20u; i++)
+    {
+        snprintf(message, sizeof(message), "echo message %05u", i);
+        SIM_TcpSend(c, message, sizeof(message));
+        expected += sizeof(message);
+        SIM_RUN_UNTIL(c->rxLen >= expected && SIM_TcpUnacked(c) == 0, 200);
+    }
+    SIM_MeasureReport(&m, "echo, loop timed", 20);
+    ok &= SIM_Check(c->rxLen == expected, "traffic echoed");
+    ok &= SIM_LoopQuery(NET_STATS_SNAPSHOT);
+    printf("  %lu passes, p50 < %u Tcy, p99 < %u Tcy, peak %u Tcy\n",
+           (unsigned long)netLoop.passes, (NET_LoopPercentile(50) + 1u) * 8u,
+           (NET_LoopPercentile(99) + 1u) * 8u, netLoop.peak * 8u);
+    ok &= SIM_Check(SIM_StatsField(10, 2) == 0 && netLoop.overBudget == 0, "no pass over the budget");
+    ok &= SIM_Check(NET_LoopPercentile(99) < NET_LOOP_TICK_BUDGET, "99th percentile within the budget");
+    ok &= SIM_Check(netLoop.stages[NET_LOOP_NETWORK].ticks > netLoop.stages[NET_LOOP_APP].ticks,
+                    "network stage charged the stack's time");
+
+    // every tenth application pass is slow
+    records = logRingStats.records;
+    slowAppTcy = SIM_SLOW_APP_TCY;
+    slowAppOn = true;
+    for(i = 0; i < SIM_SLOW_APP_PASSES; i++)
+    {
+        SIM_Loop();
+    }
+    slowAppOn = false;
+    ok &= SIM_LoopQuery(NET_STATS_RESET);
+    printf("  %u slow passes: %lu passes over budget, peak %u Tcy\n", slowAppPasses,
+           (unsigned long)SIM_StatsField(10, 2), (unsigned)SIM_StatsField(12, 2) * 8u);
+    ok &= SIM_Check(slowAppPasses == SIM_SLOW_APP_PASSES / SIM_SLOW_APP_EVERY &&
+                    SIM_StatsField(10, 2) == slowAppPasses, "slow passes counted over the budget");
+    ok &= SIM_Check(SIM_StatsField(SIM_LOOP_STAGE(NET_LOOP_APP) + 6u, 2) == slowAppPasses &&
+                    SIM_StatsField(SIM_LOOP_STAGE(NET_LOOP_NETWORK) + 6u, 2) == 0, "slow passes charged to the application");
+    ok &= SIM_Check(statsReply[14] == NET_LOOP_APP && SIM_StatsField(12, 2) * 8u >= SIM_SLOW_APP_TCY,
+                    "peak pass charged to the application");
+    // the passes took less than a second, one warning; with
+    // ENABLE_NETWORK_DEBUG the stack logs its own events to the ring as well
+#if defined(ENABLE_LOOP_BUDGET_WARNING) && !defined(ENABLE_NETWORK_DEBUG)
+    ok &= SIM_Check(logRingStats.records - records == 1u, "budget warning logged once");
+#elif !defined(ENABLE_NETWORK_DEBUG)
+    ok &= SIM_Check(logRingStats.records == records, "no budget warning without ENABLE_LOOP_BUDGET_WARNING");
+#else
+    (void)records;
+#endif
+    ok &= SIM_Check(netLoop.overBudget == 0 && netLoop.stages[NET_LOOP_APP].overBudget == 0, "monitor cleared by the reset");
+
+    // a pass longer than the TMR1 period is counted at the most ticks
+    // instead of what is left after the timer wrapped
+    slowAppTcy = SIM_LONG_APP_TCY;
+    slowAppOn = true;
+    for(i = 0; i < SIM_SLOW_APP_EVERY; i++)
+    {
+        SIM_Loop();
+    }
+    slowAppOn = false;
+    printf("  %lu Tcy pass: peak %u ticks\n", (unsigned long)SIM_LONG_APP_TCY, netLoop.peak);
+    ok &= SIM_Check(netLoop.peak == 0xFFFF && netLoop.stages[NET_LOOP_APP].peak == 0xFFFF && netLoop.peakStage == NET_LOOP_APP,
+                    "pass longer than the TMR1 period saturates");
+
+    SIM_TcpClose(c);
+    SIM_RUN_UNTIL(c->finReceived && SIM_TcpUnacked(c) == 0, 3000);
+    SIM_TcpRelease(c);
+    SIM_UdpSetHandler(NULL);
+    return ok;
+}
+
+static const simScenario_t scenarios[] =
+{
+    {"arp",         SIM_ScenarioArp},
+    {"ping",        SIM_ScenarioPing},
+    {"tcp-echo",    SIM_ScenarioTcpEcho},
+    {"tcp-bulk",    SIM_ScenarioTcpBulk},
+    {"tcp-window",  SIM_ScenarioTcpWindow},
+    {"tcp-demux",   SIM_ScenarioTcpDemux},
+    {"tcp-accept",  SIM_ScenarioTcpAccept},
+    {"tcp-rto",     SIM_ScenarioTcpRto},
+    {"tcp-outage",  SIM_ScenarioTcpOutage},
+    {"tx-burst",    SIM_ScenarioTxBurst},
+    {"block",       SIM_ScenarioBlock},
+    {"heap",        SIM_ScenarioHeap},
+    {"log",         SIM_ScenarioLog},
+    {"syslog",      SIM_ScenarioSyslog},
+    {"stats",       SIM_ScenarioStats},
+    {"profile",     SIM_ScenarioProfile},
+    {"loop",        SIM_ScenarioLoop},
+};
+
+int main(int argc, char **argv)
+{
+    uint8_t i;
+    int a;
+    bool all = true;
+    bool ok = true;
+    bool found;
+
+    for(a = 1; a < argc; a++)
+    {
+        if(strcmp(argv[a], "-v") == 0)
+        {
+            simVerbose = true;
+        }
+        else
+        {
+            all = false;
+        }
+    }
+
+    for(i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        found = all;
+        for(a = 1; a < argc && !found; a++)
+        {
+            found = strcmp(argv[a], scenarios[i].name) == 0;
+        }
+        if(found)
+        {
+            ok &= scenarios[i].run();
+        }
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
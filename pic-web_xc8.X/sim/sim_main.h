@@ -0,0 +1,43 @@
+/**
+  Host simulation of the PIC-WEB firmware
+
+  Summary:
+    Main loop and measurement helpers shared by the scenarios.
+*/
+
+#ifndef SIM_MAIN_H
+#define SIM_MAIN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "j60_model.h"
+#include "sim_net.h"
+
+typedef void (*simApp_t)(void);
+
+typedef struct
+{
+    j60ModelStats_t stats;
+    simNetStats_t net;
+    uint64_t cycles;
+    uint64_t loops;
+} simMeasure_t;
+
+// run the firmware main loop until cond is true or ms of simulated time passed
+#define SIM_RUN_UNTIL(cond, ms) \
+    do { \
+        uint64_t simDeadline = J60_Cycles() + SIM_UsToTcy((uint64_t)(ms) * 1000u); \
+        while(!(cond) && J60_Cycles() < simDeadline) SIM_Loop(); \
+    } while(0)
+
+void SIM_Boot(void);
+void SIM_AddApp(simApp_t app);
+void SIM_Loop(void);
+void SIM_RunMs(uint32_t ms);
+
+void SIM_MeasureStart(simMeasure_t *m);
+void SIM_MeasureReport(const simMeasure_t *m, const char *label, uint32_t operations);
+void SIM_ReportHeader(const char *title);
+bool SIM_Check(bool condition, const char *what);
+
+#endif // SIM_MAIN_H
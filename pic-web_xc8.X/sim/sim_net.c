@@ -0,0 +1,762 @@
+/**
+  Simulated network for the host build
+
+  Summary:
+    Implementation of the peer host declared in sim_net.h.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "j60_model.h"
+#include "sim_net.h"
+#include "../mcc_generated_files/TCPIPLibrary/mac_address.h"
+
+#define ETHERTYPE_IPV4      0x0800u
+#define ETHERTYPE_ARP       0x0806u
+#define ETHERTYPE_MAC_CTRL  0x8808u
+#define PROTO_ICMP          1u
+#define PROTO_TCP           6u
+#define PROTO_UDP           17u
+
+#define TCP_FIN             0x01u
+#define TCP_SYN             0x02u
+#define TCP_RST             0x04u
+#define TCP_PSH             0x08u
+#define TCP_ACK             0x10u
+
+#define PEER_MSS            1460u
+#define PEER_RTO_MS         300u
+#define PING_HISTORY        1024u
+
+static const uint8_t peerMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02};
+
+static simNetStats_t netStats;
+static simTcpConn_t connections[SIM_MAX_CONNECTIONS];
+static simUdpHandler_t udpHandler;
+static uint64_t wireDelayTcy;
+static uint64_t wireFreeAt;
+static uint16_t lossToDevice;
+static uint16_t lossFromDevice;
+static uint32_t lossSeed;
+static uint32_t delayedAckMs;
+static uint16_t peerWindow;
+static uint16_t corruptSegments;
+static uint16_t ipIdent;
+static uint16_t nextPeerPort;
+static bool arpReplied;
+static bool pingReplied[PING_HISTORY];
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static bool SIM_Lose(uint16_t perMille)
+{
+    if(perMille == 0)
+    {
+        return false;
+    }
+    lossSeed = lossSeed * 1103515245u + 12345u;
+    return ((lossSeed >> 16) % 1000u) < perMille;
+}
+
+uint64_t SIM_UsToTcy(uint64_t us)
+{
+    return (us * J60_FCY) / 1000000u;
+}
+
+uint64_t SIM_TcyToUs(uint64_t tcy)
+{
+    return (tcy * 1000000u) / J60_FCY;
+}
+
+void SIM_SendFrame(const uint8_t *frame, uint16_t length)
+{
+    uint64_t start = J60_Cycles() + wireDelayTcy;
+    uint64_t arrival;
+
+    if(start < wireFreeAt)
+    {
+        start = wireFreeAt;
+    }
+    arrival = start + ((uint64_t)((length < 60u ? 60u : length) + 24u) * 25u) / 3u;
+    wireFreeAt = arrival;
+    netStats.framesToDevice++;
+    if(SIM_Lose(lossToDevice))
+    {
+        netStats.droppedToDevice++;
+        return;
+    }
+    J60_WireDeliver(frame, length, arrival);
+}
+
+static uint8_t *SIM_EthHeader(uint8_t *frame, uint16_t type)
+{
+    memcpy(frame, MAC_getAddress()->mac_array, 6);
+    memcpy(frame + 6, peerMac, 6);
+    put16(frame + 12, type);
+    return frame + 14;
+}
+
+static uint8_t *SIM_IpHeader(uint8_t *ip, uint8_t protocol, uint16_t payloadLength)
+{
+    memset(ip, 0, 20);
+    ip[0] = 0x45;
+    put16(ip + 2, (uint16_t)(20u + payloadLength));
+    put16(ip + 4, ipIdent++);
+    put16(ip + 6, 0x4000);
+    ip[8] = 64;
+    ip[9] = protocol;
+    put32(ip + 12, SIM_PEER_IP);
+    put32(ip + 16, SIM_DEVICE_IP);
+    put16(ip + 10, J60_InetChecksum(ip, 20, 0));
+    return ip + 20;
+}
+
+static uint32_t SIM_PseudoHeader(uint32_t src, uint32_t dst, uint8_t protocol, uint16_t length)
+{
+    return (src >> 16) + (src & 0xFFFFu) + (dst >> 16) + (dst & 0xFFFFu) + protocol + length;
+}
+
+void SIM_ArpRequest(void)
+{
+    uint8_t frame[60] = {0};
+    uint8_t *arp;
+
+    arpReplied = false;
+    arp = SIM_EthHeader(frame, ETHERTYPE_ARP);
+    memset(frame, 0xFF, 6);
+    put16(arp + 0, 1);
+    put16(arp + 2, ETHERTYPE_IPV4);
+    arp[4] = 6;
+    arp[5] = 4;
+    put16(arp + 6, 1);
+    memcpy(arp + 8, peerMac, 6);
+    put32(arp + 14, SIM_PEER_IP);
+    put32(arp + 24, SIM_DEVICE_IP);
+    SIM_SendFrame(frame, sizeof(frame));
+}
+
+// broadcast and multicast traffic for other hosts, as on a busy LAN: an ARP
+// request for another address, a NetBIOS name query, an mDNS query and an
+// IPv6 neighbour solicitation
+void SIM_LanNoise(void)
+{
+    static const uint8_t mdnsMac[6] = {0x01, 0x00, 0x5E, 0x00, 0x00, 0xFB};
+    static const uint8_t ndMac[6] = {0x33, 0x33, 0xFF, 0x00, 0x00, 0x09};
+    uint8_t frame[92] = {0};
+    uint8_t *p;
+
+    // ARP request for a neighbour
+    p = SIM_EthHeader(frame, ETHERTYPE_ARP);
+    memset(frame, 0xFF, 6);
+    put16(p + 0, 1);
+    put16(p + 2, ETHERTYPE_IPV4);
+    p[4] = 6;
+    p[5] = 4;
+    put16(p + 6, 1);
+    memcpy(p + 8, peerMac, 6);
+    put32(p + 14, SIM_PEER_IP);
+    put32(p + 24, SIM_DEVICE_IP + 1u);
+    SIM_SendFrame(frame, 60);
+
+    // UDP broadcast and multicast datagrams
+    memset(frame, 0, sizeof(frame));
+    p = SIM_IpHeader(SIM_EthHeader(frame, ETHERTYPE_IPV4), PROTO_UDP, 50);
+    memset(frame, 0xFF, 6);
+    put32(p - 4, 0xFFFFFFFFu);
+    put16(p - 10, 0);
+    put16(p - 10, J60_InetChecksum(p - 20, 20, 0));
+    put16(p + 0, 137);
+    put16(p + 2, 137);
+    put16(p + 4, 50);
+    SIM_SendFrame(frame, 84);
+    memcpy(frame, mdnsMac, 6);
+    put32(p - 4, 0xE00000FBu);
+    put16(p - 10, 0);
+    put16(p - 10, J60_InetChecksum(p - 20, 20, 0));
+    put16(p + 0, 5353);
+    put16(p + 2, 5353);
+    SIM_SendFrame(frame, 84);
+
+    // IPv6 neighbour solicitation, only the addressing matters here
+    memset(frame, 0, sizeof(frame));
+    SIM_EthHeader(frame, 0x86DDu);
+    memcpy(frame, ndMac, 6);
+    SIM_SendFrame(frame, 86);
+}
+
+bool SIM_ArpReplied(void)
+{
+    return arpReplied;
+}
+
+void SIM_Ping(uint16_t sequence, uint16_t payloadLength)
+{
+    uint8_t frame[1514];
+    uint8_t *icmp;
+    uint16_t i;
+
+    if(payloadLength > sizeof(frame) - 14u - 20u - 8u)
+    {
+        payloadLength = sizeof(frame) - 14u - 20u - 8u;
+    }
+    pingReplied[sequence % PING_HISTORY] = false;
+    icmp = SIM_IpHeader(SIM_EthHeader(frame, ETHERTYPE_IPV4), PROTO_ICMP, (uint16_t)(8u + payloadLength));
+    icmp[0] = 8;
+    icmp[1] = 0;
+    put16(icmp + 2, 0);
+    put16(icmp + 4, 0x5349);
+    put16(icmp + 6, sequence);
+    for(i = 0; i < payloadLength; i++)
+    {
+        icmp[8 + i] = (uint8_t)(sequence + i);
+    }
+    put16(icmp + 2, J60_InetChecksum(icmp, (uint16_t)(8u + payloadLength), 0));
+    SIM_SendFrame(frame, (uint16_t)(14u + 20u + 8u + payloadLength));
+}
+
+bool SIM_PingReplied(uint16_t sequence)
+{
+    return pingReplied[sequence % PING_HISTORY];
+}
+
+void SIM_UdpSend(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length)
+{
+    uint8_t frame[1514];
+    uint8_t *udp;
+    uint16_t cksm;
+
+    udp = SIM_IpHeader(SIM_EthHeader(frame, ETHERTYPE_IPV4), PROTO_UDP, (uint16_t)(8u + length));
+    put16(udp + 0, srcPort);
+    put16(udp + 2, dstPort);
+    put16(udp + 4, (uint16_t)(8u + length));
+    put16(udp + 6, 0);
+    memcpy(udp + 8, data, length);
+    cksm = J60_InetChecksum(udp, (uint16_t)(8u + length), SIM_PseudoHeader(SIM_PEER_IP, SIM_DEVICE_IP, PROTO_UDP, (uint16_t)(8u + length)));
+    put16(udp + 6, cksm ? cksm : 0xFFFFu);
+    SIM_SendFrame(frame, (uint16_t)(14u + 20u + 8u + length));
+}
+
+void SIM_UdpSetHandler(simUdpHandler_t handler)
+{
+    udpHandler = handler;
+}
+
+static void SIM_TcpSegment(simTcpConn_t *c, uint32_t seq, uint8_t flags, const uint8_t *data, uint16_t length)
+{
+    uint8_t frame[1514];
+    uint8_t *tcp;
+    uint8_t header = (flags & TCP_SYN) ? 24u : 20u;
+
+    tcp = SIM_IpHeader(SIM_EthHeader(frame, ETHERTYPE_IPV4), PROTO_TCP, (uint16_t)(header + length));
+    put16(tcp + 0, c->peerPort);
+    put16(tcp + 2, c->devicePort);
+    put32(tcp + 4, seq);
+    put32(tcp + 8, (flags & TCP_ACK) ? c->rcvNxt : 0);
+    tcp[12] = (uint8_t)((header / 4u) << 4);
+    tcp[13] = flags;
+    put16(tcp + 14, peerWindow);
+    put16(tcp + 16, 0);
+    put16(tcp + 18, 0);
+    if(flags & TCP_SYN)
+    {
+        tcp[20] = 2;
+        tcp[21] = 4;
+        put16(tcp + 22, PEER_MSS);
+    }
+    if(length)
+    {
+        memcpy(tcp + header, data, length);
+    }
+    put16(tcp + 16, J60_InetChecksum(tcp, (uint16_t)(header + length), SIM_PseudoHeader(SIM_PEER_IP, SIM_DEVICE_IP, PROTO_TCP, (uint16_t)(header + length))));
+    if(length && corruptSegments)
+    {
+        tcp[header + length / 2u] ^= 0x5Au;     // after the checksum: the device must drop it
+        corruptSegments--;
+    }
+    SIM_SendFrame(frame, (uint16_t)(14u + 20u + header + length));
+    c->segmentsOut++;
+    if(flags & TCP_ACK)
+    {
+        c->ackPending = false;
+        c->segmentsSinceAck = 0;
+    }
+    if(length == 0 && flags == TCP_ACK)
+    {
+        c->acksOut++;
+    }
+}
+
+static void SIM_TcpOutput(simTcpConn_t *c)
+{
+    uint32_t end = c->iss + 1u + c->txLen;
+    uint32_t inFlight;
+    uint32_t room;
+    uint32_t length;
+
+    if(c->state != SIM_TCP_ESTABLISHED && c->state != SIM_TCP_CLOSE_WAIT && c->state != SIM_TCP_FIN_WAIT && c->state != SIM_TCP_LAST_ACK)
+    {
+        return;
+    }
+    while((int32_t)(end - c->sndNxt) > 0)
+    {
+        inFlight = c->sndNxt - c->sndUna;
+        room = (c->deviceWindow > inFlight) ? c->deviceWindow - inFlight : 0;
+        length = end - c->sndNxt;
+        if(length > c->mss)
+        {
+            length = c->mss;
+        }
+        if(length > room)
+        {
+            length = room;
+        }
+        if(length == 0)
+        {
+            break;
+        }
+        SIM_TcpSegment(c, c->sndNxt, TCP_ACK | TCP_PSH, &c->txData[c->sndNxt - c->iss - 1u], (uint16_t)length);
+        c->sndNxt += length;
+        if(c->rtoDeadline == 0)
+        {
+            c->rtoDeadline = J60_Cycles() + SIM_UsToTcy(PEER_RTO_MS * 1000u);
+        }
+    }
+    if((c->state == SIM_TCP_FIN_WAIT || c->state == SIM_TCP_LAST_ACK) && c->sndNxt == end)
+    {
+        SIM_TcpSegment(c, c->sndNxt, TCP_ACK | TCP_FIN, NULL, 0);
+        c->sndNxt++;
+        if(c->rtoDeadline == 0)
+        {
+            c->rtoDeadline = J60_Cycles() + SIM_UsToTcy(PEER_RTO_MS * 1000u);
+        }
+    }
+}
+
+simTcpConn_t *SIM_TcpConnect(uint16_t devicePort)
+{
+    simTcpConn_t *c = NULL;
+    uint8_t i;
+
+    for(i = 0; i < SIM_MAX_CONNECTIONS; i++)
+    {
+        if(connections[i].state == SIM_TCP_CLOSED && connections[i].peerPort == 0)
+        {
+            c = &connections[i];
+            break;
+        }
+    }
+    if(c == NULL)
+    {
+        return NULL;
+    }
+    memset(c, 0, sizeof(*c));
+    c->peerPort = nextPeerPort++;
+    c->devicePort = devicePort;
+    c->iss = 0x10000000u + ((uint32_t)c->peerPort << 12);
+    c->sndUna = c->iss;
+    c->sndNxt = c->iss + 1u;
+    c->mss = 536;
+    c->state = SIM_TCP_SYN_SENT;
+    SIM_TcpSegment(c, c->iss, TCP_SYN, NULL, 0);
+    c->rtoDeadline = J60_Cycles() + SIM_UsToTcy(PEER_RTO_MS * 1000u);
+    return c;
+}
+
+void SIM_TcpSend(simTcpConn_t *c, const void *data, uint32_t length)
+{
+    if(c->txLen + length > SIM_TCP_BUFFER)
+    {
+        length = SIM_TCP_BUFFER - c->txLen;
+    }
+    memcpy(&c->txData[c->txLen], data, length);
+    c->txLen += length;
+    SIM_TcpOutput(c);
+}
+
+void SIM_TcpClose(simTcpConn_t *c)
+{
+    if(c->state == SIM_TCP_ESTABLISHED)
+    {
+        c->state = SIM_TCP_FIN_WAIT;
+    }
+    else if(c->state == SIM_TCP_CLOSE_WAIT)
+    {
+        c->state = SIM_TCP_LAST_ACK;
+    }
+    SIM_TcpOutput(c);
+}
+
+void SIM_TcpRelease(simTcpConn_t *c)
+{
+    c->state = SIM_TCP_CLOSED;
+    c->peerPort = 0;
+}
+
+uint32_t SIM_TcpUnacked(const simTcpConn_t *c)
+{
+    return c->sndNxt - c->sndUna;
+}
+
+static void SIM_TcpAckNow(simTcpConn_t *c)
+{
+    SIM_TcpSegment(c, c->sndNxt, TCP_ACK, NULL, 0);
+}
+
+static void SIM_TcpInput(const uint8_t *ip, const uint8_t *tcp, uint16_t length)
+{
+    uint16_t srcPort = get16(tcp + 0);
+    uint16_t dstPort = get16(tcp + 2);
+    uint32_t seq = get32(tcp + 4);
+    uint32_t ack = get32(tcp + 8);
+    uint8_t header = (uint8_t)((tcp[12] >> 4) * 4u);
+    uint8_t flags = tcp[13];
+    uint16_t payload = (uint16_t)(length - header);
+    simTcpConn_t *c = NULL;
+    uint8_t i;
+
+    (void)ip;
+    for(i = 0; i < SIM_MAX_CONNECTIONS; i++)
+    {
+        if(connections[i].peerPort == dstPort && connections[i].devicePort == srcPort && connections[i].state != SIM_TCP_CLOSED)
+        {
+            c = &connections[i];
+            break;
+        }
+    }
+    if(c == NULL)
+    {
+        return;
+    }
+    c->segmentsIn++;
+
+    if(flags & TCP_RST)
+    {
+        c->state = SIM_TCP_CLOSED;
+        c->reset = true;
+        return;
+    }
+
+    if(c->state == SIM_TCP_SYN_SENT)
+    {
+        if((flags & (TCP_SYN | TCP_ACK)) == (TCP_SYN | TCP_ACK) && ack == c->iss + 1u)
+        {
+            c->rcvNxt = seq + 1u;
+            c->sndUna = ack;
+            c->deviceWindow = get16(tcp + 14);
+            for(i = 20; i + 3u < header; )
+            {
+                if(tcp[i] == 0)
+                {
+                    break;
+                }
+                if(tcp[i] == 1)
+                {
+                    i++;
+                    continue;
+                }
+                if(tcp[i] == 2 && tcp[i + 1] == 4)
+                {
+                    c->mss = get16(tcp + i + 2);
+                }
+                i = (uint8_t)(i + tcp[i + 1]);
+            }
+            c->rtoDeadline = 0;
+            c->state = SIM_TCP_ESTABLISHED;
+            SIM_TcpAckNow(c);
+            SIM_TcpOutput(c);
+        }
+        return;
+    }
+
+    if(flags & TCP_ACK)
+    {
+        if((int32_t)(ack - c->sndUna) > 0 && (int32_t)(ack - c->sndNxt) <= 0)
+        {
+            c->sndUna = ack;
+            c->rtoDeadline = (c->sndUna == c->sndNxt) ? 0 : J60_Cycles() + SIM_UsToTcy(PEER_RTO_MS * 1000u);
+        }
+        c->deviceWindow = get16(tcp + 14);
+    }
+
+    if(payload == 0 && !(flags & (TCP_SYN | TCP_FIN)))
+    {
+        c->pureAcksIn++;
+    }
+    else if(seq != c->rcvNxt)
+    {
+        c->duplicatesIn++;
+        SIM_TcpAckNow(c);
+    }
+    else
+    {
+        if(payload)
+        {
+            if(c->rxLen + payload <= SIM_TCP_BUFFER)
+            {
+                memcpy(&c->rxData[c->rxLen], tcp + header, payload);
+                c->rxLen += payload;
+            }
+            c->rcvNxt += payload;
+        }
+        if(flags & TCP_FIN)
+        {
+            c->rcvNxt++;
+            c->finReceived = true;
+            if(c->state == SIM_TCP_ESTABLISHED)
+            {
+                c->state = SIM_TCP_CLOSE_WAIT;
+            }
+            else if(c->state == SIM_TCP_FIN_WAIT)
+            {
+                c->state = SIM_TCP_TIME_WAIT;
+            }
+        }
+        if(delayedAckMs && !(flags & TCP_FIN) && ++c->segmentsSinceAck < 2u)
+        {
+            if(!c->ackPending)
+            {
+                c->ackPending = true;
+                c->ackDue = J60_Cycles() + SIM_UsToTcy((uint64_t)delayedAckMs * 1000u);
+            }
+        }
+        else
+        {
+            SIM_TcpAckNow(c);
+        }
+    }
+    if(c->state == SIM_TCP_LAST_ACK && c->sndUna == c->sndNxt)
+    {
+        c->state = SIM_TCP_TIME_WAIT;
+    }
+    SIM_TcpOutput(c);
+}
+
+static bool SIM_ChecksumOk(const uint8_t *ip, const uint8_t *l4, uint16_t length, uint8_t protocol)
+{
+    uint32_t src = get32(ip + 12);
+    uint32_t dst = get32(ip + 16);
+
+    if(protocol == PROTO_ICMP)
+    {
+        return J60_InetChecksum(l4, length, 0) == 0;
+    }
+    if(protocol == PROTO_UDP && get16(l4 + 6) == 0)
+    {
+        return true;
+    }
+    return J60_InetChecksum(l4, length, SIM_PseudoHeader(src, dst, protocol, length)) == 0;
+}
+
+static void SIM_FromDevice(const uint8_t *frame, uint16_t length, uint64_t when)
+{
+    const uint8_t *ip = frame + 14;
+    const uint8_t *l4;
+    uint16_t type = get16(frame + 12);
+    uint16_t ipLength;
+    uint8_t headerLength;
+
+    netStats.framesFromDevice++;
+    if(type == ETHERTYPE_MAC_CTRL)
+    {
+        // a PAUSE stops the peer's transmitter, the frames it queued wait
+        if(get16(frame + 14) == 1u)
+        {
+            netStats.pausesFromDevice++;
+            J60_WirePause(when, get16(frame + 16));
+        }
+        return;
+    }
+    if(SIM_Lose(lossFromDevice))
+    {
+        netStats.droppedFromDevice++;
+        return;
+    }
+    if(type == ETHERTYPE_ARP)
+    {
+        if(get16(ip + 6) == 1 && get32(ip + 24) == SIM_PEER_IP)
+        {
+            uint8_t reply[60] = {0};
+            uint8_t *arp = SIM_EthHeader(reply, ETHERTYPE_ARP);
+
+            netStats.arpRequestsFromDevice++;
+            memcpy(arp, ip, 8);
+            put16(arp + 6, 2);
+            memcpy(arp + 8, peerMac, 6);
+            put32(arp + 14, SIM_PEER_IP);
+            memcpy(arp + 18, ip + 8, 10);
+            SIM_SendFrame(reply, sizeof(reply));
+        }
+        else if(get16(ip + 6) == 2 && get32(ip + 14) == SIM_DEVICE_IP)
+        {
+            arpReplied = true;
+        }
+        return;
+    }
+    if(type != ETHERTYPE_IPV4 || (ip[0] >> 4) != 4)
+    {
+        return;
+    }
+    headerLength = (uint8_t)((ip[0] & 0x0Fu) * 4u);
+    ipLength = get16(ip + 2);
+    if(ipLength + 14u > length || J60_InetChecksum(ip, headerLength, 0) != 0)
+    {
+        netStats.badChecksumsFromDevice++;
+        return;
+    }
+    l4 = ip + headerLength;
+    if(!SIM_ChecksumOk(ip, l4, (uint16_t)(ipLength - headerLength), ip[9]))
+    {
+        netStats.badChecksumsFromDevice++;
+        return;
+    }
+    switch(ip[9])
+    {
+        case PROTO_ICMP:
+            if(l4[0] == 0)
+            {
+                netStats.icmpRepliesFromDevice++;
+                pingReplied[get16(l4 + 6) % PING_HISTORY] = true;
+            }
+            break;
+        case PROTO_TCP:
+            SIM_TcpInput(ip, l4, (uint16_t)(ipLength - headerLength));
+            break;
+        case PROTO_UDP:
+            netStats.udpFromDevice++;
+            netStats.udpBroadcastsFromDevice += get32(ip + 16) == 0xFFFFFFFFul;
+            if(udpHandler)
+            {
+                udpHandler(get16(l4), get16(l4 + 2), l4 + 8, (uint16_t)(get16(l4 + 4) - 8u));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void SIM_NetPoll(void)
+{
+    uint64_t now = J60_Cycles();
+    simTcpConn_t *c;
+    uint8_t i;
+
+    for(i = 0; i < SIM_MAX_CONNECTIONS; i++)
+    {
+        c = &connections[i];
+        if(c->state == SIM_TCP_CLOSED)
+        {
+            continue;
+        }
+        if(c->ackPending && now >= c->ackDue)
+        {
+            SIM_TcpAckNow(c);
+        }
+        if(c->rtoDeadline && now >= c->rtoDeadline)
+        {
+            c->retransmitsOut++;
+            c->rtoDeadline = now + SIM_UsToTcy(PEER_RTO_MS * 1000u);
+            if(c->state == SIM_TCP_SYN_SENT)
+            {
+                SIM_TcpSegment(c, c->iss, TCP_SYN, NULL, 0);
+            }
+            else
+            {
+                if(c->sndUna == c->sndNxt)
+                {
+                    c->rtoDeadline = 0;
+                    continue;
+                }
+                // go back to the oldest unacknowledged byte
+                c->sndNxt = c->sndUna;
+                if(c->sndNxt - c->iss - 1u < c->txLen && c->deviceWindow == 0)
+                {
+                    // zero window probe
+                    SIM_TcpSegment(c, c->sndNxt, TCP_ACK, &c->txData[c->sndNxt - c->iss - 1u], 1);
+                    c->sndNxt++;
+                }
+                else
+                {
+                    SIM_TcpOutput(c);
+                }
+            }
+        }
+    }
+}
+
+void SIM_NetInit(void)
+{
+    memset(&netStats, 0, sizeof(netStats));
+    memset(connections, 0, sizeof(connections));
+    memset(pingReplied, 0, sizeof(pingReplied));
+    udpHandler = NULL;
+    wireDelayTcy = SIM_UsToTcy(5);
+    wireFreeAt = 0;
+    lossToDevice = 0;
+    lossFromDevice = 0;
+    lossSeed = 1;
+    delayedAckMs = 0;
+    peerWindow = 8192;
+    corruptSegments = 0;
+    ipIdent = 1;
+    nextPeerPort = 40000;
+    arpReplied = false;
+    J60_SetTxHandler(SIM_FromDevice);
+}
+
+void SIM_NetSetDelayUs(uint32_t us)
+{
+    wireDelayTcy = SIM_UsToTcy(us);
+}
+
+void SIM_NetSetLoss(uint16_t toDevicePerMille, uint16_t fromDevicePerMille)
+{
+    lossToDevice = toDevicePerMille;
+    lossFromDevice = fromDevicePerMille;
+}
+
+void SIM_NetSetPeerDelayedAck(uint32_t ms)
+{
+    delayedAckMs = ms;
+}
+
+void SIM_NetSetPeerWindow(uint16_t window)
+{
+    peerWindow = window;
+}
+
+void SIM_NetCorruptTcp(uint16_t segments)
+{
+    corruptSegments = segments;
+}
+
+const simNetStats_t *SIM_NetStats(void)
+{
+    return &netStats;
+}
+
+void SIM_NetStatsClear(void)
+{
+    memset(&netStats, 0, sizeof(netStats));
+}
@@ -0,0 +1,122 @@
+/**
+  Simulated network for the host build
+
+  Summary:
+    A peer host on the other end of the wire, with just enough ARP, ICMP,
+    UDP and TCP to drive the firmware and check its answers.
+
+  Description:
+    Frames transmitted by the J60 model are handed to the peer when their
+    last bit leaves the MAC; frames sent by the peer are queued on the wire
+    and arrive at the model after the propagation delay plus their
+    serialization time.  Both directions can drop frames to exercise the
+    retransmission paths.
+*/
+
+#ifndef SIM_NET_H
+#define SIM_NET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SIM_DEVICE_IP           0xC0A80001ul    // ipdb_init() default
+#define SIM_PEER_IP             0xC0A80002ul
+#define SIM_TCP_BUFFER          65536u
+#define SIM_MAX_CONNECTIONS     32u
+
+typedef enum
+{
+    SIM_TCP_CLOSED = 0,
+    SIM_TCP_SYN_SENT,
+    SIM_TCP_ESTABLISHED,
+    SIM_TCP_FIN_WAIT,
+    SIM_TCP_CLOSE_WAIT,
+    SIM_TCP_LAST_ACK,
+    SIM_TCP_TIME_WAIT
+} simTcpState_t;
+
+typedef struct
+{
+    simTcpState_t state;
+    uint16_t peerPort;
+    uint16_t devicePort;
+    uint32_t iss;
+    uint32_t sndUna;
+    uint32_t sndNxt;
+    uint32_t rcvNxt;
+    uint16_t deviceWindow;
+    uint16_t mss;
+    bool reset;
+    bool finReceived;
+
+    uint8_t txData[SIM_TCP_BUFFER];     // stream bytes, offset 0 is iss + 1
+    uint32_t txLen;
+    uint8_t rxData[SIM_TCP_BUFFER];     // everything the device sent us
+    uint32_t rxLen;
+
+    bool ackPending;
+    uint64_t ackDue;
+    uint8_t segmentsSinceAck;
+    uint64_t rtoDeadline;
+
+    uint32_t segmentsIn;
+    uint32_t segmentsOut;
+    uint32_t pureAcksIn;
+    uint32_t acksOut;
+    uint32_t retransmitsOut;
+    uint32_t duplicatesIn;
+} simTcpConn_t;
+
+typedef struct
+{
+    uint64_t framesToDevice;
+    uint64_t framesFromDevice;
+    uint64_t droppedToDevice;
+    uint64_t droppedFromDevice;
+    uint64_t arpRequestsFromDevice;
+    uint64_t icmpRepliesFromDevice;
+    uint64_t udpFromDevice;
+    uint64_t udpBroadcastsFromDevice;
+    uint64_t badChecksumsFromDevice;
+    uint64_t pausesFromDevice;      // PAUSE frames, zero time ones included
+} simNetStats_t;
+
+typedef void (*simUdpHandler_t)(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length);
+
+void SIM_NetInit(void);
+void SIM_NetPoll(void);
+
+// link behaviour
+void SIM_NetSetDelayUs(uint32_t us);
+void SIM_NetSetLoss(uint16_t toDevicePerMille, uint16_t fromDevicePerMille);
+void SIM_NetSetPeerDelayedAck(uint32_t ms);     // 0 = acknowledge every segment immediately
+void SIM_NetSetPeerWindow(uint16_t window);
+void SIM_NetCorruptTcp(uint16_t segments);     // damage the payload of the next TCP data segments
+
+const simNetStats_t *SIM_NetStats(void);
+void SIM_NetStatsClear(void);
+
+// ARP and ICMP
+void SIM_ArpRequest(void);
+bool SIM_ArpReplied(void);
+void SIM_LanNoise(void);                         // 4 broadcast/multicast frames for other hosts
+void SIM_Ping(uint16_t sequence, uint16_t payloadLength);
+bool SIM_PingReplied(uint16_t sequence);
+
+// UDP
+void SIM_UdpSend(uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t length);
+void SIM_UdpSetHandler(simUdpHandler_t handler);
+
+// TCP client connections to the device
+simTcpConn_t *SIM_TcpConnect(uint16_t devicePort);
+void SIM_TcpSend(simTcpConn_t *c, const void *data, uint32_t length);
+void SIM_TcpClose(simTcpConn_t *c);
+void SIM_TcpRelease(simTcpConn_t *c);
+uint32_t SIM_TcpUnacked(const simTcpConn_t *c);
+
+// raw frames
+void SIM_SendFrame(const uint8_t *frame, uint16_t length);
+uint64_t SIM_UsToTcy(uint64_t us);
+uint64_t SIM_TcyToUs(uint64_t tcy);
+
+#endif // SIM_NET_H
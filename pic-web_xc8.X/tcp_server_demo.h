@@ -1,6 +1,9 @@
-#ifndef TCP_serverDemo_H
-#define TCP_serverDemo_H
-
-void DEMO_TCP_EchoServer(void);
-
+#ifndef TCP_serverDemo_H
+#define TCP_serverDemo_H
+
+// clients the echo server serves at once
+#define DEMO_ECHO_CLIENTS   2u
+
+void DEMO_TCP_EchoServer(void);
+
 #endif
\ No newline at end of file